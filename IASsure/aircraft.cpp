@@ -0,0 +1,27 @@
+#include "aircraft.h"
+
+bool IASsure::AircraftState::isToggled(AircraftToggle toggle) const
+{
+	return this->toggles.test((size_t)toggle);
+}
+
+void IASsure::AircraftState::setToggled(AircraftToggle toggle, bool toggled)
+{
+	this->toggles.set((size_t)toggle, toggled);
+}
+
+bool IASsure::AircraftState::toggle(AircraftToggle toggle)
+{
+	this->toggles.flip((size_t)toggle);
+	return this->toggles.test((size_t)toggle);
+}
+
+bool IASsure::AircraftState::empty() const
+{
+	return !this->reportedIAS.has_value() && !this->reportedMach.has_value() && this->toggles.none();
+}
+
+uint64_t IASsure::hashCallsign(std::string_view callsign)
+{
+	return xxh64(callsign);
+}
\ No newline at end of file
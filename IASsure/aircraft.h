@@ -0,0 +1,228 @@
+#pragma once
+
+#include <bitset>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "hash.h"
+
+namespace IASsure {
+	enum class AircraftToggle {
+		CalculatedIAS,
+		CalculatedIASAbbreviated,
+		CalculatedMach,
+		CalculatedMachAboveThreshold,
+		UnreliableSpeed,
+		Count,
+	};
+
+	// AircraftState stores the speeds reported by the pilot and the toggles set by the controller for a single aircraft
+	class AircraftState {
+	public:
+		std::optional<int> reportedIAS; // in kn
+		std::optional<double> reportedMach;
+
+		bool isToggled(AircraftToggle toggle) const;
+		void setToggled(AircraftToggle toggle, bool toggled);
+		// toggle flips the given toggle, returning its new value
+		bool toggle(AircraftToggle toggle);
+		// empty returns true if no speed was reported and no toggle is set
+		bool empty() const;
+	private:
+		std::bitset<(size_t)AircraftToggle::Count> toggles;
+	};
+
+	uint64_t hashCallsign(std::string_view callsign);
+
+	// CallsignMap is a flat hash map keyed by callsign, using open addressing with linear probing. the hash of each callsign is stored
+	// alongside its entry, so probes only compare callsigns on matching hashes and growing the map does not hash callsigns again.
+	// inserting may move all values, pointers and references returned before are invalidated by get.
+	template<typename T>
+	class CallsignMap {
+	public:
+		T* find(std::string_view callsign)
+		{
+			return this->find(callsign, hashCallsign(callsign));
+		}
+
+		T* find(std::string_view callsign, uint64_t hash)
+		{
+			size_t slot = this->findSlot(callsign, hash);
+			return slot == npos ? nullptr : &this->slots[slot].value;
+		}
+
+		const T* find(std::string_view callsign) const
+		{
+			return const_cast<CallsignMap*>(this)->find(callsign);
+		}
+
+		const T* find(std::string_view callsign, uint64_t hash) const
+		{
+			return const_cast<CallsignMap*>(this)->find(callsign, hash);
+		}
+
+		// get returns the value stored for the callsign, inserting a default constructed value if none exists
+		T& get(std::string_view callsign)
+		{
+			return this->get(callsign, hashCallsign(callsign));
+		}
+
+		T& get(std::string_view callsign, uint64_t hash)
+		{
+			size_t slot = this->findSlot(callsign, hash);
+			if (slot != npos) {
+				return this->slots[slot].value;
+			}
+
+			// keep the load factor at or below 1/2, probe sequences stay short
+			if ((this->count + 1) * 2 > this->slots.size()) {
+				this->grow();
+			}
+
+			slot = hash & (this->slots.size() - 1);
+			while (this->slots[slot].used) {
+				slot = (slot + 1) & (this->slots.size() - 1);
+			}
+
+			Slot& s = this->slots[slot];
+			s.used = true;
+			s.hash = hash;
+			s.callsign = callsign;
+			s.value = T();
+			this->count++;
+
+			return s.value;
+		}
+
+		bool erase(std::string_view callsign)
+		{
+			size_t slot = this->findSlot(callsign, hashCallsign(callsign));
+			if (slot == npos) {
+				return false;
+			}
+
+			this->eraseSlot(slot);
+			return true;
+		}
+
+		// eraseIf erases all entries the predicate returns true for, called with the callsign and value. returns the number of erased entries
+		template<typename Predicate>
+		size_t eraseIf(Predicate predicate)
+		{
+			size_t erased = 0;
+			for (size_t i = 0; i < this->slots.size();) {
+				Slot& s = this->slots[i];
+				if (s.used && predicate(std::string_view(s.callsign), s.value)) {
+					// backward shift may move a not yet visited entry into this slot, check it again
+					this->eraseSlot(i);
+					erased++;
+					continue;
+				}
+				i++;
+			}
+
+			return erased;
+		}
+
+		// forEach calls the function with the callsign and value of all entries
+		template<typename Function>
+		void forEach(Function function)
+		{
+			for (Slot& s : this->slots) {
+				if (s.used) {
+					function(std::string_view(s.callsign), s.value);
+				}
+			}
+		}
+
+		void clear()
+		{
+			// keeps the allocated slots (and callsign buffers) for reuse
+			for (Slot& s : this->slots) {
+				if (s.used) {
+					s.used = false;
+					s.value = T();
+				}
+			}
+			this->count = 0;
+		}
+
+		size_t size() const
+		{
+			return this->count;
+		}
+	private:
+		static constexpr size_t npos = (size_t)-1;
+		static constexpr size_t MIN_SLOTS = 64;
+
+		struct Slot {
+			bool used = false;
+			uint64_t hash = 0;
+			std::string callsign;
+			T value{};
+		};
+
+		// slot count is always zero or a power of two
+		std::vector<Slot> slots;
+		size_t count = 0;
+
+		size_t findSlot(std::string_view callsign, uint64_t hash) const
+		{
+			if (this->slots.empty()) {
+				return npos;
+			}
+
+			size_t mask = this->slots.size() - 1;
+			for (size_t slot = hash & mask; this->slots[slot].used; slot = (slot + 1) & mask) {
+				if (this->slots[slot].hash == hash && this->slots[slot].callsign == callsign) {
+					return slot;
+				}
+			}
+
+			return npos;
+		}
+
+		void eraseSlot(size_t slot)
+		{
+			// backward shift deletion, moving subsequent entries of the probe sequence into the gap instead of leaving tombstones
+			size_t mask = this->slots.size() - 1;
+			size_t gap = slot;
+			for (size_t next = (gap + 1) & mask; this->slots[next].used; next = (next + 1) & mask) {
+				size_t home = this->slots[next].hash & mask;
+				// entry can fill the gap if its home slot is not within (gap, next]
+				if (((next - home) & mask) >= ((next - gap) & mask)) {
+					std::swap(this->slots[gap], this->slots[next]);
+					gap = next;
+				}
+			}
+
+			this->slots[gap].used = false;
+			this->slots[gap].value = T();
+			this->count--;
+		}
+
+		void grow()
+		{
+			std::vector<Slot> old = std::move(this->slots);
+			this->slots = std::vector<Slot>(old.empty() ? MIN_SLOTS : old.size() * 2);
+
+			size_t mask = this->slots.size() - 1;
+			for (Slot& s : old) {
+				if (!s.used) {
+					continue;
+				}
+
+				size_t slot = s.hash & mask;
+				while (this->slots[slot].used) {
+					slot = (slot + 1) & mask;
+				}
+				this->slots[slot] = std::move(s);
+			}
+		}
+	};
+}
\ No newline at end of file
@@ -0,0 +1,257 @@
+#include "batch.h"
+
+namespace {
+	constexpr double NaN = std::numeric_limits<double>::quiet_NaN();
+
+	double valueOrNaN(const IASsure::CalculationResult& result)
+	{
+		return result.ok() ? result.value : NaN;
+	}
+
+	// uses the Exact atmosphere model like the AVX2 kernel, results do not depend on the instruction set supported by the CPU
+	void calculateAirDataScalar(IASsure::AirDataBatch& batch, size_t begin, size_t end)
+	{
+		for (size_t i = begin; i < end; i++) {
+			IASsure::WeatherReferenceLevel lvl{ batch.temperature[i], batch.windSpeed[i], batch.windDirection[i] };
+			batch.tas[i] = valueOrNaN(IASsure::tryCalculateTAS(batch.heading[i], batch.groundSpeed[i], lvl));
+			batch.cas[i] = valueOrNaN(IASsure::tryCalculateCAS(batch.altitude[i], batch.heading[i], batch.groundSpeed[i], lvl, IASsure::AtmosphereModel::Exact));
+			batch.mach[i] = valueOrNaN(IASsure::tryCalculateMach(batch.altitude[i], batch.heading[i], batch.groundSpeed[i], lvl, IASsure::AtmosphereModel::Exact));
+		}
+	}
+
+#ifdef IASSURE_SIMD_X86
+	// Taylor series coefficients (ascending) of the polynomial approximations below, truncation errors are below 1e-17
+	constexpr double EXP_COEFFICIENTS[] = { 1.0, 1.0, 1.0 / 2, 1.0 / 6, 1.0 / 24, 1.0 / 120, 1.0 / 720, 1.0 / 5040, 1.0 / 40320, 1.0 / 362880,
+		1.0 / 3628800, 1.0 / 39916800, 1.0 / 479001600, 1.0 / 6227020800 };
+	// 2 * atanh(s) / s in terms of s^2
+	constexpr double LOG_COEFFICIENTS[] = { 2.0, 2.0 / 3, 2.0 / 5, 2.0 / 7, 2.0 / 9, 2.0 / 11, 2.0 / 13, 2.0 / 15, 2.0 / 17, 2.0 / 19, 2.0 / 21 };
+	// cos(r) and sin(r) / r in terms of r^2
+	constexpr double COS_COEFFICIENTS[] = { 1.0, -1.0 / 2, 1.0 / 24, -1.0 / 720, 1.0 / 40320, -1.0 / 3628800, 1.0 / 479001600, -1.0 / 87178291200,
+		1.0 / 20922789888000 };
+	constexpr double SIN_COEFFICIENTS[] = { 1.0, -1.0 / 6, 1.0 / 120, -1.0 / 5040, 1.0 / 362880, -1.0 / 39916800, 1.0 / 6227020800, -1.0 / 1307674368000,
+		1.0 / 355687428096000 };
+
+	// ln(2) split into a high part with trailing zero bits (n * LN2_HIGH is exact for any exponent n) and the remainder
+	constexpr double LN2_HIGH = 6.93147180369123816490e-01;
+	constexpr double LN2_LOW = 1.90821492927058770002e-10;
+	// exp arguments are clamped to keep 2^n within the range of normal doubles
+	constexpr double EXP_MAX_ARGUMENT = 700;
+
+	template<size_t N>
+	IASSURE_TARGET_AVX2 __m256d polynomial256(__m256d x, const double(&coefficients)[N])
+	{
+		__m256d p = _mm256_set1_pd(coefficients[N - 1]);
+		for (size_t k = N - 1; k-- > 0;) {
+			p = _mm256_add_pd(_mm256_mul_pd(p, x), _mm256_set1_pd(coefficients[k]));
+		}
+
+		return p;
+	}
+
+	IASSURE_TARGET_AVX2 __m256d exp256(__m256d x)
+	{
+		x = _mm256_max_pd(_mm256_min_pd(x, _mm256_set1_pd(EXP_MAX_ARGUMENT)), _mm256_set1_pd(-EXP_MAX_ARGUMENT));
+
+		// exp(x) = 2^n * exp(r) with |r| <= ln(2) / 2
+		__m256d n = _mm256_round_pd(_mm256_mul_pd(x, _mm256_set1_pd(std::numbers::log2e)), _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+		__m256d r = _mm256_sub_pd(_mm256_sub_pd(x, _mm256_mul_pd(n, _mm256_set1_pd(LN2_HIGH))), _mm256_mul_pd(n, _mm256_set1_pd(LN2_LOW)));
+		__m256d p = polynomial256(r, EXP_COEFFICIENTS);
+
+		// build 2^n directly from its exponent bits
+		__m256i exponent = _mm256_add_epi64(_mm256_cvtepi32_epi64(_mm256_cvtpd_epi32(n)), _mm256_set1_epi64x(1023));
+		return _mm256_mul_pd(p, _mm256_castsi256_pd(_mm256_slli_epi64(exponent, 52)));
+	}
+
+	// natural logarithm for positive, normal arguments
+	IASSURE_TARGET_AVX2 __m256d log256(__m256d x)
+	{
+		// log(x) = e * ln(2) + log(m) with mantissa m in [1, 2)
+		__m256i bits = _mm256_castpd_si256(x);
+		__m256d m = _mm256_castsi256_pd(_mm256_or_si256(_mm256_and_si256(bits, _mm256_set1_epi64x(0x000FFFFFFFFFFFFF)), _mm256_set1_epi64x(0x3FF0000000000000)));
+		// AVX2 has no 64 bit integer to double conversion, use the biased exponent as mantissa of 2^52 instead
+		__m256d e = _mm256_sub_pd(_mm256_castsi256_pd(_mm256_or_si256(_mm256_srli_epi64(bits, 52), _mm256_set1_epi64x(0x4330000000000000))), _mm256_set1_pd(4503599627370496.0 + 1023));
+
+		// move mantissa to [sqrt(2) / 2, sqrt(2)), keeping the series argument small
+		__m256d large = _mm256_cmp_pd(m, _mm256_set1_pd(std::numbers::sqrt2), _CMP_GT_OQ);
+		m = _mm256_blendv_pd(m, _mm256_mul_pd(m, _mm256_set1_pd(0.5)), large);
+		e = _mm256_add_pd(e, _mm256_and_pd(large, _mm256_set1_pd(1.0)));
+
+		// log(m) = 2 * atanh(s) with s = (m - 1) / (m + 1), |s| <= 0.172
+		__m256d s = _mm256_div_pd(_mm256_sub_pd(m, _mm256_set1_pd(1.0)), _mm256_add_pd(m, _mm256_set1_pd(1.0)));
+		__m256d p = _mm256_mul_pd(s, polynomial256(_mm256_mul_pd(s, s), LOG_COEFFICIENTS));
+
+		return _mm256_add_pd(_mm256_mul_pd(e, _mm256_set1_pd(LN2_HIGH)), _mm256_add_pd(p, _mm256_mul_pd(e, _mm256_set1_pd(LN2_LOW))));
+	}
+
+	IASSURE_TARGET_AVX2 __m256d pow256(__m256d x, double y)
+	{
+		return exp256(_mm256_mul_pd(log256(x), _mm256_set1_pd(y)));
+	}
+
+	// cosine of an angle given in degrees
+	IASSURE_TARGET_AVX2 __m256d cosDegrees256(__m256d degrees)
+	{
+		// reduce to r in [-45, 45] degrees (exact in degrees) with quadrant n
+		__m256d n = _mm256_round_pd(_mm256_mul_pd(degrees, _mm256_set1_pd(1.0 / 90)), _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+		__m256d r = _mm256_mul_pd(_mm256_sub_pd(degrees, _mm256_mul_pd(n, _mm256_set1_pd(90))), _mm256_set1_pd(std::numbers::pi / 180));
+		__m256d r2 = _mm256_mul_pd(r, r);
+
+		__m256d c = polynomial256(r2, COS_COEFFICIENTS);
+		__m256d s = _mm256_mul_pd(r, polynomial256(r2, SIN_COEFFICIENTS));
+
+		// quadrants 0-3 (n mod 4) result in cos(r), -sin(r), -cos(r), sin(r)
+		__m256i q = _mm256_cvtepi32_epi64(_mm256_cvtpd_epi32(n));
+		__m256d odd = _mm256_castsi256_pd(_mm256_cmpeq_epi64(_mm256_and_si256(q, _mm256_set1_epi64x(1)), _mm256_set1_epi64x(1)));
+		__m256d negative = _mm256_castsi256_pd(_mm256_cmpeq_epi64(_mm256_and_si256(_mm256_add_epi64(q, _mm256_set1_epi64x(1)), _mm256_set1_epi64x(2)), _mm256_set1_epi64x(2)));
+
+		return _mm256_xor_pd(_mm256_blendv_pd(c, s, odd), _mm256_and_pd(negative, _mm256_set1_pd(-0.0)));
+	}
+
+	IASSURE_TARGET_AVX2 void calculateAirDataAVX2(IASsure::AirDataBatch& batch, size_t begin, size_t end)
+	{
+		using namespace IASsure;
+
+		const __m256d zero = _mm256_setzero_pd();
+		const __m256d one = _mm256_set1_pd(1.0);
+		const __m256d nan = _mm256_set1_pd(NaN);
+
+		// constants of calculateStaticPressure
+		const double beta = GRAVITATIONAL_ACCELERATION_SEA_LEVEL / (SPECIFIC_GAS_CONSTANT_DRY_AIR * TEMPERATURE_LAPSE_RATE_LOW);
+		const double hs = (SPECIFIC_GAS_CONSTANT_DRY_AIR * STANDARD_TEMPERATURE_HIGH) / GRAVITATIONAL_ACCELERATION_SEA_LEVEL;
+
+		size_t i = begin;
+		for (; i + 4 <= end; i += 4) {
+			__m256d alt = _mm256_loadu_pd(batch.altitude.data() + i);
+			__m256d hdg = _mm256_loadu_pd(batch.heading.data() + i);
+			__m256d gs = _mm256_loadu_pd(batch.groundSpeed.data() + i);
+			__m256d temperature = _mm256_loadu_pd(batch.temperature.data() + i);
+			__m256d windSpeed = _mm256_loadu_pd(batch.windSpeed.data() + i);
+			__m256d windDirection = _mm256_loadu_pd(batch.windDirection.data() + i);
+
+			// calculateTAS
+			__m256d tas = _mm256_add_pd(gs, _mm256_mul_pd(windSpeed, cosDegrees256(_mm256_sub_pd(windDirection, hdg))));
+
+			// calculateTemperature, used in case no weather data is available
+			__m256d altM = _mm256_mul_pd(alt, _mm256_set1_pd(METER_PER_FEET));
+			__m256d low = _mm256_cmp_pd(alt, _mm256_set1_pd(ALTITUDE_LOW_UPPER_LIMIT_FEET), _CMP_LT_OQ);
+			__m256d aboveLow = _mm256_sub_pd(altM, _mm256_set1_pd(ALTITUDE_LOW_UPPER_LIMIT));
+			__m256d isaTemperature = _mm256_blendv_pd(
+				_mm256_add_pd(_mm256_set1_pd(STANDARD_TEMPERATURE_HIGH), _mm256_mul_pd(_mm256_set1_pd(TEMPERATURE_LAPSE_RATE_HIGH), aboveLow)),
+				_mm256_add_pd(_mm256_set1_pd(STANDARD_TEMPERATURE_LOW), _mm256_mul_pd(_mm256_set1_pd(TEMPERATURE_LAPSE_RATE_LOW), altM)),
+				low);
+			__m256d hasWeather = _mm256_or_pd(_mm256_or_pd(_mm256_cmp_pd(temperature, zero, _CMP_NEQ_UQ), _mm256_cmp_pd(windSpeed, zero, _CMP_NEQ_UQ)), _mm256_cmp_pd(windDirection, zero, _CMP_NEQ_UQ));
+			__m256d temp = _mm256_blendv_pd(isaTemperature, temperature, hasWeather);
+
+			// calculateStaticPressure, evaluating a single exp for both layers
+			__m256d lowExponent = _mm256_mul_pd(_mm256_set1_pd(-beta), log256(_mm256_add_pd(one, _mm256_div_pd(_mm256_mul_pd(_mm256_set1_pd(TEMPERATURE_LAPSE_RATE_LOW), altM), _mm256_set1_pd(STANDARD_TEMPERATURE_LOW)))));
+			__m256d highExponent = _mm256_div_pd(_mm256_sub_pd(zero, aboveLow), _mm256_set1_pd(hs));
+			__m256d ps = _mm256_mul_pd(
+				_mm256_blendv_pd(_mm256_set1_pd(STATIC_PRESSURE_HIGH), _mm256_set1_pd(STATIC_PRESSURE_LOW), low),
+				exp256(_mm256_blendv_pd(highExponent, lowExponent, low)));
+
+			// calculateSpeedOfSound and calculateMach
+			__m256d a = _mm256_sqrt_pd(_mm256_mul_pd(_mm256_set1_pd(HEAT_CAPACITY_RATIO_AIR * SPECIFIC_GAS_CONSTANT_DRY_AIR), temp));
+			__m256d mach = _mm256_div_pd(_mm256_mul_pd(tas, _mm256_set1_pd(METERS_PER_SECOND_PER_KNOT)), a);
+
+			// calculateDynamicPressure and calculateCAS
+			__m256d qc = _mm256_mul_pd(ps, _mm256_sub_pd(pow256(_mm256_add_pd(_mm256_mul_pd(_mm256_set1_pd((HEAT_CAPACITY_RATIO_AIR - 1) / 2), _mm256_mul_pd(mach, mach)), one), HEAT_CAPACITY_RATIO_AIR / (HEAT_CAPACITY_RATIO_AIR - 1)), one));
+			__m256d tmp2 = pow256(_mm256_add_pd(_mm256_div_pd(qc, _mm256_set1_pd(ATMOSPHERIC_PRESSURE_SEA_LEVEL)), one), (HEAT_CAPACITY_RATIO_AIR - 1) / HEAT_CAPACITY_RATIO_AIR);
+			__m256d tmp3 = _mm256_mul_pd(_mm256_set1_pd(2 / (HEAT_CAPACITY_RATIO_AIR - 1)), _mm256_sub_pd(tmp2, one));
+			__m256d cas = _mm256_mul_pd(_mm256_mul_pd(_mm256_set1_pd(SPEED_OF_SOUND), _mm256_sqrt_pd(tmp3)), _mm256_set1_pd(KNOTS_PER_METER_PER_SECOND));
+
+			// mark results outside of the supported ranges, matching the exceptions thrown by the scalar calculations
+			__m256d gsSupported = _mm256_cmp_pd(gs, zero, _CMP_GT_OQ);
+			__m256d tasSupported = _mm256_and_pd(gsSupported, _mm256_cmp_pd(tas, zero, _CMP_GT_OQ));
+			__m256d altitudeSupported = _mm256_cmp_pd(alt, _mm256_set1_pd(ALTITUDE_HIGH_UPPER_LIMIT_FEET), _CMP_LE_OQ);
+
+			_mm256_storeu_pd(batch.tas.data() + i, _mm256_blendv_pd(nan, tas, gsSupported));
+			_mm256_storeu_pd(batch.cas.data() + i, _mm256_blendv_pd(nan, cas, _mm256_and_pd(tasSupported, altitudeSupported)));
+			_mm256_storeu_pd(batch.mach.data() + i, _mm256_blendv_pd(nan, mach, _mm256_and_pd(tasSupported, _mm256_or_pd(altitudeSupported, hasWeather))));
+		}
+
+		calculateAirDataScalar(batch, i, end);
+	}
+#endif
+
+	void calculateAirDataRange(IASsure::AirDataBatch& batch, IASsure::simd::InstructionSet instructionSet, size_t begin, size_t end)
+	{
+		switch (instructionSet) {
+#ifdef IASSURE_SIMD_X86
+		case IASsure::simd::InstructionSet::AVX2:
+			calculateAirDataAVX2(batch, begin, end);
+			break;
+#endif
+		default:
+			calculateAirDataScalar(batch, begin, end);
+			break;
+		}
+	}
+
+	// validates the inputs and allocates the results of the batch, returning the number of targets
+	size_t prepare(IASsure::AirDataBatch& batch)
+	{
+		size_t count = batch.size();
+		if (batch.heading.size() != count || batch.groundSpeed.size() != count || batch.temperature.size() != count ||
+			batch.windSpeed.size() != count || batch.windDirection.size() != count) {
+			throw std::invalid_argument("air data batch inputs differ in size");
+		}
+
+		batch.tas.resize(count);
+		batch.cas.resize(count);
+		batch.mach.resize(count);
+
+		return count;
+	}
+}
+
+void IASsure::AirDataBatch::add(double alt, double hdg, double gs, const WeatherReferenceLevel& lvl)
+{
+	this->altitude.push_back(alt);
+	this->heading.push_back(hdg);
+	this->groundSpeed.push_back(gs);
+	this->temperature.push_back(lvl.temperature);
+	this->windSpeed.push_back(lvl.windSpeed);
+	this->windDirection.push_back(lvl.windDirection);
+}
+
+void IASsure::AirDataBatch::clear()
+{
+	this->altitude.clear();
+	this->heading.clear();
+	this->groundSpeed.clear();
+	this->temperature.clear();
+	this->windSpeed.clear();
+	this->windDirection.clear();
+	this->tas.clear();
+	this->cas.clear();
+	this->mach.clear();
+}
+
+size_t IASsure::AirDataBatch::size() const
+{
+	return this->altitude.size();
+}
+
+void IASsure::calculateAirData(AirDataBatch& batch)
+{
+	calculateAirData(batch, simd::supported());
+}
+
+void IASsure::calculateAirData(AirDataBatch& batch, simd::InstructionSet instructionSet)
+{
+	size_t count = prepare(batch);
+	calculateAirDataRange(batch, instructionSet, 0, count);
+}
+
+void IASsure::calculateAirData(AirDataBatch& batch, thread::ThreadPool& pool)
+{
+	calculateAirData(batch, simd::supported(), pool);
+}
+
+void IASsure::calculateAirData(AirDataBatch& batch, simd::InstructionSet instructionSet, thread::ThreadPool& pool)
+{
+	size_t count = prepare(batch);
+	pool.parallelFor(count, AIR_DATA_BATCH_GRAIN_SIZE, [&batch, instructionSet](size_t begin, size_t end) {
+		calculateAirDataRange(batch, instructionSet, begin, end);
+		});
+}
\ No newline at end of file
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <numbers>
+#include <stdexcept>
+#include <vector>
+
+#include "calculations.h"
+#include "simd.h"
+#include "thread.h"
+
+namespace IASsure {
+	// maximum deviation of vectorised batch results from the scalar calculations (calculateTAS, calculateCAS, calculateMach) relative to
+	// the scalar result, or absolute for results smaller than 1. caused by the polynomial approximations of exp, log and cos used instead
+	// of the standard library, measured deviations are below 2e-11
+	constexpr double AIR_DATA_BATCH_TOLERANCE = 1e-10;
+	// number of targets calculated per task when splitting a batch across a thread pool, a multiple of the vector width
+	constexpr size_t AIR_DATA_BATCH_GRAIN_SIZE = 512;
+
+	// AirDataBatch stores the inputs and results of air data calculations for multiple targets as structure of arrays,
+	// allowing calculateAirData to process several targets at once using vector instructions.
+	class AirDataBatch {
+	public:
+		std::vector<double> altitude; // in ft
+		std::vector<double> heading; // in deg
+		std::vector<double> groundSpeed; // in kn
+		// weather data as stored in WeatherReferenceLevel, all zero if no weather data is available
+		std::vector<double> temperature; // in K
+		std::vector<double> windSpeed; // in kn
+		std::vector<double> windDirection; // in deg
+
+		// results are NaN for targets outside of the supported range, where the scalar calculations would throw std::domain_error
+		std::vector<double> tas; // in kn
+		std::vector<double> cas; // in kn
+		std::vector<double> mach;
+
+		void add(double alt, double hdg, double gs, const WeatherReferenceLevel& lvl);
+		void clear();
+		size_t size() const;
+	};
+
+	// calculateAirData calculates TAS, CAS and Mach number for all targets of the batch, using the best instruction set supported
+	// by the CPU unless specified explicitly. AVX2 is vectorised, all other instruction sets use the scalar calculations.
+	// batches always evaluate the ISA atmosphere with AtmosphereModel::Exact, independent of the instruction set.
+	// throws std::invalid_argument if the input arrays differ in size.
+	void calculateAirData(AirDataBatch& batch);
+	void calculateAirData(AirDataBatch& batch, simd::InstructionSet instructionSet);
+	// calculateAirData splits the batch into ranges of AIR_DATA_BATCH_GRAIN_SIZE targets calculated in parallel on the thread pool
+	void calculateAirData(AirDataBatch& batch, thread::ThreadPool& pool);
+	void calculateAirData(AirDataBatch& batch, simd::InstructionSet instructionSet, thread::ThreadPool& pool);
+}
\ No newline at end of file
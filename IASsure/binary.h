@@ -0,0 +1,91 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+namespace IASsure {
+	// binary implements the encoding shared by the binary file formats (weather cache, recordings), storing values in native byte order
+	namespace binary {
+		class Writer {
+		public:
+			template<typename T>
+			void write(T value)
+			{
+				static_assert(std::is_trivially_copyable_v<T>);
+				this->data.append(reinterpret_cast<const char*>(&value), sizeof(T));
+			}
+
+			void write(std::string_view value)
+			{
+				this->write((uint32_t)value.size());
+				this->data.append(value);
+			}
+
+			void write(const std::string& value)
+			{
+				this->write(std::string_view(value));
+			}
+
+			std::string data;
+		};
+
+		// Reader reads values stored by Writer, throwing std::invalid_argument if the data is truncated
+		class Reader {
+		public:
+			Reader(std::string_view data) : data(data)
+			{
+			}
+
+			template<typename T>
+			T read()
+			{
+				static_assert(std::is_trivially_copyable_v<T>);
+				this->require(1, sizeof(T));
+
+				T value;
+				std::memcpy(&value, this->data.data(), sizeof(T));
+				this->data.remove_prefix(sizeof(T));
+				return value;
+			}
+
+			std::string readString()
+			{
+				uint32_t length = this->read<uint32_t>();
+				return std::string(this->readBytes(length));
+			}
+
+			std::string_view readBytes(size_t length)
+			{
+				this->require(length, 1);
+
+				std::string_view value = this->data.substr(0, length);
+				this->data.remove_prefix(length);
+				return value;
+			}
+
+			// require ensures enough data is available for count elements, preventing huge allocations for corrupt counts
+			void require(size_t count, size_t elementSize)
+			{
+				if (count > this->data.size() / elementSize) {
+					throw std::invalid_argument("binary data is truncated");
+				}
+			}
+
+			bool empty() const
+			{
+				return this->data.empty();
+			}
+
+			size_t remaining() const
+			{
+				return this->data.size();
+			}
+		private:
+			std::string_view data;
+		};
+	}
+}
\ No newline at end of file
@@ -1,53 +1,128 @@
 #include "calculations.h"
 
-double IASsure::calculateTAS(double hdg, double gs, ::IASsure::WeatherReferenceLevel lvl)
+#include "isa.h"
+
+namespace {
+	// evaluated by the compiler, no barometric formula is calculated at runtime for table lookups
+	constexpr IASsure::isa::Table ISA_TABLE = IASsure::isa::buildTable();
+
+	double interpolateTable(const std::array<double, IASsure::isa::TABLE_SIZE>& values, double alt)
+	{
+		double index = (alt - IASsure::isa::TABLE_MIN_ALTITUDE) / IASsure::isa::TABLE_STEP;
+		size_t lower = (size_t)index;
+		if (lower + 1 >= IASsure::isa::TABLE_SIZE) {
+			return values[IASsure::isa::TABLE_SIZE - 1];
+		}
+
+		double t = index - lower;
+		return values[lower] + (values[lower + 1] - values[lower]) * t;
+	}
+
+	// table interval containing the tropopause, interpolating across it would smooth the kink of the temperature profile
+	constexpr size_t TROPOPAUSE_INTERVAL = (size_t)((IASsure::ALTITUDE_LOW_UPPER_LIMIT_FEET - IASsure::isa::TABLE_MIN_ALTITUDE) / IASsure::isa::TABLE_STEP);
+
+	bool coveredByTable(double alt)
+	{
+		return alt >= IASsure::isa::TABLE_MIN_ALTITUDE && (size_t)((alt - IASsure::isa::TABLE_MIN_ALTITUDE) / IASsure::isa::TABLE_STEP) != TROPOPAUSE_INTERVAL;
+	}
+
+	IASsure::CalculationResult success(double value)
+	{
+		return IASsure::CalculationResult{ IASsure::CalculationStatus::Success, value };
+	}
+
+	IASsure::CalculationResult failure(IASsure::CalculationStatus status)
+	{
+		return IASsure::CalculationResult{ status, 0 };
+	}
+
+	// valueOrThrow unwraps results for the throwing calculation functions, raising the exceptions previously thrown by the calculations
+	double valueOrThrow(const IASsure::CalculationResult& result)
+	{
+		switch (result.status) {
+		case IASsure::CalculationStatus::Success:
+			return result.value;
+		case IASsure::CalculationStatus::GroundSpeedOutOfRange:
+			throw std::domain_error("ground speed outside of supported range");
+		case IASsure::CalculationStatus::AltitudeOutOfRange:
+			throw std::domain_error("altitude outside of supported range");
+		case IASsure::CalculationStatus::TrueAirSpeedOutOfRange:
+			throw std::domain_error("true air speed outside of supported range");
+		default:
+			throw std::domain_error("calculation failed");
+		}
+	}
+
+	// casFromDynamicPressure and machFromTAS contain the final steps shared by tryCalculateCAS, tryCalculateMach and calculateAirData
+	double casFromDynamicPressure(double qc)
+	{
+		double tmp1 = 2 / (IASsure::HEAT_CAPACITY_RATIO_AIR - 1);
+		double tmp2 = std::pow((qc / IASsure::ATMOSPHERIC_PRESSURE_SEA_LEVEL) + 1, (IASsure::HEAT_CAPACITY_RATIO_AIR - 1) / IASsure::HEAT_CAPACITY_RATIO_AIR);
+		double tmp3 = tmp1 * (tmp2 - 1);
+
+		return IASsure::SPEED_OF_SOUND * std::sqrt(tmp3) * IASsure::KNOTS_PER_METER_PER_SECOND;
+	}
+
+	double machFromTAS(double tas, double temp)
+	{
+		double a = IASsure::calculateSpeedOfSound(temp);
+
+		return (tas * IASsure::METERS_PER_SECOND_PER_KNOT) / a;
+	}
+}
+
+bool IASsure::CalculationResult::ok() const
+{
+	return this->status == CalculationStatus::Success;
+}
+
+IASsure::CalculationResult IASsure::tryCalculateTAS(double hdg, double gs, ::IASsure::WeatherReferenceLevel lvl)
 {
 	if (gs <= 0) {
-		throw std::domain_error("ground speed outside of supported range");
+		return failure(CalculationStatus::GroundSpeedOutOfRange);
 	}
 
 	double c = std::cos(IASsure::degToRad(lvl.windDirection - hdg));
 	double windComponent = c * lvl.windSpeed;
-	return gs + windComponent;
+	return success(gs + windComponent);
 }
 
-double IASsure::calculateTemperature(double alt)
+IASsure::CalculationResult IASsure::tryCalculateTemperature(double alt, AtmosphereModel model)
 {
 	double altM = (double)alt * METER_PER_FEET;
 
 	if (alt > ALTITUDE_HIGH_UPPER_LIMIT_FEET) {
-		throw std::domain_error("altitude outside of supported range");
+		return failure(CalculationStatus::AltitudeOutOfRange);
+	} else if (model == AtmosphereModel::Table && coveredByTable(alt)) {
+		return success(interpolateTable(ISA_TABLE.temperature, alt));
 	} else if (alt < ALTITUDE_LOW_UPPER_LIMIT_FEET) {
-		return STANDARD_TEMPERATURE_LOW + TEMPERATURE_LAPSE_RATE_LOW * altM;
+		return success(STANDARD_TEMPERATURE_LOW + TEMPERATURE_LAPSE_RATE_LOW * altM);
 	}
 
-	return STANDARD_TEMPERATURE_HIGH + TEMPERATURE_LAPSE_RATE_HIGH * (altM - ALTITUDE_LOW_UPPER_LIMIT);
+	return success(STANDARD_TEMPERATURE_HIGH + TEMPERATURE_LAPSE_RATE_HIGH * (altM - ALTITUDE_LOW_UPPER_LIMIT));
 }
 
-double IASsure::calculateStaticPressure(double alt)
+IASsure::CalculationResult IASsure::tryCalculateStaticPressure(double alt, AtmosphereModel model)
 {
 	double altM = (double)alt * METER_PER_FEET;
 
 	if (alt > ALTITUDE_HIGH_UPPER_LIMIT_FEET) {
-		throw std::domain_error("altitude outside of supported range");
+		return failure(CalculationStatus::AltitudeOutOfRange);
+	} else if (model == AtmosphereModel::Table && coveredByTable(alt)) {
+		return success(interpolateTable(ISA_TABLE.pressure, alt));
 	} else if (alt < ALTITUDE_LOW_UPPER_LIMIT_FEET) {
 		double beta = GRAVITATIONAL_ACCELERATION_SEA_LEVEL / (SPECIFIC_GAS_CONSTANT_DRY_AIR * TEMPERATURE_LAPSE_RATE_LOW);
-		return STATIC_PRESSURE_LOW * std::pow(1 + ((TEMPERATURE_LAPSE_RATE_LOW * altM) / STANDARD_TEMPERATURE_LOW), -1 * beta);
+		return success(STATIC_PRESSURE_LOW * std::pow(1 + ((TEMPERATURE_LAPSE_RATE_LOW * altM) / STANDARD_TEMPERATURE_LOW), -1 * beta));
 	}
 	
 	double hs = (SPECIFIC_GAS_CONSTANT_DRY_AIR * STANDARD_TEMPERATURE_HIGH) / GRAVITATIONAL_ACCELERATION_SEA_LEVEL;
-	return STATIC_PRESSURE_HIGH * std::exp(-1 * ((altM - ALTITUDE_LOW_UPPER_LIMIT) / hs));
-}
-
-double IASsure::calculateSpeedOfSound(double temp)
-{
-	return std::sqrt(HEAT_CAPACITY_RATIO_AIR * SPECIFIC_GAS_CONSTANT_DRY_AIR * temp);
+	return success(STATIC_PRESSURE_HIGH * std::exp(-1 * ((altM - ALTITUDE_LOW_UPPER_LIMIT) / hs)));
 }
 
-double IASsure::calculateDynamicPressure(double ps, double temp, double tas)
+IASsure::CalculationResult IASsure::tryCalculateDynamicPressure(double ps, double temp, double tas)
 {
 	if (tas <= 0) {
-		throw std::domain_error("true air speed outside of supported range");
+		return failure(CalculationStatus::TrueAirSpeedOutOfRange);
 	}
 
 	double a = std::sqrt(HEAT_CAPACITY_RATIO_AIR * SPECIFIC_GAS_CONSTANT_DRY_AIR * temp);
@@ -58,54 +133,154 @@ double IASsure::calculateDynamicPressure(double ps, double temp, double tas)
 
 	double qc = ps * (tmp3 - 1);
 
-	return qc;
+	return success(qc);
 }
 
-double IASsure::calculateCAS(double alt, double hdg, double gs, ::IASsure::WeatherReferenceLevel lvl)
+IASsure::CalculationResult IASsure::tryCalculateCAS(double alt, double hdg, double gs, ::IASsure::WeatherReferenceLevel lvl, AtmosphereModel model)
 {
-	double tas = calculateTAS(hdg, gs, lvl);
+	CalculationResult tas = tryCalculateTAS(hdg, gs, lvl);
+	if (!tas.ok()) {
+		return tas;
+	}
 
 	// adapted from http://walter.bislins.ch/blog/index.asp?page=Fluggeschwindigkeiten%2C+IAS%2C+TAS%2C+EAS%2C+CAS%2C+Mach @ 2022-07-31T20:23:00Z
-	double ps = calculateStaticPressure(alt);
+	CalculationResult ps = tryCalculateStaticPressure(alt, model);
+	if (!ps.ok()) {
+		return ps;
+	}
 	double temp;
 	if (lvl.isZero()) {
 		// fallback to ISA temperature in case no wind/temperature data is available 
-		temp = calculateTemperature(alt);
+		CalculationResult isaTemp = tryCalculateTemperature(alt, model);
+		if (!isaTemp.ok()) {
+			return isaTemp;
+		}
+		temp = isaTemp.value;
 	}
 	else {
 		temp = lvl.temperature;
 	}
-	double qc = calculateDynamicPressure(ps, temp, tas);
-
-	double tmp1 = 2 / (HEAT_CAPACITY_RATIO_AIR - 1);
-	double tmp2 = std::pow((qc / ATMOSPHERIC_PRESSURE_SEA_LEVEL) + 1, (HEAT_CAPACITY_RATIO_AIR - 1) / HEAT_CAPACITY_RATIO_AIR);
-	double tmp3 = tmp1 * (tmp2 - 1);
-
-	double cas = SPEED_OF_SOUND * std::sqrt(tmp3) * KNOTS_PER_METER_PER_SECOND;
+	CalculationResult qc = tryCalculateDynamicPressure(ps.value, temp, tas.value);
+	if (!qc.ok()) {
+		return qc;
+	}
 
-	return cas;
+	return success(casFromDynamicPressure(qc.value));
 }
 
-double IASsure::calculateMach(double alt, double hdg, double gs, ::IASsure::WeatherReferenceLevel lvl)
+IASsure::CalculationResult IASsure::tryCalculateMach(double alt, double hdg, double gs, ::IASsure::WeatherReferenceLevel lvl, AtmosphereModel model)
 {
-	double tas = calculateTAS(hdg, gs, lvl);
+	CalculationResult tas = tryCalculateTAS(hdg, gs, lvl);
+	if (!tas.ok()) {
+		return tas;
+	}
 
-	if (tas <= 0) {
-		throw std::domain_error("true air speed outside of supported range");
+	if (tas.value <= 0) {
+		return failure(CalculationStatus::TrueAirSpeedOutOfRange);
 	}
 
 	// adapted from http://walter.bislins.ch/blog/index.asp?page=Fluggeschwindigkeiten%2C+IAS%2C+TAS%2C+EAS%2C+CAS%2C+Mach#H_Mach_Speed @ 2022-08-03T22:17:28Z
 	double temp;
 	if (lvl.isZero()) {
 		// fallback to ISA temperature in case no wind/temperature data is available 
-		temp = calculateTemperature(alt);
+		CalculationResult isaTemp = tryCalculateTemperature(alt, model);
+		if (!isaTemp.ok()) {
+			return isaTemp;
+		}
+		temp = isaTemp.value;
 	}
 	else {
 		temp = lvl.temperature;
 	}
-	double a = calculateSpeedOfSound(temp);
 
-	double mach = (tas * METERS_PER_SECOND_PER_KNOT) / a;
+	return success(machFromTAS(tas.value, temp));
+}
+
+IASsure::AirData IASsure::calculateAirData(double alt, double hdg, double gs, ::IASsure::WeatherReferenceLevel lvl, AtmosphereModel model)
+{
+	AirData data;
 
-	return mach;
+	// wind component is independent of the ground speed, reported for parked aircraft as well. same as tryCalculateTAS, which is
+	// not used to avoid evaluating the cosine twice
+	double windComponent = std::cos(IASsure::degToRad(lvl.windDirection - hdg)) * lvl.windSpeed;
+	data.windComponent = success(windComponent);
+	data.tas = gs <= 0 ? failure(CalculationStatus::GroundSpeedOutOfRange) : success(gs + windComponent);
+
+	CalculationResult isaTemp = tryCalculateTemperature(alt, model);
+	if (lvl.isZero()) {
+		// fallback to ISA temperature in case no wind/temperature data is available
+		data.temperature = isaTemp;
+		data.isaDeviation = isaTemp.ok() ? success(0) : isaTemp;
+	}
+	else {
+		data.temperature = success(lvl.temperature);
+		data.isaDeviation = isaTemp.ok() ? success(lvl.temperature - isaTemp.value) : isaTemp;
+	}
+
+	// statuses are checked in the same order as tryCalculateCAS and tryCalculateMach, reporting the same failures
+	if (!data.tas.ok()) {
+		data.mach = data.tas;
+	}
+	else if (data.tas.value <= 0) {
+		data.mach = failure(CalculationStatus::TrueAirSpeedOutOfRange);
+	}
+	else if (!data.temperature.ok()) {
+		data.mach = data.temperature;
+	}
+	else {
+		data.mach = success(machFromTAS(data.tas.value, data.temperature.value));
+	}
+
+	if (!data.tas.ok()) {
+		data.cas = data.tas;
+		return data;
+	}
+	CalculationResult ps = tryCalculateStaticPressure(alt, model);
+	if (!ps.ok()) {
+		data.cas = ps;
+		return data;
+	}
+	if (!data.temperature.ok()) {
+		data.cas = data.temperature;
+		return data;
+	}
+	CalculationResult qc = tryCalculateDynamicPressure(ps.value, data.temperature.value, data.tas.value);
+	data.cas = qc.ok() ? success(casFromDynamicPressure(qc.value)) : qc;
+
+	return data;
+}
+
+double IASsure::calculateTAS(double hdg, double gs, ::IASsure::WeatherReferenceLevel lvl)
+{
+	return valueOrThrow(tryCalculateTAS(hdg, gs, lvl));
 }
+
+double IASsure::calculateTemperature(double alt, AtmosphereModel model)
+{
+	return valueOrThrow(tryCalculateTemperature(alt, model));
+}
+
+double IASsure::calculateStaticPressure(double alt, AtmosphereModel model)
+{
+	return valueOrThrow(tryCalculateStaticPressure(alt, model));
+}
+
+double IASsure::calculateSpeedOfSound(double temp)
+{
+	return std::sqrt(HEAT_CAPACITY_RATIO_AIR * SPECIFIC_GAS_CONSTANT_DRY_AIR * temp);
+}
+
+double IASsure::calculateDynamicPressure(double ps, double temp, double tas)
+{
+	return valueOrThrow(tryCalculateDynamicPressure(ps, temp, tas));
+}
+
+double IASsure::calculateCAS(double alt, double hdg, double gs, ::IASsure::WeatherReferenceLevel lvl, AtmosphereModel model)
+{
+	return valueOrThrow(tryCalculateCAS(alt, hdg, gs, lvl, model));
+}
+
+double IASsure::calculateMach(double alt, double hdg, double gs, ::IASsure::WeatherReferenceLevel lvl, AtmosphereModel model)
+{
+	return valueOrThrow(tryCalculateMach(alt, hdg, gs, lvl, model));
+}
\ No newline at end of file
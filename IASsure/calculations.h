@@ -7,13 +7,60 @@
 #include "haversine.h"
 
 namespace IASsure {
+	// AtmosphereModel selects how ISA temperature and static pressure are evaluated. Exact evaluates the barometric formula on every call,
+	// Table interpolates linearly between values precomputed at compile time (see isa.h), deviating less than 1e-7 (relative) from Exact.
+	enum class AtmosphereModel {
+		Exact,
+		Table,
+	};
+
+	enum class CalculationStatus {
+		Success,
+		GroundSpeedOutOfRange,
+		AltitudeOutOfRange,
+		TrueAirSpeedOutOfRange,
+	};
+
+	// CalculationResult is returned by the non-throwing calculation functions, value is only valid if status is Success
+	class CalculationResult {
+	public:
+		CalculationStatus status;
+		double value;
+
+		bool ok() const;
+	};
+
+	// AirData contains all values derived from a single target state, calculated in one pass sharing TAS, ISA atmosphere and
+	// temperature between them. each value carries its own status, e.g. the wind component is available for parked aircraft as well.
+	class AirData {
+	public:
+		CalculationResult tas; // in kn
+		CalculationResult cas; // in kn
+		CalculationResult mach;
+		CalculationResult temperature; // outside air temperature in K, ISA temperature if no weather data is available
+		CalculationResult isaDeviation; // in K
+		CalculationResult windComponent; // along the heading in kn, positive for headwind and negative for tailwind
+	};
+
+	// the tryCalculate functions report inputs outside of the supported ranges via their status instead of throwing, allowing them to be
+	// used for every target on every update without the cost of exceptions. the calculate functions throw std::domain_error instead.
+	CalculationResult tryCalculateTAS(double hdg, double gs, ::IASsure::WeatherReferenceLevel lvl);
+	CalculationResult tryCalculateTemperature(double alt, AtmosphereModel model = AtmosphereModel::Exact);
+	CalculationResult tryCalculateStaticPressure(double alt, AtmosphereModel model = AtmosphereModel::Exact);
+	CalculationResult tryCalculateDynamicPressure(double ps, double temp, double tas);
+	CalculationResult tryCalculateCAS(double alt, double hdg, double gs, ::IASsure::WeatherReferenceLevel lvl, AtmosphereModel model = AtmosphereModel::Exact);
+	CalculationResult tryCalculateMach(double alt, double hdg, double gs, ::IASsure::WeatherReferenceLevel lvl, AtmosphereModel model = AtmosphereModel::Exact);
+
+	// calculateAirData calculates all air data of a target without throwing, matching the results of the individual tryCalculate functions
+	AirData calculateAirData(double alt, double hdg, double gs, ::IASsure::WeatherReferenceLevel lvl, AtmosphereModel model = AtmosphereModel::Exact);
+
 	double calculateTAS(double hdg, double gs, ::IASsure::WeatherReferenceLevel lvl);
-	double calculateTemperature(double alt);
-	double calculateStaticPressure(double altM);
+	double calculateTemperature(double alt, AtmosphereModel model = AtmosphereModel::Exact);
+	double calculateStaticPressure(double alt, AtmosphereModel model = AtmosphereModel::Exact);
 	double calculateDynamicPressure(double ps, double temp, double tas);
 	double calculateSpeedOfSound(double temp);
-	double calculateCAS(double alt, double hdg, double gs, ::IASsure::WeatherReferenceLevel lvl);
-	double calculateMach(double alt, double hdg, double gs, ::IASsure::WeatherReferenceLevel lvl);
+	double calculateCAS(double alt, double hdg, double gs, ::IASsure::WeatherReferenceLevel lvl, AtmosphereModel model = AtmosphereModel::Exact);
+	double calculateMach(double alt, double hdg, double gs, ::IASsure::WeatherReferenceLevel lvl, AtmosphereModel model = AtmosphereModel::Exact);
 
 	constexpr double HEAT_CAPACITY_RATIO_AIR = 1.403; // https://en.wikipedia.org/wiki/Heat_capacity_ratio
 	constexpr double ATMOSPHERIC_PRESSURE_SEA_LEVEL = 101325; // in Pa https://en.wikipedia.org/wiki/Atmospheric_pressure#Altitude_variation
@@ -1,7 +1,5 @@
 #pragma once
 
-#include <Windows.h>
-
 constexpr auto PLUGIN_NAME = "IASsure";
 constexpr auto PLUGIN_VERSION = "1.5.0";
 constexpr auto PLUGIN_AUTHOR = "Nick Mueller";
@@ -21,6 +19,9 @@ const int TAG_ITEM_CALCULATED_MACH = 5;
 const int TAG_ITEM_CALCULATED_MACH_TOGGLABLE = 6;
 const int TAG_ITEM_CALCULATED_MACH_ABOVE_THRESHOLD = 7;
 const int TAG_ITEM_CALCULATED_MACH_ABOVE_THRESHOLD_TOGGLABLE = 8;
+const int TAG_ITEM_CALCULATED_TAS = 9;
+const int TAG_ITEM_CALCULATED_WIND_COMPONENT = 10;
+const int TAG_ITEM_COUNT = 10;
 
 const int TAG_FUNC_OPEN_REPORTED_IAS_MENU = 100;
 const int TAG_FUNC_CLEAR_REPORTED_IAS = 101;
@@ -43,5 +44,10 @@ const int INTERVAL_REPORTED_MACH = 1;
 const int MIN_MACH_DIGITS = 1;
 const int MAX_MACH_DIGITS = 5;
 const int TAG_ITEM_MAX_CONTENT_LENGTH = 14;
+const int AIRCRAFT_EVICTION_INTERVAL = 60; // in seconds
+const int DEFAULT_THREAD_POOL_WORKERS = 2;
+const int MAX_THREAD_POOL_WORKERS = 64;
 
-constexpr auto CONFIG_FILE_NAME = "config.json";
\ No newline at end of file
+constexpr auto CONFIG_FILE_NAME = "config.json";
+constexpr auto WEATHER_CACHE_FILE_NAME = "weather.cache";
+constexpr auto RECORDING_FILE_NAME = "recording.iasr";
\ No newline at end of file
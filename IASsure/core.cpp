@@ -0,0 +1,1509 @@
+#include "core.h"
+
+#include <cstring>
+
+IASsure::Core::Core(host::Host& host) :
+	host(host),
+	debug(false),
+	weatherUpdateInterval(5),
+	weatherGrid(false),
+	useReportedGS(true),
+	useTrueNorthHeading(true),
+	prefixIAS("I"),
+	prefixMach("M"),
+	machDigits(2),
+	machThresholdFL(24500),
+	unreliableIASIndicator("DIAS"),
+	unreliableMachIndicator("DMACH"),
+	broadcastUnreliableSpeed(true),
+	aircraftTimeout(10),
+	threadPoolWorkers(DEFAULT_THREAD_POOL_WORKERS),
+	threadPool(nullptr),
+	atmosphereModel(AtmosphereModel::Table),
+	airDataPipeline(weather, atmosphereModel),
+	airDataSnapshot(airDataPipeline.snapshot()),
+	positionSequence(0),
+	settingsVersion(0),
+	weatherUpdater(nullptr),
+	connected(false),
+	recorder(nullptr)
+{
+	std::ostringstream msg;
+	msg << "Version " << PLUGIN_VERSION << " loaded.";
+
+	this->LogMessage(msg.str());
+
+	this->TryLoadConfigFile();
+	this->LoadSettings();
+	this->StartThreadPool();
+	this->LoadWeatherCache();
+}
+
+IASsure::Core::~Core()
+{
+	this->StopRecording();
+	this->StopWeatherUpdater();
+	if (this->weatherGridUpdate.valid()) {
+		this->weatherGridUpdate.wait();
+	}
+	this->StopThreadPool();
+}
+
+bool IASsure::Core::OnCompileCommand(const char* sCommandLine)
+{
+	std::vector<std::string> args = split(sCommandLine);
+
+	if (args[0] == ".ias") {
+		if (this->recorder != nullptr && (args.size() == 1 || args[1] != "record")) {
+			this->recorder->recordCommand(sCommandLine);
+		}
+
+		if (args.size() == 1) {
+			std::ostringstream msg;
+			msg << "Version " << PLUGIN_VERSION << " loaded. Available commands: debug, reset, reload, weather, gs, hdg, prefix, mach, state, record";
+
+			this->LogMessage(msg.str());
+			return true;
+		}
+
+		if (args[1] == "debug") {
+			if (this->debug) {
+				this->LogMessage("Disabling debug mode", "Config");
+			}
+			else {
+				this->LogMessage("Enabling debug mode", "Config");
+			}
+
+			this->debug = !this->debug;
+
+			this->SaveSettings();
+			return true;
+		}
+		else if (args[1] == "reset") {
+			this->LogMessage("Resetting plugin state", "Config");
+
+			this->aircraft.clear();
+			this->airDataPipeline.clear();
+
+			this->weather.clear();
+			this->LoadWeatherCache();
+			this->ResetWeatherUpdater();
+
+			return true;
+		}
+		else if (args[1] == "state") {
+			std::ostringstream msg;
+			msg << "Currently storing state for " << this->aircraft.size() << " aircraft.";
+			if (this->aircraftTimeout.count() > 0) {
+				msg << " State of aircraft without radar updates is removed after " << this->aircraftTimeout.count() << (this->aircraftTimeout.count() > 1 ? " minutes." : " minute.");
+			}
+
+			this->LogMessage(msg.str(), "Config");
+			return true;
+		}
+		else if (args[1] == "record") {
+			if (this->recorder == nullptr) {
+				this->StartRecording();
+			}
+			else {
+				this->StopRecording();
+			}
+
+			return true;
+		}
+		else if (args[1] == "reload") {
+			this->LogMessage("Reloading plugin config", "Config");
+
+			this->TryLoadConfigFile();
+			this->ResetThreadPool();
+			this->settingsVersion++;
+
+			return true;
+		}
+		else if (args[1] == "weather") {
+			if (args.size() == 2) {
+				std::ostringstream msg;
+				if (this->weatherUpdateInterval.count() == 0) {
+					msg << "Automatic weather data update disabled.";
+				}
+				else {
+					msg << "Weather data is automatically updated every " << this->weatherUpdateInterval.count() << (this->weatherUpdateInterval.count() > 1 ? " minutes." : " minute.");
+				}
+				msg << " " << this->weather.skippedParses() << (this->weather.skippedParses() == 1 ? " update was" : " updates were") << " skipped since the weather data was unchanged.";
+				msg << " Use .ias weather update <MIN> to change the update interval (set 0 to disable automatic refreshing).";
+				msg << " Use .ias weather url <URL> to set the URL to retrieve weather data from.";
+				msg << " Use .ias weather clear to clear all currently stored weather data, falling back to windless speed calculations.";
+
+				this->LogMessage(msg.str(), "Config");
+				return true;
+			}
+
+			if (args[2] == "update") {
+				if (args.size() == 3) {
+					this->LogMessage("Automatic weather data update interval is missing. Usage: .ias weather update <MIN>");
+					return true;
+				}
+				int min;
+				try {
+					min = std::stoi(args[3]);
+				}
+				catch (std::exception const&) {
+					this->LogMessage("Invalid automatic weather data update interval. Usage: .ias weather update <MIN>", "Config");
+					return true;
+				}
+
+				this->weatherUpdateInterval = std::chrono::minutes(min);
+				this->ResetWeatherUpdater();
+
+				std::ostringstream msg;
+				if (this->weatherUpdateInterval.count() > 0) {
+					msg << "Automatic weather data update interval set to " << this->weatherUpdateInterval.count() << (this->weatherUpdateInterval.count() > 1 ? " minutes" : " minute");
+				}
+				else {
+					msg << "Automatic weather data update disabled";
+				}
+
+				this->LogMessage(msg.str(), "Config");
+
+				this->SaveSettings();
+				return true;
+			}
+			else if (args[2] == "url") {
+				if (args.size() == 3) {
+					this->LogMessage("Weather update URL is missing. Usage: .ias weather url <URL>");
+					return true;
+				}
+
+				this->weatherUpdateURL = args[3];
+				this->ResetWeatherUpdater();
+
+				std::ostringstream msg;
+				msg << "Weather update URL set to " << this->weatherUpdateURL;
+
+				this->LogMessage(msg.str(), "Config");
+
+				this->SaveSettings();
+				return true;
+			}
+			else if (args[2] == "clear") {
+				this->weather.clear();
+				// calculations fall back to windless speeds immediately instead of waiting for the next radar update
+				this->settingsVersion++;
+				this->LogMessage("Cleared weather data", "Config");
+				return true;
+			}
+		}
+		else if (args[1] == "gs") {
+			if (this->useReportedGS) {
+				this->LogMessage("Switched to using ground speed estimated by EuroScope for CAS/Mach calculations", "Config");
+			}
+			else {
+				this->LogMessage("Switched to using ground speed reported by pilot client for CAS/Mach calculations", "Config");
+			}
+
+			this->useReportedGS = !this->useReportedGS;
+			this->settingsVersion++;
+
+			this->SaveSettings();
+			return true;
+		}
+		else if (args[1] == "hdg") {
+			if (this->useTrueNorthHeading) {
+				this->LogMessage("Switched to using magnetic heading for CAS/Mach calculations", "Config");
+			}
+			else {
+				this->LogMessage("Switched to using true north heading for CAS/Mach calculations", "Config");
+			}
+
+			this->useTrueNorthHeading = !this->useTrueNorthHeading;
+			this->settingsVersion++;
+
+			this->SaveSettings();
+			return true;
+		}
+		else if (args[1] == "prefix") {
+			if (args.size() == 2) {
+				this->LogMessage("Use .ias prefix ias <PREFIX> to set the indicated air speed prefix. Use .ias prefix mach <PREFIX> to set the mach number prefix.", "Config");
+				return true;
+			}
+
+			if (args[2] == "ias") {
+				if (args.size() == 3) {
+					this->LogMessage("Disabling indicated air speed prefix", "Config");
+					this->prefixIAS = "";
+				}
+				else {
+					if (args[3].size() > (size_t)(TAG_ITEM_MAX_CONTENT_LENGTH - this->machDigits)) {
+						std::ostringstream msg;
+						msg << "Indicated air speed prefix is too long, must be " << (TAG_ITEM_MAX_CONTENT_LENGTH - this->machDigits) << " characters or less";
+						this->LogMessage(msg.str(), "Config");
+						return true;
+					}
+
+					this->LogMessage("Configured indicated air speed prefix", "Config");
+					this->prefixIAS = args[3];
+				}
+
+				this->settingsVersion++;
+				this->SaveSettings();
+				return true;
+			}
+			else if (args[2] == "mach") {
+				if (args.size() == 3) {
+					this->LogMessage("Disabling mach number prefix", "Config");
+					this->prefixMach = "";
+				}
+				else {
+					if (args[3].size() > (size_t)(TAG_ITEM_MAX_CONTENT_LENGTH - this->machDigits)) {
+						std::ostringstream msg;
+						msg << "Mach number prefix is too long, must be " << (TAG_ITEM_MAX_CONTENT_LENGTH - this->machDigits) << " characters or less";
+						this->LogMessage(msg.str(), "Config");
+						return true;
+					}
+
+					this->LogMessage("Configured mach number prefix", "Config");
+					this->prefixMach = args[3];
+				}
+
+				this->settingsVersion++;
+				this->SaveSettings();
+				return true;
+			}
+		}
+		else if (args[1] == "mach") {
+			if (args.size() == 2) {
+				this->LogMessage("Use .ias mach digits <DIGITS> to set the desired digits displayed for mach numbers (range 1-13). Use .ias mach threshold <FLIGHTLEVEL> to set a flight level threshold below which no mach number will be calculated.", "Config");
+				return true;
+			}
+
+			if (args[2] == "digits") {
+				if (args.size() == 3) {
+					this->LogMessage("Digit count for mach numbers is missing. Usage: .ias mach digits <DIGITS>");
+					return true;
+				}
+
+				int digits;
+				try {
+					digits = std::stoi(args[3]);
+				}
+				catch (std::exception const&) {
+					this->LogMessage("Invalid digit count for mach numbers. Usage: .ias mach digits <DIGITS>", "Config");
+					return true;
+				}
+
+				if (digits < MIN_MACH_DIGITS || digits > MAX_MACH_DIGITS) {
+					std::ostringstream msg;
+					msg << "Invalid digit count for mach numbers. Must be between " << MIN_MACH_DIGITS << " and " << MAX_MACH_DIGITS;
+					this->LogMessage(msg.str(), "Config");
+					return true;
+				}
+
+				this->machDigits = digits;
+				this->settingsVersion++;
+
+				std::ostringstream msg;
+				msg << "Displaying mach numbers with " << this->machDigits << " digits precision";
+				this->LogMessage(msg.str(), "Config");
+
+				this->SaveSettings();
+				return true;
+			}
+			else if (args[2] == "threshold") {
+				if (args.size() == 3) {
+					this->LogMessage("Flight level threshold for mach calculations is missing. Usage: .ias mach threshold <FLIGHTLEVEL>");
+					return true;
+				}
+
+				int threshold;
+				try {
+					threshold = std::stoi(args[3]);
+				}
+				catch (std::exception const&) {
+					this->LogMessage("Invalid flight level threshold for mach calculations. Usage: .ias mach threshold <FLIGHTLEVEL>", "Config");
+					return true;
+				}
+
+				if (threshold < 0) {
+					this->LogMessage("Invalid flight level threshold for mach calculations. Must be greater than 0", "Config");
+					return true;
+				}
+
+				this->machThresholdFL = threshold * 100;
+				this->settingsVersion++;
+
+				std::ostringstream msg;
+				msg << "Displaying mach numbers for aircraft flying higher than FL" << this->machThresholdFL << " in threshold tag item";
+				this->LogMessage(msg.str(), "Config");
+
+				this->SaveSettings();
+				return true;
+			}
+		}
+	}
+
+	return false;
+}
+
+void IASsure::Core::OnGetTagItem(const host::RadarTarget& RadarTarget, int ItemCode, char sItemString[16], int* pColorCode, host::Color* pRGB)
+{
+	if (ItemCode < 1 || ItemCode > TAG_ITEM_COUNT) {
+		return;
+	}
+
+	Aircraft& ac = this->GetAircraft(RadarTarget);
+	CachedTagItem& item = ac.cache.tagItems[ItemCode - 1];
+	if (item.valid) {
+		// nothing changed since the tag item was last formatted
+		this->CopyTagItem(item, sItemString, pColorCode, pRGB);
+		return;
+	}
+
+	item.content[0] = '\0';
+	item.colorCode = host::TAG_COLOR_DEFAULT;
+	item.rgb = 0;
+
+	switch (ItemCode) {
+	case TAG_ITEM_CALCULATED_IAS:
+		this->ShowCalculatedIAS(ac, item.content, &item.colorCode, &item.rgb);
+		break;
+	case TAG_ITEM_CALCULATED_IAS_ABBREVIATED:
+		this->ShowCalculatedIAS(ac, item.content, &item.colorCode, &item.rgb, true);
+		break;
+	case TAG_ITEM_CALCULATED_IAS_TOGGLABLE:
+		this->ShowCalculatedIAS(ac, item.content, &item.colorCode, &item.rgb, false, true);
+		break;
+	case TAG_ITEM_CALCULATED_IAS_ABBREVIATED_TOGGLABLE:
+		this->ShowCalculatedIAS(ac, item.content, &item.colorCode, &item.rgb, true, true);
+		break;
+	case TAG_ITEM_CALCULATED_MACH:
+		this->ShowCalculatedMach(RadarTarget, ac, item.content, &item.colorCode, &item.rgb);
+		break;
+	case TAG_ITEM_CALCULATED_MACH_ABOVE_THRESHOLD:
+		this->ShowCalculatedMach(RadarTarget, ac, item.content, &item.colorCode, &item.rgb, true);
+		break;
+	case TAG_ITEM_CALCULATED_MACH_TOGGLABLE:
+		this->ShowCalculatedMach(RadarTarget, ac, item.content, &item.colorCode, &item.rgb, false, true);
+		break;
+	case TAG_ITEM_CALCULATED_MACH_ABOVE_THRESHOLD_TOGGLABLE:
+		this->ShowCalculatedMach(RadarTarget, ac, item.content, &item.colorCode, &item.rgb, true, true);
+		break;
+	case TAG_ITEM_CALCULATED_TAS:
+		this->ShowCalculatedTAS(ac, item.content);
+		break;
+	case TAG_ITEM_CALCULATED_WIND_COMPONENT:
+		this->ShowCalculatedWindComponent(ac, item.content);
+		break;
+	}
+
+	item.valid = true;
+	this->CopyTagItem(item, sItemString, pColorCode, pRGB);
+}
+
+void IASsure::Core::CopyTagItem(const CachedTagItem& item, char tagItemContent[16], int* tagItemColorCode, host::Color* tagItemRGB)
+{
+	// cached content is always null terminated
+	std::memcpy(tagItemContent, item.content, sizeof(item.content));
+	if (item.colorCode != host::TAG_COLOR_DEFAULT) {
+		// keep the color chosen by the host unless the tag item was formatted with a specific color
+		*tagItemColorCode = item.colorCode;
+		*tagItemRGB = item.rgb;
+	}
+}
+
+void IASsure::Core::OnFunctionCall(int FunctionId, const char* sItemString, host::FlightPlan& FlightPlan)
+{
+	if (this->recorder != nullptr) {
+		this->recorder->recordFlightPlan(FlightPlanEvent::FunctionCall, FlightPlan, FunctionId, sItemString);
+	}
+
+	switch (FunctionId) {
+	case TAG_FUNC_CLEAR_REPORTED_IAS:
+		this->ClearReportedIAS(FlightPlan);
+		break;
+	case TAG_FUNC_TOGGLE_CALCULATED_IAS:
+		this->ToggleCalculatedIAS(FlightPlan);
+		break;
+	case TAG_FUNC_TOGGLE_CALCULATED_IAS_ABBREVIATED:
+		this->ToggleCalculatedIAS(FlightPlan, true);
+		break;
+	case TAG_FUNC_SET_REPORTED_IAS:
+		this->SetReportedIAS(FlightPlan, sItemString);
+		break;
+	case TAG_FUNC_CLEAR_REPORTED_MACH:
+		this->ClearReportedMach(FlightPlan);
+		break;
+	case TAG_FUNC_TOGGLE_CALCULATED_MACH:
+		this->ToggleCalculatedMach(FlightPlan);
+		break;
+	case TAG_FUNC_TOGGLE_CALCULATED_MACH_ABOVE_THRESHOLD:
+		this->ToggleCalculatedMach(FlightPlan, true);
+		break;
+	case TAG_FUNC_SET_REPORTED_MACH:
+		this->SetReportedMach(FlightPlan, sItemString);
+		break;
+	case TAG_FUNC_TOGGLE_UNRELIABLE_SPEED:
+		this->ToggleUnreliableSpeed(FlightPlan);
+		break;
+	}
+}
+
+int IASsure::Core::GetReportedIASSelection(const host::RadarTarget& rt)
+{
+	int ias = this->useReportedGS ? rt.reportedGS() : rt.calculatedGS();
+	double calculatedIAS = this->CalculateIAS(rt);
+	if (calculatedIAS >= 0) {
+		ias = roundToNearest(calculatedIAS, INTERVAL_REPORTED_IAS);
+	}
+
+	return ias;
+}
+
+int IASsure::Core::GetReportedMachSelection(const host::RadarTarget& rt)
+{
+	int mach = 0;
+	double calculatedMach = this->CalculateMach(rt);
+	if (calculatedMach >= 0) {
+		mach = roundToNearest(calculatedMach * 100, INTERVAL_REPORTED_MACH);
+	}
+
+	return mach;
+}
+
+void IASsure::Core::OnFlightPlanScratchPadUpdate(const host::FlightPlan& FlightPlan)
+{
+	if (this->recorder != nullptr) {
+		this->recorder->recordFlightPlan(FlightPlanEvent::ScratchPadUpdate, FlightPlan);
+	}
+
+	this->CheckScratchPadBroadcast(FlightPlan);
+}
+
+void IASsure::Core::OnFlightPlanFlightStripReceived(const host::FlightPlan& FlightPlan)
+{
+	if (this->recorder != nullptr) {
+		this->recorder->recordFlightPlan(FlightPlanEvent::FlightStripReceived, FlightPlan);
+	}
+
+	// tag is being pushed to us, check if we need to set unreliable speed indication from flightstrip
+	this->CheckFlightStripAnnotations(FlightPlan);
+}
+
+void IASsure::Core::OnRadarTargetPositionUpdate(const host::RadarTarget& RadarTarget)
+{
+	if (this->recorder != nullptr) {
+		this->recorder->recordWeather();
+		this->recorder->recordPosition(RadarTarget);
+	}
+
+	Aircraft& ac = this->aircraft.get(RadarTarget.callsign());
+	if (ac.cache.minimumPosition == 0) {
+		// results of a previous state with the same callsign might still be published, only accept results captured from now on
+		ac.cache.minimumPosition = this->positionSequence + 1;
+		ac.cache.settingsVersion = this->settingsVersion;
+	}
+	ac.cache.latestPosition = ++this->positionSequence;
+	ac.lastPositionUpdate = std::chrono::steady_clock::now();
+
+	// only copies the radar data, air data is calculated in the background and picked up by the next tag item
+	this->airDataPipeline.capture(RadarTarget.callsign(), ac.cache.latestPosition, this->GetAirDataInput(RadarTarget), this->settingsVersion);
+}
+
+void IASsure::Core::OnFlightPlanDisconnect(const host::FlightPlan& FlightPlan)
+{
+	if (this->recorder != nullptr) {
+		this->recorder->recordFlightPlan(FlightPlanEvent::Disconnect, FlightPlan);
+	}
+
+	if (this->aircraft.erase(FlightPlan.callsign())) {
+		this->airDataPipeline.remove(FlightPlan.callsign());
+		this->LogDebugMessage("Removed state of disconnected aircraft", std::string(FlightPlan.callsign()));
+	}
+}
+
+void IASsure::Core::OnTimer(int Counter)
+{
+	if (this->recorder != nullptr) {
+		this->recorder->recordWeather();
+	}
+
+	if (Counter % 2) {
+		this->UpdateLoginState();
+	}
+
+	if (Counter % AIRCRAFT_EVICTION_INTERVAL == 0) {
+		this->EvictSilentAircraft();
+	}
+}
+
+void IASsure::Core::EvictSilentAircraft()
+{
+	if (this->aircraftTimeout.count() == 0) {
+		return;
+	}
+
+	auto now = std::chrono::steady_clock::now();
+	size_t evicted = this->aircraft.eraseIf([&](std::string_view callsign, Aircraft& ac) {
+		if (ac.lastPositionUpdate == std::chrono::steady_clock::time_point()) {
+			// no radar update received since the state was created, start the timeout now
+			ac.lastPositionUpdate = now;
+			return false;
+		}
+
+		if (now - ac.lastPositionUpdate <= this->aircraftTimeout) {
+			return false;
+		}
+
+		this->airDataPipeline.remove(callsign);
+		return true;
+		});
+
+	if (evicted > 0) {
+		std::ostringstream msg;
+		msg << "Removed state of " << evicted << " aircraft without radar updates";
+		this->LogDebugMessage(msg.str(), "State");
+	}
+}
+
+void IASsure::Core::SetReportedIAS(const host::FlightPlan& fp, std::string selected)
+{
+	int ias;
+	try {
+		ias = std::stoi(selected);
+	}
+	catch (std::exception const& ex) {
+		std::ostringstream msg;
+		msg << "Failed to parse reported IAS: " << ex.what();
+
+		this->LogMessage(msg.str());
+		return;
+	}
+
+	Aircraft& ac = this->aircraft.get(fp.callsign());
+	ac.state.reportedIAS = ias;
+	ac.cache.stateChanges++;
+}
+
+void IASsure::Core::ClearReportedIAS(const host::FlightPlan& fp)
+{
+	Aircraft* ac = this->aircraft.find(fp.callsign());
+	if (ac != nullptr) {
+		ac->state.reportedIAS.reset();
+		ac->cache.stateChanges++;
+	}
+}
+
+void IASsure::Core::ToggleCalculatedIAS(const host::FlightPlan& fp, bool abbreviated)
+{
+	Aircraft& ac = this->aircraft.get(fp.callsign());
+	ac.state.toggle(abbreviated ? AircraftToggle::CalculatedIASAbbreviated : AircraftToggle::CalculatedIAS);
+	ac.cache.stateChanges++;
+}
+
+double IASsure::Core::CalculateIAS(const host::RadarTarget& rt)
+{
+	const AirData& data = this->GetAircraft(rt).cache.data;
+	if (!data.cas.ok()) {
+		// gs or alt outside of supported ranges. no value to display in tag
+		return -1;
+	}
+
+	return data.cas.value;
+}
+
+void IASsure::Core::ShowCalculatedIAS(const Aircraft& ac, char tagItemContent[16], int* tagItemColorCode, host::Color* tagItemRGB, bool abbreviated, bool onlyToggled)
+{
+	if (onlyToggled && !ac.state.isToggled(abbreviated ? AircraftToggle::CalculatedIASAbbreviated : AircraftToggle::CalculatedIAS)) {
+		return;
+	}
+
+	bool unreliable = ac.state.isToggled(AircraftToggle::UnreliableSpeed);
+	if (unreliable && this->unreliableIASIndicator.size() > 0) {
+		// aircraft has been flagged as having unreliable speed, indicator for unreliable IAS was configured, set and skip calculations
+		format::TagItemWriter(tagItemContent, 16).text(this->unreliableIASIndicator);
+		if (this->unreliableIASColor.has_value()) {
+			*tagItemColorCode = host::TAG_COLOR_RGB_DEFINED;
+			*tagItemRGB = *this->unreliableIASColor;
+		}
+		return;
+	}
+
+	if (!ac.cache.data.cas.ok()) {
+		// gs or alt outside of supported ranges. no value to display in tag
+		return;
+	}
+
+	format::formatIAS(tagItemContent, 16, this->prefixIAS, ac.cache.data.cas.value, ac.state.reportedIAS, abbreviated);
+
+	if (unreliable && this->unreliableIASColor.has_value()) {
+		// aircraft has been flagged as having unreliable speed, but no unreliable IAS indicator was configured, but a color was set
+		*tagItemColorCode = host::TAG_COLOR_RGB_DEFINED;
+		*tagItemRGB = *this->unreliableIASColor;
+	}
+}
+
+void IASsure::Core::SetReportedMach(const host::FlightPlan& fp, std::string selected)
+{
+	int mach;
+	try {
+		mach = std::stoi(selected);
+	}
+	catch (std::exception const& ex) {
+		std::ostringstream msg;
+		msg << "Failed to parse reported Mach: " << ex.what();
+
+		this->LogMessage(msg.str());
+		return;
+	}
+
+	Aircraft& ac = this->aircraft.get(fp.callsign());
+	ac.state.reportedMach = (double)mach / 100.0;
+	ac.cache.stateChanges++;
+}
+
+void IASsure::Core::ClearReportedMach(const host::FlightPlan& fp)
+{
+	Aircraft* ac = this->aircraft.find(fp.callsign());
+	if (ac != nullptr) {
+		ac->state.reportedMach.reset();
+		ac->cache.stateChanges++;
+	}
+}
+
+void IASsure::Core::ToggleCalculatedMach(const host::FlightPlan& fp, bool aboveThreshold)
+{
+	Aircraft& ac = this->aircraft.get(fp.callsign());
+	ac.state.toggle(aboveThreshold ? AircraftToggle::CalculatedMachAboveThreshold : AircraftToggle::CalculatedMach);
+	ac.cache.stateChanges++;
+}
+
+double IASsure::Core::CalculateMach(const host::RadarTarget& rt)
+{
+	const AirData& data = this->GetAircraft(rt).cache.data;
+	if (!data.mach.ok()) {
+		// gs or alt outside of supported ranges. no value to display in tag
+		return -1;
+	}
+
+	return data.mach.value;
+}
+
+void IASsure::Core::ShowCalculatedMach(const host::RadarTarget& rt, const Aircraft& ac, char tagItemContent[16], int* tagItemColorCode, host::Color* tagItemRGB, bool aboveThreshold, bool onlyToggled)
+{
+	if (onlyToggled && !ac.state.isToggled(aboveThreshold ? AircraftToggle::CalculatedMachAboveThreshold : AircraftToggle::CalculatedMach)) {
+		return;
+	}
+
+	if (aboveThreshold && rt.flightLevel() < this->machThresholdFL) {
+		return;
+	}
+
+	bool unreliable = ac.state.isToggled(AircraftToggle::UnreliableSpeed);
+	if (unreliable && this->unreliableMachIndicator.size() > 0) {
+		// aircraft has been flagged as having unreliable speed, indicator for unreliable Mach number was configured, set and skip calculations
+		format::TagItemWriter(tagItemContent, 16).text(this->unreliableMachIndicator);
+		if (this->unreliableMachColor.has_value()) {
+			*tagItemColorCode = host::TAG_COLOR_RGB_DEFINED;
+			*tagItemRGB = *this->unreliableMachColor;
+		}
+		return;
+	}
+
+	if (!ac.cache.data.mach.ok()) {
+		// gs or alt outside of supported ranges. no value to display in tag
+		return;
+	}
+
+	format::formatMach(tagItemContent, 16, this->prefixMach, ac.cache.data.mach.value, ac.state.reportedMach, this->machDigits);
+
+	if (unreliable && this->unreliableMachColor.has_value()) {
+		// aircraft has been flagged as having unreliable speed, but no unreliable Mach number indicator was configured, but a color was set
+		*tagItemColorCode = host::TAG_COLOR_RGB_DEFINED;
+		*tagItemRGB = *this->unreliableMachColor;
+	}
+}
+
+IASsure::Aircraft& IASsure::Core::GetAircraft(const host::RadarTarget& rt)
+{
+	Aircraft& ac = this->aircraft.get(rt.callsign());
+	TargetCache& target = ac.cache;
+
+	if (target.minimumPosition == 0) {
+		// new state, see OnRadarTargetPositionUpdate
+		target.minimumPosition = this->positionSequence + 1;
+		target.settingsVersion = this->settingsVersion;
+	}
+
+	// air data calculated with previous settings (e.g. reported or calculated GS) is replaced by the first result using the current ones
+	bool outdated = target.settingsVersion != this->settingsVersion;
+
+	uint64_t sequence = this->airDataPipeline.sequence();
+	if (outdated || target.snapshotSequence != sequence) {
+		if (this->airDataSnapshot->sequence != sequence) {
+			this->airDataSnapshot = this->airDataPipeline.snapshot();
+		}
+		target.snapshotSequence = this->airDataSnapshot->sequence;
+
+		// results are only taken if calculated with the current settings and newer than the current air data, the synchronous
+		// calculation below might have been faster. results of inputs captured before changing settings are never taken.
+		const AirDataResult* result = this->airDataSnapshot->find(rt.callsign());
+		if (result != nullptr && result->settingsVersion == this->settingsVersion && result->position >= target.minimumPosition &&
+			(!target.valid || outdated || result->position > target.position ||
+			(result->position == target.position && result->weatherGeneration > target.weatherGeneration))) {
+			target.valid = true;
+			target.position = result->position;
+			target.weatherGeneration = result->weatherGeneration;
+			target.settingsVersion = result->settingsVersion;
+			target.data = result->data;
+			outdated = false;
+
+			// tag items of the previous air data are outdated as well
+			target.tagItems.fill(CachedTagItem());
+			target.tagItemState = target.stateChanges;
+		}
+	}
+
+	if (!target.valid || outdated) {
+		// no precomputed air data available for the current settings yet, calculate on the UI thread once
+		AirDataInput input = this->GetAirDataInput(rt);
+		WeatherReferenceLevel level = this->weather.findClosest(input.latitude, input.longitude, input.altitude, target.weatherLookupHint);
+
+		target.valid = true;
+		target.position = target.latestPosition;
+		target.weatherGeneration = this->weather.generation();
+		target.settingsVersion = this->settingsVersion;
+		target.data = calculateAirData(input.altitude, input.heading, input.groundSpeed, level, this->atmosphereModel);
+
+		target.tagItems.fill(CachedTagItem());
+		target.tagItemState = target.stateChanges;
+	}
+	else if (target.tagItemState != target.stateChanges) {
+		target.tagItems.fill(CachedTagItem());
+		target.tagItemState = target.stateChanges;
+	}
+
+	return ac;
+}
+
+IASsure::AirDataInput IASsure::Core::GetAirDataInput(const host::RadarTarget& rt)
+{
+	AirDataInput input;
+	input.latitude = rt.latitude();
+	input.longitude = rt.longitude();
+	input.altitude = rt.pressureAltitude(); // altitude in feet
+	input.heading = this->useTrueNorthHeading ? rt.reportedHeadingTrueNorth() : rt.reportedHeading(); // heading in degrees
+	input.groundSpeed = this->useReportedGS ? rt.reportedGS() : rt.calculatedGS(); // ground speed in knots
+
+	return input;
+}
+
+void IASsure::Core::ShowCalculatedTAS(const Aircraft& ac, char tagItemContent[16])
+{
+	const AirData& data = ac.cache.data;
+	if (!data.tas.ok() || data.tas.value <= 0) {
+		// gs outside of supported range. no value to display in tag
+		return;
+	}
+
+	format::formatTAS(tagItemContent, 16, data.tas.value);
+}
+
+void IASsure::Core::ShowCalculatedWindComponent(const Aircraft& ac, char tagItemContent[16])
+{
+	const AirData& data = ac.cache.data;
+	if (!data.windComponent.ok()) {
+		return;
+	}
+
+	format::formatWindComponent(tagItemContent, 16, data.windComponent.value);
+}
+
+void IASsure::Core::ToggleUnreliableSpeed(host::FlightPlan& fp)
+{
+	Aircraft& ac = this->aircraft.get(fp.callsign());
+	bool enabled = ac.state.toggle(AircraftToggle::UnreliableSpeed);
+	ac.cache.stateChanges++;
+
+	if (this->broadcastUnreliableSpeed) {
+		std::ostringstream msg;
+		msg << BROADCAST_PREFIX << BROADCAST_DELIMITER
+			<< BROADCAST_UNRELIABLE_SPEED;
+
+		this->SetFlightStripAnnotation(fp, enabled ? msg.str() : "");
+
+		msg << BROADCAST_DELIMITER << enabled;
+		this->BroadcastScratchPad(fp, msg.str());
+	}
+}
+
+void IASsure::Core::SetUnreliableSpeed(std::string_view callsign, bool unreliable)
+{
+	// only store state for aircraft flagged as unreliable, unknown aircraft are not flagged already
+	Aircraft* ac = unreliable ? &this->aircraft.get(callsign) : this->aircraft.find(callsign);
+	if (ac != nullptr) {
+		ac->state.setToggled(AircraftToggle::UnreliableSpeed, unreliable);
+		ac->cache.stateChanges++;
+	}
+}
+
+void IASsure::Core::BroadcastScratchPad(host::FlightPlan& fp, std::string msg)
+{
+	if (!fp.isTrackedByMe() && !fp.trackingControllerId().empty()) {
+		return;
+	}
+
+	std::string scratch = fp.scratchPad();
+
+	if (!fp.setScratchPad(msg)) {
+		this->LogMessage("Failed to set broadcast message in scratch pad", std::string(fp.callsign()));
+	}
+
+	if (!fp.setScratchPad(scratch)) {
+		this->LogMessage("Failed to reset scratch pad after setting broadcast message", std::string(fp.callsign()));
+	}
+}
+
+void IASsure::Core::CheckScratchPadBroadcast(const host::FlightPlan& fp)
+{
+	std::vector<std::string> scratch = split(fp.scratchPad(), BROADCAST_DELIMITER);
+
+	if (scratch.size() < 3 || scratch[0] != BROADCAST_PREFIX) {
+		return;
+	}
+
+	if (this->broadcastUnreliableSpeed && scratch[1] == BROADCAST_UNRELIABLE_SPEED) {
+		if (scratch[2] == "1") {
+			this->LogDebugMessage("Enabling unreliable speed indication for aircraft after broadcast", std::string(fp.callsign()));
+			this->SetUnreliableSpeed(fp.callsign(), true);
+		}
+		else {
+			this->LogDebugMessage("Disabling unreliable speed indication for aircraft after broadcast", std::string(fp.callsign()));
+			this->SetUnreliableSpeed(fp.callsign(), false);
+		}
+	}
+}
+
+void IASsure::Core::SetFlightStripAnnotation(host::FlightPlan& fp, std::string msg, int index)
+{
+	if (!fp.isTrackedByMe() && !fp.trackingControllerId().empty()) {
+		return;
+	}
+
+	if (!fp.setFlightStripAnnotation(index, msg)) {
+		this->LogMessage("Failed to set message in flight strip annotations", std::string(fp.callsign()));
+	}
+}
+
+void IASsure::Core::CheckFlightStripAnnotations(const host::FlightPlan& fp)
+{
+	std::string annotation = fp.flightStripAnnotation(BROADCAST_FLIGHT_STRIP_INDEX);
+	std::vector<std::string> msg = split(annotation, BROADCAST_DELIMITER);
+
+	if (msg.size() < 2 || msg[0] != BROADCAST_PREFIX) {
+		return;
+	}
+
+	if (this->broadcastUnreliableSpeed) {
+		if (msg[1] == BROADCAST_UNRELIABLE_SPEED) {
+			this->LogDebugMessage("Enabling unreliable speed indication for aircraft due to flight strip annotation", std::string(fp.callsign()));
+			this->SetUnreliableSpeed(fp.callsign(), true);
+		}
+		else {
+			this->LogDebugMessage("Disabling unreliable speed indication for aircraft due to empty flight strip annotation", std::string(fp.callsign()));
+			this->SetUnreliableSpeed(fp.callsign(), false);
+		}
+	}
+}
+
+void IASsure::Core::CheckFlightStripAnnotationsForAllAircraft()
+{
+	if (this->broadcastUnreliableSpeed) {
+		this->aircraft.forEach([](std::string_view, Aircraft& ac) {
+			if (ac.state.isToggled(AircraftToggle::UnreliableSpeed)) {
+				ac.state.setToggled(AircraftToggle::UnreliableSpeed, false);
+				ac.cache.stateChanges++;
+			}
+			});
+
+		this->host.forEachFlightPlan([this](host::FlightPlan& fp) {
+			this->CheckFlightStripAnnotations(fp);
+			});
+	}
+}
+
+void IASsure::Core::UpdateLoginState()
+{
+	// login state has not changed, nothing to do
+	bool connected = this->host.isConnected();
+	if (this->connected == connected) {
+		return;
+	}
+
+	this->connected = connected;
+
+	this->CheckLoginState();
+}
+
+void IASsure::Core::CheckLoginState()
+{
+	if (this->connected) {
+		// user is connected, start weather update if it's not running yet
+		this->StartWeatherUpdater();
+		this->CheckFlightStripAnnotationsForAllAircraft();
+	}
+	else {
+		// user is disconnected or is using incompatible connection (e.g. sweatbox), stop weather updater if it's running
+		this->StopWeatherUpdater();
+	}
+}
+
+void IASsure::Core::UpdateWeather()
+{
+	this->LogDebugMessage("Retrieving weather data", "Weather");
+
+	std::string weatherJSON;
+	try {
+		weatherJSON = this->host.download(this->weatherUpdateURL);
+	}
+	catch (std::exception const& ex) {
+		this->LogMessage("Failed to load weather data", "Weather");
+		this->LogDebugMessage(ex.what(), "Weather");
+		return;
+	}
+
+	this->LogDebugMessage("Parsing weather data", "Weather");
+	try {
+		if (!this->weather.parse(weatherJSON)) {
+			std::ostringstream msg;
+			msg << "Weather data unchanged, skipped parsing (" << this->weather.skippedParses() << " unchanged updates skipped so far)";
+			this->LogDebugMessage(msg.str(), "Weather");
+			return;
+		}
+	}
+	catch (std::exception const& ex) {
+		this->LogMessage("Failed to parse weather data", "Weather");
+		this->LogDebugMessage(ex.what(), "Weather");
+		return;
+	}
+
+	this->LogDebugMessage("Successfully updated weather data", "Weather");
+
+	if (this->weatherGrid && !this->weather.hasGrid()) {
+		this->LogMessage("Failed to build weather grid, using closest reference point for weather data", "Weather");
+	}
+
+	this->SaveWeatherCache();
+}
+
+void IASsure::Core::StartWeatherUpdater()
+{
+	if (this->weatherUpdateURL.empty() && this->weatherUpdateInterval.count() > 0) {
+		this->LogMessage("Weather update URL is empty, cannot fetch weather data for calculations. Configure via config file (config.json in same directory as IASsure.dll) or .ias weather url <URL>.", "Config");
+		return;
+	}
+
+	if (this->weatherUpdater == nullptr && this->weatherUpdateInterval.count() > 0) {
+		this->weatherUpdater = new thread::PeriodicAction(std::chrono::milliseconds(0), std::chrono::milliseconds(this->weatherUpdateInterval), std::bind(&Core::UpdateWeather, this));
+	}
+}
+
+void IASsure::Core::StopWeatherUpdater()
+{
+	if (this->weatherUpdater != nullptr) {
+		this->weatherUpdater->stop();
+		delete this->weatherUpdater;
+		this->weatherUpdater = nullptr;
+	}
+}
+
+void IASsure::Core::ResetWeatherUpdater()
+{
+	this->StopWeatherUpdater();
+	this->CheckLoginState();
+}
+
+void IASsure::Core::UpdateWeatherGridSettings(const WeatherGridSettings& settings)
+{
+	// waits for a previous rebuild to finish, so settings are always applied in order
+	if (this->weatherGridUpdate.valid()) {
+		this->weatherGridUpdate.wait();
+	}
+
+	this->weatherGridUpdate = std::async(std::launch::async, [this, settings]() {
+		this->weather.setGridSettings(settings);
+	});
+}
+
+void IASsure::Core::StartThreadPool()
+{
+	if (this->threadPool == nullptr && this->threadPoolWorkers > 0) {
+		this->threadPool = new thread::ThreadPool(this->threadPoolWorkers);
+		this->weather.setThreadPool(this->threadPool);
+		this->airDataPipeline.setThreadPool(this->threadPool);
+	}
+}
+
+void IASsure::Core::StopThreadPool()
+{
+	if (this->threadPool != nullptr) {
+		// waits for weather updates and pipeline batches still using the pool
+		this->weather.setThreadPool(nullptr);
+		this->airDataPipeline.setThreadPool(nullptr);
+
+		this->threadPool->stop();
+		delete this->threadPool;
+		this->threadPool = nullptr;
+	}
+}
+
+void IASsure::Core::ResetThreadPool()
+{
+	if (this->threadPool != nullptr && (int)this->threadPool->size() == this->threadPoolWorkers) {
+		return;
+	}
+
+	this->StopThreadPool();
+	this->StartThreadPool();
+}
+
+void IASsure::Core::LoadWeatherCache()
+{
+	try {
+		// the cache is deserialized straight from the file mapping provided by the host
+		bool found = this->host.readFile(WEATHER_CACHE_FILE_NAME, [this](std::string_view data) {
+			this->weather.deserialize(data);
+		});
+		if (!found) {
+			this->LogDebugMessage("No cached weather data found", "Weather");
+			return;
+		}
+	}
+	catch (std::exception const& ex) {
+		// corrupt or outdated cache files are ignored, they will be replaced after the next successful weather update
+		this->LogDebugMessage("Failed to load cached weather data, waiting for weather update", "Weather");
+		this->LogDebugMessage(ex.what(), "Weather");
+		return;
+	}
+
+	this->LogDebugMessage("Loaded cached weather data", "Weather");
+}
+
+void IASsure::Core::ReplaceWeather(std::string_view data)
+{
+	if (data.empty()) {
+		this->weather.clear();
+		return;
+	}
+
+	this->weather.deserialize(data);
+}
+
+void IASsure::Core::SaveWeatherCache()
+{
+	try {
+		this->host.writeFile(WEATHER_CACHE_FILE_NAME, this->weather.serialize());
+	}
+	catch (std::exception const& ex) {
+		this->LogDebugMessage("Failed to save weather data cache", "Weather");
+		this->LogDebugMessage(ex.what(), "Weather");
+		return;
+	}
+
+	this->LogDebugMessage("Saved weather data cache", "Weather");
+}
+
+void IASsure::Core::StartRecording()
+{
+	RecordingHeader header;
+	header.settings = this->FormatSettings();
+	try {
+		this->host.readFile(CONFIG_FILE_NAME, [&header](std::string_view data) {
+			header.config = std::string(data);
+		});
+	}
+	catch (std::exception const& ex) {
+		this->LogDebugMessage("Failed to read config file for recording", "Recording");
+		this->LogDebugMessage(ex.what(), "Recording");
+	}
+
+	this->recorder = new Recorder(this->host, this->weather, RECORDING_FILE_NAME, header);
+	// the current weather data is stored before any other input
+	this->recorder->recordWeather();
+
+	std::ostringstream msg;
+	msg << "Recording radar position updates, flight plan updates, commands and weather data to " << RECORDING_FILE_NAME << ". Use .ias record again to stop recording.";
+	this->LogMessage(msg.str(), "Recording");
+}
+
+void IASsure::Core::StopRecording()
+{
+	if (this->recorder == nullptr) {
+		return;
+	}
+
+	size_t records = this->recorder->records();
+	size_t dropped = this->recorder->dropped();
+	// waits for the writer to append the remaining records
+	delete this->recorder;
+	this->recorder = nullptr;
+
+	std::ostringstream msg;
+	msg << "Stopped recording, " << records << (records == 1 ? " input was" : " inputs were") << " recorded";
+	if (dropped > 0) {
+		msg << " (" << dropped << " dropped as the recording could not be written fast enough)";
+	}
+	this->LogMessage(msg.str(), "Recording");
+}
+
+void IASsure::Core::LoadSettings()
+{
+	std::optional<std::string> settings = this->host.loadSettings(PLUGIN_NAME);
+	if (settings.has_value()) {
+		std::vector<std::string> splitSettings = split(*settings, SETTINGS_DELIMITER);
+
+		size_t settingCount = splitSettings.size();
+		if (settingCount < 8) {
+			this->LogMessage("Invalid saved settings found, reverting to default.");
+
+			this->SaveSettings();
+			return;
+		}
+
+		std::istringstream(splitSettings[0]) >> this->debug;
+		int weatherUpdateMin;
+		std::istringstream(splitSettings[1]) >> weatherUpdateMin;
+		this->weatherUpdateInterval = std::chrono::minutes(weatherUpdateMin);
+		if (!splitSettings[2].empty()) {
+			this->weatherUpdateURL = splitSettings[2];
+		}
+		std::istringstream(splitSettings[3]) >> this->useReportedGS;
+		int machDigits;
+		std::istringstream(splitSettings[4]) >> machDigits;
+		if (machDigits < MIN_MACH_DIGITS || machDigits > MAX_MACH_DIGITS) {
+			std::ostringstream msg;
+			msg << "Invalid digit count for mach numbers. Must be between " << MIN_MACH_DIGITS << " and " << MAX_MACH_DIGITS << ", falling back to default (2)";
+			this->LogMessage(msg.str(), "Config");
+		}
+		else {
+			this->machDigits = machDigits;
+		}
+		if (splitSettings[5].size() > (size_t)(TAG_ITEM_MAX_CONTENT_LENGTH - this->machDigits)) {
+			std::ostringstream msg;
+			msg << "Indicated air speed prefix is too long, must be " << (TAG_ITEM_MAX_CONTENT_LENGTH - this->machDigits) << " characters or less. Falling back to default (I)";
+			this->LogMessage(msg.str(), "Config");
+		}
+		else {
+			this->prefixIAS = splitSettings[5];
+		}
+		if (splitSettings[6].size() > (size_t)(TAG_ITEM_MAX_CONTENT_LENGTH - this->machDigits)) {
+			std::ostringstream msg;
+			msg << "Mach number prefix is too long, must be " << (TAG_ITEM_MAX_CONTENT_LENGTH - this->machDigits) << " characters or less. Falling back to default (I)";
+			this->LogMessage(msg.str(), "Config");
+		}
+		else {
+			this->prefixIAS = splitSettings[6];
+		}
+		int machThresholdFL;
+		std::istringstream(splitSettings[7]) >> machThresholdFL;
+		if (machThresholdFL < 0) {
+			this->LogMessage("Invalid mach threshold flight level. Must be greater than 0, falling back to default (245)", "Config");
+		}
+		else {
+			this->machThresholdFL = machThresholdFL;
+		}
+
+		if (settingCount >= 9) {
+			std::istringstream(splitSettings[8]) >> this->useTrueNorthHeading;
+		}
+
+		if (settingCount >= 10) {
+			if (splitSettings[9].size() > (size_t)(TAG_ITEM_MAX_CONTENT_LENGTH)) {
+				std::ostringstream msg;
+				msg << "Unreliable IAS indicator is too long, must be " << TAG_ITEM_MAX_CONTENT_LENGTH << " characters or less. Falling back to default (DIAS)";
+				this->LogMessage(msg.str(), "Config");
+			}
+			else {
+				std::istringstream(splitSettings[9]) >> this->unreliableIASIndicator;
+			}
+		}
+
+		if (settingCount >= 11) {
+			if (splitSettings[10].size() > (size_t)(TAG_ITEM_MAX_CONTENT_LENGTH)) {
+				std::ostringstream msg;
+				msg << "Unreliable Mach number indicator is too long, must be " << TAG_ITEM_MAX_CONTENT_LENGTH << " characters or less. Falling back to default (DMACH)";
+				this->LogMessage(msg.str(), "Config");
+			}
+			else {
+				std::istringstream(splitSettings[10]) >> this->unreliableIASIndicator;
+			}
+		}
+
+		this->LogDebugMessage("Successfully loaded settings.", "Config");
+	}
+	else {
+		this->LogMessage("No saved settings found, using defaults.");
+	}
+}
+
+void IASsure::Core::SaveSettings()
+{
+	this->host.saveSettings(PLUGIN_NAME, "Settings", this->FormatSettings());
+}
+
+std::string IASsure::Core::FormatSettings()
+{
+	std::ostringstream ss;
+	ss << this->debug << SETTINGS_DELIMITER
+		<< this->weatherUpdateInterval.count() << SETTINGS_DELIMITER
+		<< this->weatherUpdateURL << SETTINGS_DELIMITER
+		<< this->useReportedGS << SETTINGS_DELIMITER
+		<< this->machDigits << SETTINGS_DELIMITER
+		<< this->prefixIAS << SETTINGS_DELIMITER
+		<< this->prefixMach << SETTINGS_DELIMITER
+		<< this->machThresholdFL << SETTINGS_DELIMITER
+		<< this->useTrueNorthHeading << SETTINGS_DELIMITER
+		<< this->unreliableIASIndicator << SETTINGS_DELIMITER
+		<< this->unreliableMachIndicator;
+
+	return ss.str();
+}
+
+void IASsure::Core::TryLoadConfigFile()
+{
+	this->LogDebugMessage("Attempting to load config file", "Config");
+
+	nlohmann::json cfg;
+	try {
+		bool found = this->host.readFile(CONFIG_FILE_NAME, [&cfg](std::string_view data) {
+			cfg = nlohmann::json::parse(data);
+		});
+		if (!found) {
+			this->LogDebugMessage("Failed to read config file, might not exist. Ignoring", "Config");
+			return;
+		}
+	}
+	catch (std::exception const&) {
+		this->LogMessage("Failed to read config file", "Config");
+		return;
+	}
+
+	try {
+		auto& machCfg = cfg.at("mach");
+
+		int machDigits = machCfg.value<int>("digits", this->machDigits);
+		if (machDigits < MIN_MACH_DIGITS || machDigits > MAX_MACH_DIGITS) {
+			this->LogMessage("Invalid digit count for mach numbers. Must be between 1 and 13, falling back to default (2)", "Config");
+		}
+		else {
+			this->machDigits = machDigits;
+		}
+		int machThresholdFL = machCfg.value<int>("thresholdFL", this->machThresholdFL);
+		if (machThresholdFL < 0) {
+			this->LogMessage("Invalid mach threshold flight level. Must be greater than 0, falling back to default (245)", "Config");
+		}
+		else {
+			this->machThresholdFL = machThresholdFL * 100;
+		}
+
+		std::string prefixMach = machCfg.value<std::string>("prefix", this->prefixMach);
+		if (prefixMach.size() > (size_t)(TAG_ITEM_MAX_CONTENT_LENGTH - this->machDigits)) {
+			std::ostringstream msg;
+			msg << "Mach number prefix is too long, must be " << (TAG_ITEM_MAX_CONTENT_LENGTH - this->machDigits) << " characters or less. Falling back to default (" << this->prefixMach << ")";
+			this->LogMessage(msg.str(), "Config");
+		}
+		else {
+			this->prefixMach = prefixMach;
+		}
+
+		std::string unreliableMachIndicator = machCfg.value<std::string>("unreliableIndicator", this->unreliableMachIndicator);
+		if (unreliableMachIndicator.size() > (size_t)(TAG_ITEM_MAX_CONTENT_LENGTH)) {
+			std::ostringstream msg;
+			msg << "Unreliable Mach number indicator is too long, must be " << TAG_ITEM_MAX_CONTENT_LENGTH << " characters or less. Falling back to default (" << this->unreliableMachIndicator << ")";
+			this->LogMessage(msg.str(), "Config");
+		}
+		else {
+			this->unreliableMachIndicator = unreliableMachIndicator;
+		}
+
+		std::string unreliableMachColor = machCfg.value<std::string>("unreliableColor", "");
+		if (unreliableMachColor.size() > 0) {
+			this->unreliableMachColor = parseRGBString(unreliableMachColor);
+			if (!this->unreliableMachColor.has_value()) {
+				this->LogMessage("Unreliable Mach number color is invalid, must be in comma-separated integer RGB format (e.g. \"123,123,123\"). Falling back to no color", "Config");
+			}
+		}
+	}
+	catch (std::exception const&) {
+		this->LogDebugMessage("Failed to parse mach section of config file, might not exist. Ignoring", "Config");
+	}
+
+	try {
+		auto& iasCfg = cfg.at("ias");
+
+		std::string prefixIAS = iasCfg.value<std::string>("prefix", this->prefixIAS);
+		if (prefixIAS.size() > (size_t)(TAG_ITEM_MAX_CONTENT_LENGTH - this->machDigits)) {
+			std::ostringstream msg;
+			msg << "Indicated air speed prefix is too long, must be " << (TAG_ITEM_MAX_CONTENT_LENGTH - this->machDigits) << " characters or less. Falling back to default (" << this->prefixIAS << ")";
+			this->LogMessage(msg.str(), "Config");
+		}
+		else {
+			this->prefixIAS = prefixIAS;
+		}
+
+		std::string unreliableIASIndicator = iasCfg.value<std::string>("unreliableIndicator", this->unreliableIASIndicator);
+		if (unreliableIASIndicator.size() > (size_t)(TAG_ITEM_MAX_CONTENT_LENGTH)) {
+			std::ostringstream msg;
+			msg << "Unreliable IAS indicator is too long, must be " << TAG_ITEM_MAX_CONTENT_LENGTH << " characters or less. Falling back to default (" << this->unreliableIASIndicator << ")";
+			this->LogMessage(msg.str(), "Config");
+		}
+		else {
+			this->unreliableIASIndicator = unreliableIASIndicator;
+		}
+
+		std::string unreliableIASColor = iasCfg.value<std::string>("unreliableColor", "");
+		if (unreliableIASColor.size() > 0) {
+			this->unreliableIASColor = parseRGBString(unreliableIASColor);
+			if (!this->unreliableIASColor.has_value()) {
+				this->LogMessage("Unreliable IAS color is invalid, must be in comma-separated (integer) RGB format (e.g. \"123,123,123\"). Falling back to no color", "Config");
+			}
+		}
+	}
+	catch (std::exception const&) {
+		this->LogDebugMessage("Failed to parse ias section of config file, might not exist. Ignoring", "Config");
+	}
+
+	try {
+		// deprecated prefix configuration in separate section
+		// TODO remove in next major release
+		auto& prefixCfg = cfg.at("prefix");
+		this->LogMessage("prefix config section is deprecated and will be removed in a future update. Use mach.prefix and ias.prefix to specify respective values.", "Config");
+
+		std::string prefixIAS = prefixCfg.value<std::string>("ias", this->prefixIAS);
+		if (prefixIAS.size() > (size_t)(TAG_ITEM_MAX_CONTENT_LENGTH - this->machDigits)) {
+			std::ostringstream msg;
+			msg << "Indicated air speed prefix is too long, must be " << (TAG_ITEM_MAX_CONTENT_LENGTH - this->machDigits) << " characters or less. Falling back to default (" << this->prefixIAS << ")";
+			this->LogMessage(msg.str(), "Config");
+		}
+		else {
+			this->prefixIAS = prefixIAS;
+		}
+		std::string prefixMach = prefixCfg.value<std::string>("mach", this->prefixMach);
+		if (prefixMach.size() > (size_t)(TAG_ITEM_MAX_CONTENT_LENGTH - this->machDigits)) {
+			std::ostringstream msg;
+			msg << "Mach number prefix is too long, must be " << (TAG_ITEM_MAX_CONTENT_LENGTH - this->machDigits) << " characters or less. Falling back to default (" << this->prefixMach << ")";
+			this->LogMessage(msg.str(), "Config");
+		}
+		else {
+			this->prefixMach = prefixMach;
+		}
+	}
+	catch (std::exception const&) {
+		this->LogDebugMessage("Failed to parse prefix section of config file, might not exist. Ignoring", "Config");
+	}
+
+	try {
+		auto& weatherCfg = cfg.at("weather");
+
+		this->weatherUpdateURL = weatherCfg.value<std::string>("url", this->weatherUpdateURL);
+		this->weatherUpdateInterval = std::chrono::minutes(weatherCfg.value<int>("update", this->weatherUpdateInterval.count()));
+
+		WeatherGridSettings gridSettings;
+		gridSettings.enabled = weatherCfg.value<bool>("grid", gridSettings.enabled);
+		gridSettings.spacing = weatherCfg.value<double>("gridSpacing", gridSettings.spacing);
+		gridSettings.levelSpacing = weatherCfg.value<int>("gridLevelSpacing", gridSettings.levelSpacing);
+		if (gridSettings.spacing <= 0 || gridSettings.levelSpacing <= 0) {
+			this->LogMessage("Invalid weather grid spacing. Must be greater than 0, disabling weather grid", "Config");
+			gridSettings.enabled = false;
+		}
+		this->weatherGrid = gridSettings.enabled;
+		this->UpdateWeatherGridSettings(gridSettings);
+
+		this->ResetWeatherUpdater();
+	}
+	catch (std::exception const&) {
+		this->LogDebugMessage("Failed to parse weather section of config file, might not exist. Ignoring", "Config");
+	}
+
+	try {
+		auto& aircraftCfg = cfg.at("aircraft");
+
+		int timeout = aircraftCfg.value<int>("timeout", (int)this->aircraftTimeout.count());
+		if (timeout < 0) {
+			this->LogMessage("Invalid aircraft state timeout. Must be 0 or greater, falling back to default (10)", "Config");
+		}
+		else {
+			this->aircraftTimeout = std::chrono::minutes(timeout);
+		}
+	}
+	catch (std::exception const&) {
+		this->LogDebugMessage("Failed to parse aircraft section of config file, might not exist. Ignoring", "Config");
+	}
+
+	try {
+		auto& threadsCfg = cfg.at("threads");
+
+		int workers = threadsCfg.value<int>("workers", this->threadPoolWorkers);
+		if (workers < 0 || workers > MAX_THREAD_POOL_WORKERS) {
+			this->LogMessage("Invalid number of worker threads. Must be between 0 and 64, falling back to default (2)", "Config");
+		}
+		else {
+			this->threadPoolWorkers = workers;
+		}
+	}
+	catch (std::exception const&) {
+		this->LogDebugMessage("Failed to parse threads section of config file, might not exist. Ignoring", "Config");
+	}
+
+	try {
+		auto& calculationsCfg = cfg.at("calculations");
+
+		std::string atmosphere = calculationsCfg.value<std::string>("atmosphere", this->atmosphereModel == AtmosphereModel::Exact ? "exact" : "table");
+		if (atmosphere == "exact") {
+			this->atmosphereModel = AtmosphereModel::Exact;
+		}
+		else if (atmosphere == "table") {
+			this->atmosphereModel = AtmosphereModel::Table;
+		}
+		else {
+			this->LogMessage("Invalid atmosphere model. Must be \"exact\" or \"table\", falling back to default (table)", "Config");
+		}
+		this->airDataPipeline.setModel(this->atmosphereModel);
+	}
+	catch (std::exception const&) {
+		this->LogDebugMessage("Failed to parse calculations section of config file, might not exist. Ignoring", "Config");
+	}
+
+	try {
+		auto& broadcastCfg = cfg.at("broadcast");
+
+		this->broadcastUnreliableSpeed = broadcastCfg.value<bool>("unreliableSpeed", this->broadcastUnreliableSpeed);
+	}
+	catch (std::exception const&) {
+		this->LogDebugMessage("Failed to parse broadcast section of config file, might not exist. Ignoring", "Config");
+	}
+
+	this->LogDebugMessage("Successfully loaded config file", "Config");
+}
+
+void IASsure::Core::LogMessage(std::string message)
+{
+	this->host.displayMessage("Message", PLUGIN_NAME, message);
+}
+
+void IASsure::Core::LogMessage(std::string message, std::string type)
+{
+	this->host.displayMessage(PLUGIN_NAME, type, message);
+}
+
+void IASsure::Core::LogDebugMessage(std::string message)
+{
+	if (this->debug) {
+		this->LogMessage(message);
+	}
+}
+
+void IASsure::Core::LogDebugMessage(std::string message, std::string type)
+{
+	if (this->debug) {
+		this->LogMessage(message, type);
+	}
+}
\ No newline at end of file
@@ -0,0 +1,206 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <future>
+#include <memory>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <nlohmann/json.hpp>
+
+#include "aircraft.h"
+#include "calculations.h"
+#include "constants.h"
+#include "format.h"
+#include "helpers.h"
+#include "host.h"
+#include "pipeline.h"
+#include "recorder.h"
+#include "thread.h"
+#include "weather.h"
+
+namespace IASsure {
+	// CachedTagItem stores the formatted content of a tag item, including the color set while formatting
+	class CachedTagItem {
+	public:
+		bool valid = false;
+		char content[16];
+		int colorCode;
+		host::Color rgb;
+	};
+
+	// TargetCache stores the air data and formatted tag items of a target along with the state they were calculated for. air data is
+	// taken from the background pipeline on a new radar position or weather data, tag items are additionally reformatted on changed
+	// reported speeds or toggles.
+	class TargetCache {
+	public:
+		// sequence number of the latest radar position update, unique across all targets and never reused after removing the state
+		uint64_t latestPosition = 0;
+		// pipeline results for positions below are outdated, captured before the state was created
+		uint64_t minimumPosition = 0;
+		// incremented on every change of reported speeds or toggles of the target
+		uint64_t stateChanges = 0;
+		// sequence number of the pipeline snapshot last checked for newer air data
+		uint64_t snapshotSequence = 0;
+		// reference point of the last weather lookup, speeding up lookups as aircraft only move slightly between updates
+		WeatherLookupHint weatherLookupHint;
+
+		// state the air data was calculated for
+		bool valid = false;
+		uint64_t position = 0;
+		uint64_t weatherGeneration = 0;
+		uint64_t settingsVersion = 0;
+		AirData data;
+
+		// state the tag items were formatted for, indexed by tag item code - 1
+		uint64_t tagItemState = 0;
+		std::array<CachedTagItem, TAG_ITEM_COUNT> tagItems;
+	};
+
+	// Aircraft combines the state of an aircraft with the cached data of its radar target
+	class Aircraft {
+	public:
+		AircraftState state;
+		TargetCache cache;
+		// time of the last radar position update, unset until the first update or eviction check
+		std::chrono::steady_clock::time_point lastPositionUpdate;
+	};
+
+	// Core implements the plugin independent of the radar client, which forwards its callbacks via an adapter (e.g. the EuroScope plugin).
+	// all callbacks have to be called from the same thread, the host has to outlive the core.
+	class Core {
+	public:
+		Core(host::Host& host);
+		~Core();
+
+		Core(const Core&) = delete;
+		Core& operator=(const Core&) = delete;
+
+		bool OnCompileCommand(const char* sCommandLine);
+		// OnGetTagItem writes the content of the tag item, the color is only changed if the tag item is displayed in a specific color
+		void OnGetTagItem(const host::RadarTarget& RadarTarget, int ItemCode, char sItemString[16], int* pColorCode, host::Color* pRGB);
+		// OnFunctionCall handles all tag item functions except for opening the reported speed menus, which are shown by the adapter
+		void OnFunctionCall(int FunctionId, const char* sItemString, host::FlightPlan& FlightPlan);
+		void OnFlightPlanScratchPadUpdate(const host::FlightPlan& FlightPlan);
+		// OnFlightPlanFlightStripReceived is called after the flight strip of the flight plan was pushed to the user
+		void OnFlightPlanFlightStripReceived(const host::FlightPlan& FlightPlan);
+		void OnRadarTargetPositionUpdate(const host::RadarTarget& RadarTarget);
+		void OnFlightPlanDisconnect(const host::FlightPlan& FlightPlan);
+		// OnTimer is called once per second
+		void OnTimer(int Counter);
+
+		// values preselected in the reported speed menus, matching the calculated speeds if available
+		int GetReportedIASSelection(const host::RadarTarget& rt);
+		int GetReportedMachSelection(const host::RadarTarget& rt);
+
+		// ReplaceWeather replaces the weather data with data stored by Weather::serialize (e.g. read from a recording), clearing it for
+		// empty data. throws std::invalid_argument for corrupt data
+		void ReplaceWeather(std::string_view data);
+
+	private:
+		host::Host& host;
+
+		bool debug;
+		std::chrono::minutes weatherUpdateInterval;
+		std::string weatherUpdateURL;
+		// whether weather lookups should use the interpolated weather grid instead of the closest reference point
+		bool weatherGrid;
+		bool useReportedGS;
+		bool useTrueNorthHeading;
+		std::string prefixIAS;
+		std::string prefixMach;
+		int machDigits;
+		int machThresholdFL;
+		std::string unreliableIASIndicator;
+		std::optional<host::Color> unreliableIASColor;
+		std::string unreliableMachIndicator;
+		std::optional<host::Color> unreliableMachColor;
+		bool broadcastUnreliableSpeed;
+
+		// reported speeds, toggles and cached tag items per callsign, a single lookup serves all tag items of a target
+		CallsignMap<Aircraft> aircraft;
+		// state of aircraft without radar position updates for this duration is removed, 0 keeps all state until reset
+		std::chrono::minutes aircraftTimeout;
+		// worker threads for splitting weather grid builds and air data batches, 0 keeps them on the weather updater and pipeline threads
+		int threadPoolWorkers;
+		thread::ThreadPool* threadPool;
+		// evaluation of ISA temperature and static pressure for all air data calculations, precomputed tables by default
+		AtmosphereModel atmosphereModel;
+
+		Weather weather;
+		// calculates air data of captured radar position updates in the background, tag items only read its latest snapshot
+		AirDataPipeline airDataPipeline;
+		std::shared_ptr<const AirDataSnapshot> airDataSnapshot;
+		// incremented on every radar position update of any target
+		uint64_t positionSequence;
+		// incremented on every command changing settings affecting calculations or tag items, passed along with captured inputs
+		uint64_t settingsVersion;
+		thread::PeriodicAction* weatherUpdater;
+		// rebuilds the weather grid in the background after changing its settings, keeping the grid build off the UI thread
+		std::future<void> weatherGridUpdate;
+		bool connected;
+		// records all inputs while enabled via .ias record, nullptr if not recording
+		Recorder* recorder;
+
+		void SetReportedIAS(const host::FlightPlan& fp, std::string selected);
+		void ClearReportedIAS(const host::FlightPlan& fp);
+		void ToggleCalculatedIAS(const host::FlightPlan& fp, bool abbreviated = false);
+		double CalculateIAS(const host::RadarTarget& rt);
+		void ShowCalculatedIAS(const Aircraft& ac, char tagItemContent[16], int* tagItemColorCode, host::Color* tagItemRGB, bool abbreviated = false, bool onlyToggled = false);
+
+		void SetReportedMach(const host::FlightPlan& fp, std::string selected);
+		void ClearReportedMach(const host::FlightPlan& fp);
+		void ToggleCalculatedMach(const host::FlightPlan& fp, bool aboveThreshold = false);
+		double CalculateMach(const host::RadarTarget& rt);
+		void ShowCalculatedMach(const host::RadarTarget& rt, const Aircraft& ac, char tagItemContent[16], int* tagItemColorCode, host::Color* tagItemRGB, bool aboveThreshold = false, bool onlyToggled = false);
+
+		// GetAircraft returns the aircraft of the radar target, updating its air data from the pipeline snapshot if outdated. air data is only
+		// calculated synchronously if no precomputed result is available, e.g. before the first position update or after changing settings
+		Aircraft& GetAircraft(const host::RadarTarget& rt);
+		AirDataInput GetAirDataInput(const host::RadarTarget& rt);
+		void CopyTagItem(const CachedTagItem& item, char tagItemContent[16], int* tagItemColorCode, host::Color* tagItemRGB);
+		void ShowCalculatedTAS(const Aircraft& ac, char tagItemContent[16]);
+		void ShowCalculatedWindComponent(const Aircraft& ac, char tagItemContent[16]);
+
+		void ToggleUnreliableSpeed(host::FlightPlan& fp);
+		void SetUnreliableSpeed(std::string_view callsign, bool unreliable);
+		void EvictSilentAircraft();
+
+		void BroadcastScratchPad(host::FlightPlan& fp, std::string msg);
+		void CheckScratchPadBroadcast(const host::FlightPlan& fp);
+
+		void SetFlightStripAnnotation(host::FlightPlan& fp, std::string msg, int index = BROADCAST_FLIGHT_STRIP_INDEX);
+		void CheckFlightStripAnnotations(const host::FlightPlan& fp);
+		void CheckFlightStripAnnotationsForAllAircraft();
+
+		void UpdateLoginState();
+		void CheckLoginState();
+		void UpdateWeather();
+		void StartWeatherUpdater();
+		void StopWeatherUpdater();
+		void ResetWeatherUpdater();
+		void LoadWeatherCache();
+		void UpdateWeatherGridSettings(const WeatherGridSettings& settings);
+		void StartThreadPool();
+		void StopThreadPool();
+		void ResetThreadPool();
+		void SaveWeatherCache();
+		void StartRecording();
+		void StopRecording();
+
+		void LoadSettings();
+		void SaveSettings();
+		std::string FormatSettings();
+		void TryLoadConfigFile();
+
+		void LogMessage(std::string message);
+		void LogMessage(std::string message, std::string type);
+		void LogDebugMessage(std::string message);
+		void LogDebugMessage(std::string message, std::string type);
+	};
+}
\ No newline at end of file
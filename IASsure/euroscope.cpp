@@ -0,0 +1,166 @@
+#include "euroscope.h"
+
+IASsure::euroscope::RadarTarget::RadarTarget(const EuroScopePlugIn::CRadarTarget& rt) :
+	rt(rt),
+	position(rt.GetPosition())
+{
+}
+
+std::string_view IASsure::euroscope::RadarTarget::callsign() const
+{
+	return this->rt.GetCallsign();
+}
+
+double IASsure::euroscope::RadarTarget::latitude() const
+{
+	return this->position.GetPosition().m_Latitude;
+}
+
+double IASsure::euroscope::RadarTarget::longitude() const
+{
+	return this->position.GetPosition().m_Longitude;
+}
+
+int IASsure::euroscope::RadarTarget::pressureAltitude() const
+{
+	return this->position.GetPressureAltitude();
+}
+
+int IASsure::euroscope::RadarTarget::flightLevel() const
+{
+	return this->position.GetFlightLevel();
+}
+
+int IASsure::euroscope::RadarTarget::reportedHeading() const
+{
+	return this->position.GetReportedHeading();
+}
+
+int IASsure::euroscope::RadarTarget::reportedHeadingTrueNorth() const
+{
+	return this->position.GetReportedHeadingTrueNorth();
+}
+
+int IASsure::euroscope::RadarTarget::reportedGS() const
+{
+	return this->position.GetReportedGS();
+}
+
+int IASsure::euroscope::RadarTarget::calculatedGS() const
+{
+	return this->rt.GetGS();
+}
+
+IASsure::euroscope::FlightPlan::FlightPlan(const EuroScopePlugIn::CFlightPlan& fp) :
+	fp(fp)
+{
+}
+
+std::string_view IASsure::euroscope::FlightPlan::callsign() const
+{
+	return this->fp.GetCallsign();
+}
+
+bool IASsure::euroscope::FlightPlan::isTrackedByMe() const
+{
+	return this->fp.GetTrackingControllerIsMe();
+}
+
+std::string IASsure::euroscope::FlightPlan::trackingControllerId() const
+{
+	return this->fp.GetTrackingControllerId();
+}
+
+std::string IASsure::euroscope::FlightPlan::scratchPad() const
+{
+	return this->fp.GetControllerAssignedData().GetScratchPadString();
+}
+
+bool IASsure::euroscope::FlightPlan::setScratchPad(const std::string& content)
+{
+	return this->fp.GetControllerAssignedData().SetScratchPadString(content.c_str());
+}
+
+std::string IASsure::euroscope::FlightPlan::flightStripAnnotation(int index) const
+{
+	return this->fp.GetControllerAssignedData().GetFlightStripAnnotation(index);
+}
+
+bool IASsure::euroscope::FlightPlan::setFlightStripAnnotation(int index, const std::string& content)
+{
+	return this->fp.GetControllerAssignedData().SetFlightStripAnnotation(index, content.c_str());
+}
+
+IASsure::euroscope::Host::Host(EuroScopePlugIn::CPlugIn& plugin) :
+	plugin(plugin)
+{
+}
+
+void IASsure::euroscope::Host::displayMessage(const std::string& handler, const std::string& sender, const std::string& message)
+{
+	this->plugin.DisplayUserMessage(handler.c_str(), sender.c_str(), message.c_str(), true, true, true, false, false);
+}
+
+std::optional<std::string> IASsure::euroscope::Host::loadSettings(const std::string& key)
+{
+	const char* settings = this->plugin.GetDataFromSettings(key.c_str());
+	if (settings == nullptr) {
+		return std::nullopt;
+	}
+
+	return settings;
+}
+
+void IASsure::euroscope::Host::saveSettings(const std::string& key, const std::string& description, const std::string& value)
+{
+	this->plugin.SaveDataToSettings(key.c_str(), description.c_str(), value.c_str());
+}
+
+void IASsure::euroscope::Host::forEachFlightPlan(const std::function<void(host::FlightPlan& fp)>& f)
+{
+	for (EuroScopePlugIn::CFlightPlan fp = this->plugin.FlightPlanSelectFirst(); fp.IsValid(); fp = this->plugin.FlightPlanSelectNext(fp)) {
+		FlightPlan flightPlan(fp);
+		f(flightPlan);
+	}
+}
+
+bool IASsure::euroscope::Host::isConnected()
+{
+	int connectionType = this->plugin.GetConnectionType();
+	return connectionType == EuroScopePlugIn::CONNECTION_TYPE_DIRECT || connectionType == EuroScopePlugIn::CONNECTION_TYPE_VIA_PROXY;
+}
+
+std::string IASsure::euroscope::Host::download(const std::string& url)
+{
+	return HTTP::get(url);
+}
+
+bool IASsure::euroscope::Host::readFile(const std::string& name, const std::function<void(std::string_view data)>& f)
+{
+	std::filesystem::path path(getPluginDirectory());
+	path.append(name);
+
+	if (!std::filesystem::exists(path)) {
+		return false;
+	}
+
+	file::MappedFile file(path.string());
+	f(file.data());
+	return true;
+}
+
+void IASsure::euroscope::Host::writeFile(const std::string& name, std::string_view data)
+{
+	std::filesystem::path path(getPluginDirectory());
+	path.append(name);
+
+	file::writeAtomically(path.string(), data);
+}
+
+void IASsure::euroscope::Host::appendFile(const std::string& name, std::string_view data)
+{
+	std::filesystem::path path(getPluginDirectory());
+	path.append(name);
+
+	file::append(path.string(), data);
+}
\ No newline at end of file
@@ -0,0 +1,86 @@
+#pragma once
+
+#include <filesystem>
+#include <functional>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <windows.h>
+
+#include "EuroScope/EuroScopePlugIn.h"
+
+#include "file.h"
+#include "host.h"
+#include "http.h"
+
+namespace IASsure {
+	// euroscope adapts the EuroScope plugin API to the host interfaces used by the core
+	namespace euroscope {
+		class RadarTarget : public host::RadarTarget {
+		public:
+			RadarTarget(const EuroScopePlugIn::CRadarTarget& rt);
+
+			std::string_view callsign() const override;
+			double latitude() const override;
+			double longitude() const override;
+			int pressureAltitude() const override;
+			int flightLevel() const override;
+			int reportedHeading() const override;
+			int reportedHeadingTrueNorth() const override;
+			int reportedGS() const override;
+			int calculatedGS() const override;
+		private:
+			EuroScopePlugIn::CRadarTarget rt;
+			EuroScopePlugIn::CRadarTargetPositionData position;
+		};
+
+		class FlightPlan : public host::FlightPlan {
+		public:
+			FlightPlan(const EuroScopePlugIn::CFlightPlan& fp);
+
+			std::string_view callsign() const override;
+			bool isTrackedByMe() const override;
+			std::string trackingControllerId() const override;
+
+			std::string scratchPad() const override;
+			bool setScratchPad(const std::string& content) override;
+			std::string flightStripAnnotation(int index) const override;
+			bool setFlightStripAnnotation(int index, const std::string& content) override;
+		private:
+			EuroScopePlugIn::CFlightPlan fp;
+		};
+
+		class Host : public host::Host {
+		public:
+			Host(EuroScopePlugIn::CPlugIn& plugin);
+
+			void displayMessage(const std::string& handler, const std::string& sender, const std::string& message) override;
+
+			std::optional<std::string> loadSettings(const std::string& key) override;
+			void saveSettings(const std::string& key, const std::string& description, const std::string& value) override;
+
+			void forEachFlightPlan(const std::function<void(host::FlightPlan& fp)>& f) override;
+			bool isConnected() override;
+
+			std::string download(const std::string& url) override;
+
+			bool readFile(const std::string& name, const std::function<void(std::string_view data)>& f) override;
+			void writeFile(const std::string& name, std::string_view data) override;
+			void appendFile(const std::string& name, std::string_view data) override;
+		private:
+			EuroScopePlugIn::CPlugIn& plugin;
+		};
+
+		extern "C" IMAGE_DOS_HEADER __ImageBase;
+
+		inline std::string getPluginDirectory()
+		{
+			char buf[MAX_PATH] = { 0 };
+			GetModuleFileName(HINSTANCE(&__ImageBase), buf, MAX_PATH);
+
+			std::string::size_type pos = std::string(buf).find_last_of("\\/");
+
+			return std::string(buf).substr(0, pos);
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,251 @@
+#include "fakehost.h"
+
+#include <stdexcept>
+
+IASsure::host::FakeRadarTarget::FakeRadarTarget(const RadarTargetData& data) :
+	data(data)
+{
+}
+
+IASsure::host::FakeRadarTarget::FakeRadarTarget(std::string callsign, double latitude, double longitude, int altitude, int heading, int groundSpeed)
+{
+	this->data.callsign = callsign;
+	this->data.latitude = latitude;
+	this->data.longitude = longitude;
+	this->data.pressureAltitude = altitude;
+	this->data.flightLevel = altitude;
+	this->data.reportedHeading = heading;
+	this->data.reportedHeadingTrueNorth = heading;
+	this->data.reportedGS = groundSpeed;
+	this->data.calculatedGS = groundSpeed;
+}
+
+std::string_view IASsure::host::FakeRadarTarget::callsign() const
+{
+	return this->data.callsign;
+}
+
+double IASsure::host::FakeRadarTarget::latitude() const
+{
+	return this->data.latitude;
+}
+
+double IASsure::host::FakeRadarTarget::longitude() const
+{
+	return this->data.longitude;
+}
+
+int IASsure::host::FakeRadarTarget::pressureAltitude() const
+{
+	return this->data.pressureAltitude;
+}
+
+int IASsure::host::FakeRadarTarget::flightLevel() const
+{
+	return this->data.flightLevel;
+}
+
+int IASsure::host::FakeRadarTarget::reportedHeading() const
+{
+	return this->data.reportedHeading;
+}
+
+int IASsure::host::FakeRadarTarget::reportedHeadingTrueNorth() const
+{
+	return this->data.reportedHeadingTrueNorth;
+}
+
+int IASsure::host::FakeRadarTarget::reportedGS() const
+{
+	return this->data.reportedGS;
+}
+
+int IASsure::host::FakeRadarTarget::calculatedGS() const
+{
+	return this->data.calculatedGS;
+}
+
+IASsure::host::FakeFlightPlan::FakeFlightPlan(const FlightPlanData& data) :
+	data(data)
+{
+}
+
+IASsure::host::FakeFlightPlan::FakeFlightPlan(std::string callsign)
+{
+	this->data.callsign = callsign;
+}
+
+std::string_view IASsure::host::FakeFlightPlan::callsign() const
+{
+	return this->data.callsign;
+}
+
+bool IASsure::host::FakeFlightPlan::isTrackedByMe() const
+{
+	return this->data.trackedByMe;
+}
+
+std::string IASsure::host::FakeFlightPlan::trackingControllerId() const
+{
+	return this->data.trackingControllerId;
+}
+
+std::string IASsure::host::FakeFlightPlan::scratchPad() const
+{
+	return this->data.scratchPad;
+}
+
+bool IASsure::host::FakeFlightPlan::setScratchPad(const std::string& content)
+{
+	this->data.scratchPad = content;
+	this->scratchPadHistory.push_back(content);
+	return true;
+}
+
+std::string IASsure::host::FakeFlightPlan::flightStripAnnotation(int index) const
+{
+	if (index < 0 || index >= FLIGHT_STRIP_ANNOTATION_COUNT) {
+		return "";
+	}
+
+	return this->data.flightStripAnnotations[index];
+}
+
+bool IASsure::host::FakeFlightPlan::setFlightStripAnnotation(int index, const std::string& content)
+{
+	if (index < 0 || index >= FLIGHT_STRIP_ANNOTATION_COUNT) {
+		return false;
+	}
+
+	this->data.flightStripAnnotations[index] = content;
+	return true;
+}
+
+void IASsure::host::FakeHost::displayMessage(const std::string& handler, const std::string& sender, const std::string& message)
+{
+	std::lock_guard<std::mutex> lock(this->mutex);
+	this->messageLog.push_back(FakeMessage{ handler, sender, message });
+}
+
+std::optional<std::string> IASsure::host::FakeHost::loadSettings(const std::string& key)
+{
+	std::lock_guard<std::mutex> lock(this->mutex);
+	auto it = this->settings.find(key);
+	if (it == this->settings.end()) {
+		return std::nullopt;
+	}
+
+	return it->second;
+}
+
+void IASsure::host::FakeHost::saveSettings(const std::string& key, const std::string&, const std::string& value)
+{
+	std::lock_guard<std::mutex> lock(this->mutex);
+	this->settings[key] = value;
+}
+
+void IASsure::host::FakeHost::forEachFlightPlan(const std::function<void(FlightPlan& fp)>& f)
+{
+	for (auto& [callsign, fp] : this->flightPlans) {
+		f(fp);
+	}
+}
+
+bool IASsure::host::FakeHost::isConnected()
+{
+	return this->connected.load();
+}
+
+std::string IASsure::host::FakeHost::download(const std::string& url)
+{
+	std::lock_guard<std::mutex> lock(this->mutex);
+	this->downloadCount++;
+
+	auto it = this->responses.find(url);
+	if (it == this->responses.end()) {
+		throw std::runtime_error("No response set for " + url);
+	}
+
+	return it->second;
+}
+
+bool IASsure::host::FakeHost::readFile(const std::string& name, const std::function<void(std::string_view data)>& f)
+{
+	// the content is copied so f can call back into the host without holding the lock
+	std::optional<std::string> data = this->file(name);
+	if (!data.has_value()) {
+		return false;
+	}
+
+	f(*data);
+	return true;
+}
+
+std::optional<std::string> IASsure::host::FakeHost::file(const std::string& name) const
+{
+	std::lock_guard<std::mutex> lock(this->mutex);
+	auto it = this->files.find(name);
+	if (it == this->files.end()) {
+		return std::nullopt;
+	}
+
+	return it->second;
+}
+
+void IASsure::host::FakeHost::writeFile(const std::string& name, std::string_view data)
+{
+	std::lock_guard<std::mutex> lock(this->mutex);
+	this->files[name] = std::string(data);
+}
+
+void IASsure::host::FakeHost::appendFile(const std::string& name, std::string_view data)
+{
+	std::lock_guard<std::mutex> lock(this->mutex);
+	this->files[name].append(data);
+}
+
+IASsure::host::FakeFlightPlan& IASsure::host::FakeHost::addFlightPlan(const FakeFlightPlan& fp)
+{
+	FakeFlightPlan& stored = this->flightPlans[fp.data.callsign];
+	stored = fp;
+	return stored;
+}
+
+IASsure::host::FakeFlightPlan* IASsure::host::FakeHost::findFlightPlan(std::string_view callsign)
+{
+	auto it = this->flightPlans.find(callsign);
+	if (it == this->flightPlans.end()) {
+		return nullptr;
+	}
+
+	return &it->second;
+}
+
+void IASsure::host::FakeHost::setConnected(bool connected)
+{
+	this->connected.store(connected);
+}
+
+void IASsure::host::FakeHost::setDownload(const std::string& url, const std::string& response)
+{
+	std::lock_guard<std::mutex> lock(this->mutex);
+	this->responses[url] = response;
+}
+
+size_t IASsure::host::FakeHost::downloads() const
+{
+	std::lock_guard<std::mutex> lock(this->mutex);
+	return this->downloadCount;
+}
+
+std::vector<IASsure::host::FakeMessage> IASsure::host::FakeHost::messages() const
+{
+	std::lock_guard<std::mutex> lock(this->mutex);
+	return this->messageLog;
+}
+
+void IASsure::host::FakeHost::clearMessages()
+{
+	std::lock_guard<std::mutex> lock(this->mutex);
+	this->messageLog.clear();
+}
\ No newline at end of file
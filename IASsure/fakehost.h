@@ -0,0 +1,108 @@
+#pragma once
+
+#include <atomic>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "host.h"
+
+namespace IASsure {
+	namespace host {
+		// FakeRadarTarget provides radar positions stored in memory, e.g. for tests or replaying recorded traffic
+		class FakeRadarTarget : public RadarTarget {
+		public:
+			RadarTargetData data;
+
+			FakeRadarTarget() = default;
+			FakeRadarTarget(const RadarTargetData& data);
+			// creates a target with matching altitudes, headings and ground speeds
+			FakeRadarTarget(std::string callsign, double latitude, double longitude, int altitude, int heading, int groundSpeed);
+
+			std::string_view callsign() const override;
+			double latitude() const override;
+			double longitude() const override;
+			int pressureAltitude() const override;
+			int flightLevel() const override;
+			int reportedHeading() const override;
+			int reportedHeadingTrueNorth() const override;
+			int reportedGS() const override;
+			int calculatedGS() const override;
+		};
+
+		// FakeFlightPlan provides a flight plan stored in memory, accepting all changes
+		class FakeFlightPlan : public FlightPlan {
+		public:
+			FlightPlanData data;
+			// all values set as scratch pad, including values replaced immediately (e.g. broadcasts)
+			std::vector<std::string> scratchPadHistory;
+
+			FakeFlightPlan() = default;
+			FakeFlightPlan(const FlightPlanData& data);
+			FakeFlightPlan(std::string callsign);
+
+			std::string_view callsign() const override;
+			bool isTrackedByMe() const override;
+			std::string trackingControllerId() const override;
+
+			std::string scratchPad() const override;
+			bool setScratchPad(const std::string& content) override;
+			std::string flightStripAnnotation(int index) const override;
+			bool setFlightStripAnnotation(int index, const std::string& content) override;
+		};
+
+		// FakeMessage stores a message displayed via FakeHost::displayMessage
+		class FakeMessage {
+		public:
+			std::string handler;
+			std::string sender;
+			std::string message;
+		};
+
+		// FakeHost keeps settings, files and messages in memory and serves downloads from a fixed set of responses. all functions
+		// are thread-safe, flight plans are only accessed from the thread calling the core.
+		class FakeHost : public Host {
+		public:
+			void displayMessage(const std::string& handler, const std::string& sender, const std::string& message) override;
+
+			std::optional<std::string> loadSettings(const std::string& key) override;
+			void saveSettings(const std::string& key, const std::string& description, const std::string& value) override;
+
+			void forEachFlightPlan(const std::function<void(FlightPlan& fp)>& f) override;
+			bool isConnected() override;
+
+			// download returns the response set for the URL, throwing std::runtime_error for unknown URLs
+			std::string download(const std::string& url) override;
+
+			bool readFile(const std::string& name, const std::function<void(std::string_view data)>& f) override;
+			void writeFile(const std::string& name, std::string_view data) override;
+			void appendFile(const std::string& name, std::string_view data) override;
+
+			// addFlightPlan adds or replaces the flight plan of the callsign, returning the stored flight plan
+			FakeFlightPlan& addFlightPlan(const FakeFlightPlan& fp);
+			FakeFlightPlan* findFlightPlan(std::string_view callsign);
+			// file returns a copy of the stored file, std::nullopt if it does not exist
+			std::optional<std::string> file(const std::string& name) const;
+			void setConnected(bool connected);
+			void setDownload(const std::string& url, const std::string& response);
+			size_t downloads() const;
+
+			std::vector<FakeMessage> messages() const;
+			void clearMessages();
+		private:
+			mutable std::mutex mutex;
+			std::map<std::string, std::string> settings;
+			std::map<std::string, std::string> files;
+			std::map<std::string, std::string> responses;
+			std::vector<FakeMessage> messageLog;
+			size_t downloadCount = 0;
+			std::atomic<bool> connected = false;
+
+			std::map<std::string, FakeFlightPlan, std::less<>> flightPlans;
+		};
+	}
+}
\ No newline at end of file
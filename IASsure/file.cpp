@@ -0,0 +1,156 @@
+#include "file.h"
+
+#include <sstream>
+#include <stdexcept>
+
+IASsure::file::MappedFile::MappedFile(const std::string& path) : file(INVALID_HANDLE_VALUE), mapping(nullptr), view(nullptr), size(0)
+{
+	this->file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+	if (this->file == INVALID_HANDLE_VALUE) {
+		throwLastError("CreateFileA");
+	}
+
+	// destructor is not called if the constructor throws, release all handles acquired so far before throwing
+	LARGE_INTEGER fileSize;
+	if (!GetFileSizeEx(this->file, &fileSize)) {
+		DWORD errorCode = GetLastError();
+		this->close();
+		throwError("GetFileSizeEx", errorCode);
+	}
+
+	this->size = (size_t)fileSize.QuadPart;
+	if (this->size == 0) {
+		// empty files cannot be mapped, data will be empty
+		return;
+	}
+
+	this->mapping = CreateFileMappingA(this->file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	if (this->mapping == nullptr) {
+		DWORD errorCode = GetLastError();
+		this->close();
+		throwError("CreateFileMappingA", errorCode);
+	}
+
+	this->view = static_cast<const char*>(MapViewOfFile(this->mapping, FILE_MAP_READ, 0, 0, 0));
+	if (this->view == nullptr) {
+		DWORD errorCode = GetLastError();
+		this->close();
+		throwError("MapViewOfFile", errorCode);
+	}
+}
+
+IASsure::file::MappedFile::~MappedFile()
+{
+	this->close();
+}
+
+std::string_view IASsure::file::MappedFile::data() const
+{
+	if (this->view == nullptr) {
+		return std::string_view();
+	}
+
+	return std::string_view(this->view, this->size);
+}
+
+void IASsure::file::MappedFile::close()
+{
+	if (this->view != nullptr) {
+		UnmapViewOfFile(this->view);
+		this->view = nullptr;
+	}
+	if (this->mapping != nullptr) {
+		CloseHandle(this->mapping);
+		this->mapping = nullptr;
+	}
+	if (this->file != INVALID_HANDLE_VALUE) {
+		CloseHandle(this->file);
+		this->file = INVALID_HANDLE_VALUE;
+	}
+}
+
+void IASsure::file::writeAtomically(const std::string& path, std::string_view data)
+{
+	std::string tmpPath = path + ".tmp";
+
+	HANDLE file = CreateFileA(tmpPath.c_str(), GENERIC_WRITE, 0, nullptr, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+	if (file == INVALID_HANDLE_VALUE) {
+		throwLastError("CreateFileA");
+	}
+
+	while (!data.empty()) {
+		DWORD chunk = data.size() > MAXDWORD ? MAXDWORD : (DWORD)data.size();
+		DWORD written = 0;
+		if (!WriteFile(file, data.data(), chunk, &written, nullptr)) {
+			DWORD errorCode = GetLastError();
+			CloseHandle(file);
+			DeleteFileA(tmpPath.c_str());
+			throwError("WriteFile", errorCode);
+		}
+
+		data.remove_prefix(written);
+	}
+
+	if (!FlushFileBuffers(file)) {
+		DWORD errorCode = GetLastError();
+		CloseHandle(file);
+		DeleteFileA(tmpPath.c_str());
+		throwError("FlushFileBuffers", errorCode);
+	}
+	CloseHandle(file);
+
+	if (!MoveFileExA(tmpPath.c_str(), path.c_str(), MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH)) {
+		DWORD errorCode = GetLastError();
+		DeleteFileA(tmpPath.c_str());
+		throwError("MoveFileExA", errorCode);
+	}
+}
+
+void IASsure::file::append(const std::string& path, std::string_view data)
+{
+	HANDLE file = CreateFileA(path.c_str(), FILE_APPEND_DATA, FILE_SHARE_READ, nullptr, OPEN_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+	if (file == INVALID_HANDLE_VALUE) {
+		throwLastError("CreateFileA");
+	}
+
+	while (!data.empty()) {
+		DWORD chunk = data.size() > MAXDWORD ? MAXDWORD : (DWORD)data.size();
+		DWORD written = 0;
+		if (!WriteFile(file, data.data(), chunk, &written, nullptr)) {
+			DWORD errorCode = GetLastError();
+			CloseHandle(file);
+			throwError("WriteFile", errorCode);
+		}
+
+		data.remove_prefix(written);
+	}
+
+	CloseHandle(file);
+}
+
+[[noreturn]] void IASsure::file::throwLastError(const std::string& functionName)
+{
+	throwError(functionName, GetLastError());
+}
+
+[[noreturn]] void IASsure::file::throwError(const std::string& functionName, DWORD errorCode)
+{
+	LPSTR errorText = nullptr;
+
+	std::ostringstream msg;
+	msg << "Call";
+	if (!functionName.empty()) {
+		msg << " to " << functionName;
+	}
+	msg << " failed with error code " << errorCode;
+
+	DWORD formatResult = FormatMessageA(
+		FORMAT_MESSAGE_ALLOCATE_BUFFER | FORMAT_MESSAGE_FROM_SYSTEM | FORMAT_MESSAGE_IGNORE_INSERTS,
+		nullptr, errorCode, MAKELANGID(LANG_NEUTRAL, SUBLANG_DEFAULT), (LPSTR)&errorText, 0, nullptr);
+	if (formatResult && errorText != nullptr) {
+		msg << ": " << errorText;
+		LocalFree(errorText);
+	}
+
+	throw std::runtime_error(msg.str());
+}
\ No newline at end of file
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <windows.h>
+
+namespace IASsure {
+	namespace file {
+		// MappedFile maps a file into memory (read-only) for the lifetime of the object
+		class MappedFile {
+		public:
+			MappedFile(const std::string& path);
+			~MappedFile();
+
+			MappedFile(const MappedFile&) = delete;
+			MappedFile& operator=(const MappedFile&) = delete;
+
+			std::string_view data() const;
+		private:
+			HANDLE file;
+			HANDLE mapping;
+			const char* view;
+			size_t size;
+
+			void close();
+		};
+
+		// writeAtomically writes the data to a temporary file before replacing the target, so the target is never left partially written
+		void writeAtomically(const std::string& path, std::string_view data);
+		// append writes the data to the end of the file, creating it if it does not exist
+		void append(const std::string& path, std::string_view data);
+
+		[[noreturn]] void throwLastError(const std::string& functionName);
+		[[noreturn]] void throwError(const std::string& functionName, DWORD errorCode);
+	}
+}
\ No newline at end of file
@@ -0,0 +1,133 @@
+#include "format.h"
+
+IASsure::format::TagItemWriter::TagItemWriter(char* buffer, size_t size) : buffer(buffer), size(size), pos(0)
+{
+	if (this->size > 0) {
+		this->buffer[0] = '\0';
+	}
+}
+
+IASsure::format::TagItemWriter& IASsure::format::TagItemWriter::text(std::string_view text)
+{
+	for (char c : text) {
+		this->character(c);
+	}
+
+	return *this;
+}
+
+IASsure::format::TagItemWriter& IASsure::format::TagItemWriter::character(char c)
+{
+	// last byte is reserved for the null terminator
+	if (this->pos + 1 < this->size) {
+		this->buffer[this->pos++] = c;
+		this->buffer[this->pos] = '\0';
+	}
+
+	return *this;
+}
+
+IASsure::format::TagItemWriter& IASsure::format::TagItemWriter::sign(double value)
+{
+	if (value > 0) {
+		this->character('+');
+	}
+	else if (value < 0) {
+		this->character('-');
+	}
+
+	return *this;
+}
+
+IASsure::format::TagItemWriter& IASsure::format::TagItemWriter::number(double value, int width)
+{
+	if (!std::isfinite(value)) {
+		return *this;
+	}
+
+	double rounded = std::round(value);
+	if (rounded < 0) {
+		this->character('-');
+		rounded = -rounded;
+	}
+
+	// 20 digits fit any unsigned 64 bit integer, larger values are not displayable in a tag anyways
+	char digits[20];
+	auto [end, ec] = std::to_chars(digits, digits + sizeof(digits), (unsigned long long)rounded);
+	if (ec != std::errc()) {
+		return *this;
+	}
+
+	for (int i = (int)(end - digits); i < width; i++) {
+		this->character('0');
+	}
+
+	return this->text(std::string_view(digits, end - digits));
+}
+
+size_t IASsure::format::TagItemWriter::length() const
+{
+	return this->pos;
+}
+
+void IASsure::format::formatIAS(char* buffer, size_t size, std::string_view prefix, double cas, std::optional<double> reported, bool abbreviated)
+{
+	TagItemWriter writer(buffer, size);
+	if (!abbreviated) {
+		writer.text(prefix);
+	}
+
+	if (!reported.has_value()) {
+		if (abbreviated) {
+			writer.number(cas / 10.0, 2);
+		}
+		else {
+			writer.number(cas, 3);
+		}
+		return;
+	}
+
+	double diff = *reported - cas;
+	writer.sign(diff);
+	if (abbreviated) {
+		writer.number(std::abs(diff / 10.0), 2);
+	}
+	else {
+		writer.number(std::abs(diff), 3);
+	}
+}
+
+void IASsure::format::formatMach(char* buffer, size_t size, std::string_view prefix, double mach, std::optional<double> reported, int digits)
+{
+	TagItemWriter writer(buffer, size);
+	writer.text(prefix);
+
+	double factor = std::pow(10, digits);
+	if (!reported.has_value()) {
+		writer.number(mach * factor, digits);
+		return;
+	}
+
+	double diff = *reported - mach;
+	writer.sign(diff);
+	writer.number(std::abs(diff * factor), digits);
+}
+
+void IASsure::format::formatTAS(char* buffer, size_t size, double tas)
+{
+	TagItemWriter(buffer, size).number(tas, 3);
+}
+
+void IASsure::format::formatWindComponent(char* buffer, size_t size, double windComponent)
+{
+	double wind = std::round(windComponent);
+
+	TagItemWriter writer(buffer, size);
+	if (wind > 0) {
+		writer.character('H');
+	}
+	else if (wind < 0) {
+		writer.character('T');
+	}
+	writer.number(std::abs(wind), 2);
+}
\ No newline at end of file
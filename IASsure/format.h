@@ -0,0 +1,38 @@
+#pragma once
+
+#include <charconv>
+#include <cmath>
+#include <cstddef>
+#include <optional>
+#include <string_view>
+
+namespace IASsure {
+	namespace format {
+		// TagItemWriter appends text and numbers to a fixed size tag item buffer without allocating or accessing the locale. content
+		// exceeding the buffer is truncated, the buffer is always kept null terminated.
+		class TagItemWriter {
+		public:
+			TagItemWriter(char* buffer, size_t size);
+
+			TagItemWriter& text(std::string_view text);
+			TagItemWriter& character(char c);
+			// sign writes '+' for positive and '-' for negative values, nothing for zero
+			TagItemWriter& sign(double value);
+			// number writes the value rounded to the nearest integer (as std::round), padded with leading zeros to at least width digits.
+			// negative values are prefixed with '-' before the padding, non-finite values are skipped
+			TagItemWriter& number(double value, int width);
+
+			size_t length() const;
+		private:
+			char* buffer;
+			size_t size;
+			size_t pos;
+		};
+
+		// the format functions write the content of the respective tag items, displaying the difference to the reported value if available
+		void formatIAS(char* buffer, size_t size, std::string_view prefix, double cas, std::optional<double> reported, bool abbreviated);
+		void formatMach(char* buffer, size_t size, std::string_view prefix, double mach, std::optional<double> reported, int digits);
+		void formatTAS(char* buffer, size_t size, double tas);
+		void formatWindComponent(char* buffer, size_t size, double windComponent);
+	}
+}
\ No newline at end of file
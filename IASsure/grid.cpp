@@ -0,0 +1,253 @@
+#include "grid.h"
+
+#include <algorithm>
+#include <cmath>
+#include <numbers>
+#include <stdexcept>
+
+#include "haversine.h"
+#include "weather.h"
+
+namespace {
+	class GridValue {
+	public:
+		double temperature;
+		double windU;
+		double windV;
+	};
+
+	// winds are interpolated as u/v components, avoiding artifacts when interpolating directions around north
+	GridValue toGridValue(const IASsure::WeatherReferenceLevel& level)
+	{
+		double direction = IASsure::degToRad(level.windDirection);
+		return { level.temperature, level.windSpeed * std::sin(direction), level.windSpeed * std::cos(direction) };
+	}
+
+	GridValue lerp(const GridValue& a, const GridValue& b, double t)
+	{
+		return {
+			a.temperature + (b.temperature - a.temperature) * t,
+			a.windU + (b.windU - a.windU) * t,
+			a.windV + (b.windV - a.windV) * t,
+		};
+	}
+
+	// interpolates the value of a reference point at the given flight level, clamping to the lowest/highest level available
+	GridValue interpolateLevel(const std::vector<int>& flightLevels, const std::vector<IASsure::WeatherReferenceLevel>& levels, double fl)
+	{
+		auto upper = std::lower_bound(flightLevels.begin(), flightLevels.end(), fl);
+		if (upper == flightLevels.begin()) {
+			return toGridValue(levels.front());
+		}
+		if (upper == flightLevels.end()) {
+			return toGridValue(levels.back());
+		}
+
+		size_t i = upper - flightLevels.begin();
+		double t = (fl - flightLevels[i - 1]) / (flightLevels[i] - flightLevels[i - 1]);
+		return lerp(toGridValue(levels[i - 1]), toGridValue(levels[i]), t);
+	}
+
+	// fractional grid index of value, clamped to the grid
+	double gridIndex(double value, double min, double spacing, size_t count, size_t& lower, size_t& upper)
+	{
+		double index = std::clamp((value - min) / spacing, 0.0, (double)(count - 1));
+		lower = (size_t)index;
+		upper = (std::min)(lower + 1, count - 1);
+
+		return index - lower;
+	}
+
+	// smallestLongitudeArc finds the shortest arc (eastwards from min) containing all longitudes, which crosses the antimeridian for
+	// data covering e.g. the Pacific. returns the span of the arc in degrees, min is normalised to [-180, 180)
+	double smallestLongitudeArc(std::vector<double> longitudes, double& min)
+	{
+		for (double& longitude : longitudes) {
+			longitude -= 360 * std::floor((longitude + 180) / 360);
+		}
+		std::sort(longitudes.begin(), longitudes.end());
+
+		// the arc starts after the largest gap between neighbouring longitudes, including the gap across the antimeridian
+		min = longitudes.front();
+		double largestGap = longitudes.front() + 360 - longitudes.back();
+		for (size_t i = 1; i < longitudes.size(); i++) {
+			double gap = longitudes[i] - longitudes[i - 1];
+			if (gap > largestGap) {
+				largestGap = gap;
+				min = longitudes[i];
+			}
+		}
+
+		return 360 - largestGap;
+	}
+}
+
+IASsure::WeatherGrid::WeatherGrid(const std::vector<WeatherReferencePoint>& points, const SpatialIndex& index, const WeatherGridSettings& settings, thread::ThreadPool* pool) :
+	minLatitude(0),
+	minLongitude(0),
+	spacing(settings.spacing),
+	rows(0),
+	columns(0),
+	lowestFlightLevel(0),
+	levelSpacing(settings.levelSpacing),
+	levels(0)
+{
+	if (!(settings.spacing > 0) || settings.levelSpacing <= 0) {
+		throw std::domain_error("invalid weather grid spacing");
+	}
+
+	double maxLatitude = 0;
+	int highestFlightLevel = 0;
+	std::vector<double> longitudes;
+	for (auto const& point : points) {
+		if (point.levels.empty()) {
+			continue;
+		}
+
+		if (longitudes.empty()) {
+			this->minLatitude = maxLatitude = point.latitude;
+			this->lowestFlightLevel = point.flightLevels.front();
+			highestFlightLevel = point.flightLevels.back();
+		}
+
+		this->minLatitude = (std::min)(this->minLatitude, point.latitude);
+		maxLatitude = (std::max)(maxLatitude, point.latitude);
+		longitudes.push_back(point.longitude);
+		this->lowestFlightLevel = (std::min)(this->lowestFlightLevel, point.flightLevels.front());
+		highestFlightLevel = (std::max)(highestFlightLevel, point.flightLevels.back());
+	}
+
+	if (longitudes.empty()) {
+		throw std::domain_error("no weather data available for grid");
+	}
+
+	// columns east of 180 degrees continue across the antimeridian, lookups are mapped onto them in interpolate
+	double longitudeSpan = smallestLongitudeArc(std::move(longitudes), this->minLongitude);
+
+	// align flight levels to the level spacing (rounding towards negative infinity) and extend the grid to cover all data
+	this->lowestFlightLevel -= ((this->lowestFlightLevel % this->levelSpacing) + this->levelSpacing) % this->levelSpacing;
+	double rowCount = std::ceil((maxLatitude - this->minLatitude) / this->spacing) + 1;
+	double columnCount = std::ceil(longitudeSpan / this->spacing) + 1;
+	double levelCount = std::ceil((double)(highestFlightLevel - this->lowestFlightLevel) / this->levelSpacing) + 1;
+	if (rowCount * columnCount * levelCount > MAX_GRID_CELLS) {
+		throw std::out_of_range("weather grid exceeds maximum number of cells");
+	}
+
+	this->rows = (size_t)rowCount;
+	this->columns = (size_t)columnCount;
+	this->levels = (size_t)levelCount;
+
+	// vertical profiles of all reference points at the grid's flight levels
+	std::vector<GridValue> profiles(points.size() * this->levels);
+	for (size_t p = 0; p < points.size(); p++) {
+		if (points[p].levels.empty()) {
+			continue;
+		}
+
+		for (size_t l = 0; l < this->levels; l++) {
+			double fl = this->lowestFlightLevel + (double)l * this->levelSpacing;
+			profiles[p * this->levels + l] = interpolateLevel(points[p].flightLevels, points[p].levels, fl);
+		}
+	}
+
+	size_t cells = this->rows * this->columns * this->levels;
+	this->temperature.resize(cells);
+	this->windU.resize(cells);
+	this->windV.resize(cells);
+
+	// rows only write their own cells, allowing them to be interpolated independently
+	auto interpolateRows = [&](size_t begin, size_t end) {
+		std::vector<std::pair<size_t, double>> weights;
+		for (size_t r = begin; r < end; r++) {
+			for (size_t c = 0; c < this->columns; c++) {
+				double latitude = this->minLatitude + r * this->spacing;
+				double longitude = this->minLongitude + c * this->spacing;
+
+				weights.clear();
+				double totalWeight = 0;
+				for (size_t p : index.findNearest(latitude, longitude, GRID_INTERPOLATION_POINTS)) {
+					if (points[p].levels.empty()) {
+						continue;
+					}
+
+					double distance = IASsure::haversine(latitude, longitude, points[p].latitude, points[p].longitude);
+					if (distance < 1) {
+						// grid node located at reference point, use its values unchanged
+						weights.clear();
+						weights.push_back({ p, 1 });
+						totalWeight = 1;
+						break;
+					}
+
+					double weight = 1 / (distance * distance);
+					weights.push_back({ p, weight });
+					totalWeight += weight;
+				}
+
+				for (size_t l = 0; l < this->levels; l++) {
+					GridValue value = { 0, 0, 0 };
+					for (auto const& [p, weight] : weights) {
+						const GridValue& profile = profiles[p * this->levels + l];
+						value.temperature += profile.temperature * weight / totalWeight;
+						value.windU += profile.windU * weight / totalWeight;
+						value.windV += profile.windV * weight / totalWeight;
+					}
+
+					size_t i = (r * this->columns + c) * this->levels + l;
+					this->temperature[i] = (float)value.temperature;
+					this->windU[i] = (float)value.windU;
+					this->windV[i] = (float)value.windV;
+				}
+			}
+		}
+		};
+
+	if (pool != nullptr) {
+		pool->parallelFor(this->rows, 1, interpolateRows);
+	}
+	else {
+		interpolateRows(0, this->rows);
+	}
+}
+
+IASsure::WeatherReferenceLevel IASsure::WeatherGrid::interpolate(double latitude, double longitude, int altitude) const
+{
+	// map the longitude to the side of the antimeridian closer to the grid's center before clamping it to the grid
+	double center = this->minLongitude + (this->columns - 1) * this->spacing / 2;
+	longitude = center + std::remainder(longitude - center, 360.0);
+
+	size_t r0, r1, c0, c1, l0, l1;
+	double tr = gridIndex(latitude, this->minLatitude, this->spacing, this->rows, r0, r1);
+	double tc = gridIndex(longitude, this->minLongitude, this->spacing, this->columns, c0, c1);
+	double tl = gridIndex(altitude / 100.0, this->lowestFlightLevel, this->levelSpacing, this->levels, l0, l1);
+
+	auto trilinear = [&](const std::vector<float>& values) {
+		auto at = [&](size_t r, size_t c, size_t l) {
+			return (double)values[(r * this->columns + c) * this->levels + l];
+		};
+		auto bilinear = [&](size_t l) {
+			double lower = at(r0, c0, l) + (at(r0, c1, l) - at(r0, c0, l)) * tc;
+			double upper = at(r1, c0, l) + (at(r1, c1, l) - at(r1, c0, l)) * tc;
+			return lower + (upper - lower) * tr;
+		};
+
+		double lower = bilinear(l0);
+		return lower + (bilinear(l1) - lower) * tl;
+	};
+
+	double u = trilinear(this->windU);
+	double v = trilinear(this->windV);
+	double direction = std::atan2(u, v) * 180 / std::numbers::pi;
+
+	IASsure::WeatherReferenceLevel level;
+	level.temperature = trilinear(this->temperature);
+	level.windSpeed = std::hypot(u, v);
+	level.windDirection = direction < 0 ? direction + 360 : direction;
+
+	return level;
+}
+
+size_t IASsure::WeatherGrid::size() const
+{
+	return this->temperature.size();
+}
\ No newline at end of file
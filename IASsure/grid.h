@@ -0,0 +1,53 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include "spatial.h"
+#include "thread.h"
+
+namespace IASsure {
+	constexpr size_t MAX_GRID_CELLS = 4000000;
+	// number of closest reference points used for interpolating the values of each grid column
+	constexpr size_t GRID_INTERPOLATION_POINTS = 4;
+
+	class WeatherReferenceLevel;
+	class WeatherReferencePoint;
+
+	class WeatherGridSettings {
+	public:
+		bool enabled = false;
+		double spacing = 0.25; // in degrees
+		int levelSpacing = 10; // in flight levels
+
+		bool operator==(const WeatherGridSettings& other) const = default;
+	};
+
+	// WeatherGrid resamples the weather reference points onto a regular latitude/longitude/flight level lattice covering the
+	// area of all reference points. Grid values are interpolated horizontally from the closest reference points (inverse
+	// distance weighting) and vertically between the levels of each reference point, winds as u/v components.
+	// Lookups use trilinear interpolation between the surrounding grid cells, so values change smoothly along a flight path.
+	// The grid covers the shortest longitude arc containing all reference points, continuing across the antimeridian if required.
+	class WeatherGrid {
+	public:
+		// rows of the grid are interpolated in parallel if a thread pool is given
+		WeatherGrid(const std::vector<WeatherReferencePoint>& points, const SpatialIndex& index, const WeatherGridSettings& settings, thread::ThreadPool* pool = nullptr);
+
+		WeatherReferenceLevel interpolate(double latitude, double longitude, int altitude) const;
+		size_t size() const;
+	private:
+		double minLatitude;
+		double minLongitude; // in [-180, 180), the grid extends past 180 for data crossing the antimeridian
+		double spacing;
+		size_t rows;
+		size_t columns;
+		int lowestFlightLevel;
+		int levelSpacing;
+		size_t levels;
+
+		// grid values, index ((row * columns) + column) * levels + level
+		std::vector<float> temperature;
+		std::vector<float> windU;
+		std::vector<float> windV;
+	};
+}
\ No newline at end of file
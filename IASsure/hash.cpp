@@ -0,0 +1,111 @@
+#include "hash.h"
+
+#include <cstring>
+
+namespace {
+	constexpr uint64_t PRIME64_1 = 0x9E3779B185EBCA87ULL;
+	constexpr uint64_t PRIME64_2 = 0xC2B2AE3D27D4EB4FULL;
+	constexpr uint64_t PRIME64_3 = 0x165667B19E3779F9ULL;
+	constexpr uint64_t PRIME64_4 = 0x85EBCA77C2B2AE63ULL;
+	constexpr uint64_t PRIME64_5 = 0x27D4EB2F165667C5ULL;
+
+	inline uint64_t rotl(uint64_t x, int r)
+	{
+		return (x << r) | (x >> (64 - r));
+	}
+
+	// data is read in little endian byte order, matching the reference implementation on all supported platforms
+	inline uint64_t read64(const unsigned char* p)
+	{
+		uint64_t v;
+		std::memcpy(&v, p, sizeof(v));
+		return v;
+	}
+
+	inline uint32_t read32(const unsigned char* p)
+	{
+		uint32_t v;
+		std::memcpy(&v, p, sizeof(v));
+		return v;
+	}
+
+	inline uint64_t round(uint64_t acc, uint64_t input)
+	{
+		acc += input * PRIME64_2;
+		acc = rotl(acc, 31);
+		return acc * PRIME64_1;
+	}
+
+	inline uint64_t mergeRound(uint64_t acc, uint64_t val)
+	{
+		acc ^= round(0, val);
+		return acc * PRIME64_1 + PRIME64_4;
+	}
+}
+
+uint64_t IASsure::xxh64(const void* data, size_t length, uint64_t seed)
+{
+	const unsigned char* p = static_cast<const unsigned char*>(data);
+	const unsigned char* const end = p + length;
+	uint64_t h;
+
+	if (length >= 32) {
+		// process input in stripes of 32 bytes using four independent accumulators
+		const unsigned char* const limit = end - 32;
+		uint64_t v1 = seed + PRIME64_1 + PRIME64_2;
+		uint64_t v2 = seed + PRIME64_2;
+		uint64_t v3 = seed;
+		uint64_t v4 = seed - PRIME64_1;
+
+		do {
+			v1 = round(v1, read64(p));
+			v2 = round(v2, read64(p + 8));
+			v3 = round(v3, read64(p + 16));
+			v4 = round(v4, read64(p + 24));
+			p += 32;
+		} while (p <= limit);
+
+		h = rotl(v1, 1) + rotl(v2, 7) + rotl(v3, 12) + rotl(v4, 18);
+		h = mergeRound(h, v1);
+		h = mergeRound(h, v2);
+		h = mergeRound(h, v3);
+		h = mergeRound(h, v4);
+	}
+	else {
+		h = seed + PRIME64_5;
+	}
+
+	h += (uint64_t)length;
+
+	while (p + 8 <= end) {
+		h ^= round(0, read64(p));
+		h = rotl(h, 27) * PRIME64_1 + PRIME64_4;
+		p += 8;
+	}
+
+	if (p + 4 <= end) {
+		h ^= (uint64_t)read32(p) * PRIME64_1;
+		h = rotl(h, 23) * PRIME64_2 + PRIME64_3;
+		p += 4;
+	}
+
+	while (p < end) {
+		h ^= (*p) * PRIME64_5;
+		h = rotl(h, 11) * PRIME64_1;
+		p++;
+	}
+
+	// final avalanche
+	h ^= h >> 33;
+	h *= PRIME64_2;
+	h ^= h >> 29;
+	h *= PRIME64_3;
+	h ^= h >> 32;
+
+	return h;
+}
+
+uint64_t IASsure::xxh64(std::string_view data, uint64_t seed)
+{
+	return xxh64(data.data(), data.size(), seed);
+}
\ No newline at end of file
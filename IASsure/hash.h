@@ -0,0 +1,11 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+namespace IASsure {
+	// xxh64 calculates the 64 bit xxHash of the given data, a fast non-cryptographic hash used for detecting changes in raw data
+	uint64_t xxh64(const void* data, size_t length, uint64_t seed = 0);
+	uint64_t xxh64(std::string_view data, uint64_t seed = 0);
+}
\ No newline at end of file
@@ -1,5 +1,7 @@
 #include "haversine.h"
 
+#include <cmath>
+
 double IASsure::haversine(const double lat1, const double long1, const double lat2, const double long2)
 {
     // Taken from http://www.movable-type.co.uk/scripts/latlong.html @ 2022-11-04T20:40:00Z
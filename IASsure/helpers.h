@@ -2,11 +2,13 @@
 
 #include <algorithm>
 #include <cmath>
+#include <optional>
 #include <stdexcept>
 #include <string>
 #include <sstream>
 #include <vector>
-#include <Windows.h>
+
+#include "host.h"
 
 namespace IASsure {
 	inline std::vector<std::string> split(const std::string& s, char delim = ' ')
@@ -55,23 +57,11 @@ namespace IASsure {
 		return roundToNearest(std::lround(num), multiple);
 	}
 
-	extern "C" IMAGE_DOS_HEADER __ImageBase;
-
-	inline std::string getPluginDirectory()
-	{
-		char buf[MAX_PATH] = { 0 };
-		GetModuleFileName(HINSTANCE(&__ImageBase), buf, MAX_PATH);
-
-		std::string::size_type pos = std::string(buf).find_last_of("\\/");
-
-		return std::string(buf).substr(0, pos);
-	}
-
-	inline COLORREF* parseRGBString(const std::string& s)
+	inline std::optional<host::Color> parseRGBString(const std::string& s)
 	{
 		std::vector<std::string> rgbValues = split(s, ',');
 		if (rgbValues.size() != 3) {
-			return nullptr;
+			return std::nullopt;
 		}
 
 		trim(rgbValues[0]);
@@ -85,14 +75,14 @@ namespace IASsure {
 			b = std::stoi(rgbValues[2]);
 		}
 		catch (std::exception) {
-			return nullptr;
+			return std::nullopt;
 		}
 
 		if (r < 0 || r > 255 || g < 0 || g > 255 || b < 0 || b > 255) {
-			return nullptr;
+			return std::nullopt;
 		}
 
-		return new COLORREF(RGB(r, g, b));
+		return host::rgb((uint8_t)r, (uint8_t)g, (uint8_t)b);
 	}
 
 	inline std::string toLowercase(std::string str) {
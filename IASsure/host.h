@@ -0,0 +1,112 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <string>
+#include <string_view>
+
+namespace IASsure {
+	// host abstracts the radar client running the plugin (EuroScope), allowing the core to be run and tested without it
+	namespace host {
+		// Color stores an RGB color in the layout of the Windows COLORREF type (0x00BBGGRR)
+		typedef uint32_t Color;
+
+		constexpr Color rgb(uint8_t r, uint8_t g, uint8_t b)
+		{
+			return (Color)r | ((Color)g << 8) | ((Color)b << 16);
+		}
+
+		// tag item color codes, matching EuroScope's TAG_COLOR_* values
+		constexpr int TAG_COLOR_DEFAULT = 0;
+		constexpr int TAG_COLOR_RGB_DEFINED = 1;
+		// number of flight strip annotations stored per flight plan, matching EuroScope
+		constexpr int FLIGHT_STRIP_ANNOTATION_COUNT = 9;
+
+		// RadarTarget provides the latest radar position of an aircraft. only valid targets are passed to the core.
+		class RadarTarget {
+		public:
+			virtual ~RadarTarget() = default;
+
+			virtual std::string_view callsign() const = 0;
+			virtual double latitude() const = 0; // in deg
+			virtual double longitude() const = 0; // in deg
+			virtual int pressureAltitude() const = 0; // in ft
+			virtual int flightLevel() const = 0; // in ft
+			virtual int reportedHeading() const = 0; // magnetic, in deg
+			virtual int reportedHeadingTrueNorth() const = 0; // in deg
+			virtual int reportedGS() const = 0; // reported by the pilot client, in kn
+			virtual int calculatedGS() const = 0; // estimated by the host from previous positions, in kn
+		};
+
+		// FlightPlan provides the controller assigned data of an aircraft. only valid flight plans are passed to the core.
+		class FlightPlan {
+		public:
+			virtual ~FlightPlan() = default;
+
+			virtual std::string_view callsign() const = 0;
+			virtual bool isTrackedByMe() const = 0;
+			// callsign of the tracking controller, empty if untracked
+			virtual std::string trackingControllerId() const = 0;
+
+			// setters return false if the host rejected the change (e.g. tracked by another controller)
+			virtual std::string scratchPad() const = 0;
+			virtual bool setScratchPad(const std::string& content) = 0;
+			virtual std::string flightStripAnnotation(int index) const = 0;
+			virtual bool setFlightStripAnnotation(int index, const std::string& content) = 0;
+		};
+
+		// RadarTargetData stores the radar position of a target as returned by RadarTarget
+		class RadarTargetData {
+		public:
+			std::string callsign;
+			double latitude = 0; // in deg
+			double longitude = 0; // in deg
+			int pressureAltitude = 0; // in ft
+			int flightLevel = 0; // in ft
+			int reportedHeading = 0; // in deg
+			int reportedHeadingTrueNorth = 0; // in deg
+			int reportedGS = 0; // in kn
+			int calculatedGS = 0; // in kn
+		};
+
+		// FlightPlanData stores the controller assigned data of a flight plan as returned by FlightPlan
+		class FlightPlanData {
+		public:
+			std::string callsign;
+			bool trackedByMe = false;
+			std::string trackingControllerId;
+			std::string scratchPad;
+			std::array<std::string, FLIGHT_STRIP_ANNOTATION_COUNT> flightStripAnnotations;
+		};
+
+		// Host provides access to the messaging, settings, network and storage of the radar client. all functions may be called from
+		// background threads (e.g. the weather updater), except for forEachFlightPlan.
+		class Host {
+		public:
+			virtual ~Host() = default;
+
+			// displayMessage shows a message in the given message handler (chat tab), attributed to the sender
+			virtual void displayMessage(const std::string& handler, const std::string& sender, const std::string& message) = 0;
+
+			// settings are persisted by the host between sessions, loadSettings returns std::nullopt if nothing was saved yet
+			virtual std::optional<std::string> loadSettings(const std::string& key) = 0;
+			virtual void saveSettings(const std::string& key, const std::string& description, const std::string& value) = 0;
+
+			virtual void forEachFlightPlan(const std::function<void(FlightPlan& fp)>& f) = 0;
+			// isConnected returns true if connected to the network using a connection receiving live traffic (e.g. no sweatbox or playback)
+			virtual bool isConnected() = 0;
+
+			// download retrieves the content of the URL, throwing on failure
+			virtual std::string download(const std::string& url) = 0;
+
+			// files are stored alongside the plugin, all functions throw on failure. readFile passes the content to f without copying
+			// it (the view is only valid during the call) and returns false if the file does not exist. writeFile never leaves a
+			// partially written file behind, appendFile creates the file if it does not exist
+			virtual bool readFile(const std::string& name, const std::function<void(std::string_view data)>& f) = 0;
+			virtual void writeFile(const std::string& name, std::string_view data) = 0;
+			virtual void appendFile(const std::string& name, std::string_view data) = 0;
+		};
+	}
+}
\ No newline at end of file
@@ -0,0 +1,104 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <numbers>
+
+#include "calculations.h"
+
+namespace IASsure {
+	namespace isa {
+		constexpr double TABLE_MIN_ALTITUDE = -2000; // in ft
+		constexpr double TABLE_STEP = 10; // in ft
+		// number of table entries, covering all altitudes up to the upper limit of the model
+		constexpr size_t TABLE_SIZE = (size_t)((ALTITUDE_HIGH_UPPER_LIMIT_FEET - TABLE_MIN_ALTITUDE) / TABLE_STEP) + 2;
+
+		// exp, log and pow usable in constant expressions as the standard library functions are not constexpr before C++26.
+		// accurate to a few ulp for the arguments of the barometric formula, not intended for general use.
+		constexpr double log(double x)
+		{
+			// log(x) = e * ln(2) + log(m) with m in [sqrt(2) / 2, sqrt(2)]
+			int e = 0;
+			while (x > std::numbers::sqrt2) {
+				x /= 2;
+				e++;
+			}
+			while (x < std::numbers::sqrt2 / 2) {
+				x *= 2;
+				e--;
+			}
+
+			// log(m) = 2 * atanh(s) with s = (m - 1) / (m + 1), |s| <= 0.172
+			double s = (x - 1) / (x + 1);
+			double s2 = s * s;
+			double term = s;
+			double sum = 0;
+			for (int k = 1; k <= 29; k += 2) {
+				sum += term / k;
+				term *= s2;
+			}
+
+			return 2 * sum + e * std::numbers::ln2;
+		}
+
+		constexpr double exp(double x)
+		{
+			// exp(x) = 2^n * exp(r) with |r| <= ln(2) / 2
+			int n = (int)(x / std::numbers::ln2 + (x < 0 ? -0.5 : 0.5));
+			double r = x - n * std::numbers::ln2;
+
+			double term = 1;
+			double sum = 1;
+			for (int k = 1; k <= 20; k++) {
+				term *= r / k;
+				sum += term;
+			}
+
+			for (; n > 0; n--) {
+				sum *= 2;
+			}
+			for (; n < 0; n++) {
+				sum /= 2;
+			}
+
+			return sum;
+		}
+
+		constexpr double pow(double x, double y)
+		{
+			return exp(y * log(x));
+		}
+
+		// Table stores ISA temperature and static pressure (as returned by calculateTemperature and calculateStaticPressure) for altitudes
+		// TABLE_MIN_ALTITUDE + i * TABLE_STEP
+		class Table {
+		public:
+			std::array<double, TABLE_SIZE> temperature;
+			std::array<double, TABLE_SIZE> pressure;
+		};
+
+		constexpr Table buildTable()
+		{
+			// matches the closed form of calculateTemperature and calculateStaticPressure
+			constexpr double beta = GRAVITATIONAL_ACCELERATION_SEA_LEVEL / (SPECIFIC_GAS_CONSTANT_DRY_AIR * TEMPERATURE_LAPSE_RATE_LOW);
+			constexpr double hs = (SPECIFIC_GAS_CONSTANT_DRY_AIR * STANDARD_TEMPERATURE_HIGH) / GRAVITATIONAL_ACCELERATION_SEA_LEVEL;
+
+			Table table{};
+			for (size_t i = 0; i < TABLE_SIZE; i++) {
+				double alt = TABLE_MIN_ALTITUDE + i * TABLE_STEP;
+				double altM = alt * METER_PER_FEET;
+
+				if (alt < ALTITUDE_LOW_UPPER_LIMIT_FEET) {
+					table.temperature[i] = STANDARD_TEMPERATURE_LOW + TEMPERATURE_LAPSE_RATE_LOW * altM;
+					table.pressure[i] = STATIC_PRESSURE_LOW * pow(1 + ((TEMPERATURE_LAPSE_RATE_LOW * altM) / STANDARD_TEMPERATURE_LOW), -1 * beta);
+				}
+				else {
+					table.temperature[i] = STANDARD_TEMPERATURE_HIGH + TEMPERATURE_LAPSE_RATE_HIGH * (altM - ALTITUDE_LOW_UPPER_LIMIT);
+					table.pressure[i] = STATIC_PRESSURE_HIGH * exp(-1 * ((altM - ALTITUDE_LOW_UPPER_LIMIT) / hs));
+				}
+			}
+
+			return table;
+		}
+	}
+}
\ No newline at end of file
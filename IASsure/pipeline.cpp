@@ -0,0 +1,264 @@
+#include "pipeline.h"
+
+IASsure::AirDataPipeline::AirDataPipeline(const Weather& weather, AtmosphereModel model) :
+	weather(weather),
+	model(model),
+	published(std::make_shared<const AirDataSnapshot>()),
+	publishedSequence(0),
+	flushRequested(0),
+	flushCompleted(0),
+	shouldStop(false),
+	pool(nullptr),
+	weatherGeneration(0),
+	t(&IASsure::AirDataPipeline::threadFn, this)
+{
+}
+
+IASsure::AirDataPipeline::~AirDataPipeline()
+{
+	{
+		std::scoped_lock<std::mutex> lock(this->m);
+		this->shouldStop = true;
+	}
+	this->c.notify_one();
+	this->flushed.notify_all();
+	this->t.join();
+}
+
+const IASsure::AirDataResult* IASsure::AirDataSnapshot::find(std::string_view callsign) const
+{
+	uint64_t hash = hashCallsign(callsign);
+	const std::shared_ptr<const AirDataChunk>& chunk = this->chunks[chunkIndex(hash)];
+	if (chunk == nullptr) {
+		return nullptr;
+	}
+
+	return chunk->find(callsign, hash);
+}
+
+size_t IASsure::AirDataSnapshot::size() const
+{
+	size_t size = 0;
+	for (const std::shared_ptr<const AirDataChunk>& chunk : this->chunks) {
+		if (chunk != nullptr) {
+			size += chunk->size();
+		}
+	}
+
+	return size;
+}
+
+void IASsure::AirDataPipeline::capture(std::string_view callsign, uint64_t position, const AirDataInput& input, uint64_t settingsVersion)
+{
+	this->enqueue(Capture{ Operation::Capture, std::string(callsign), position, settingsVersion, input });
+}
+
+void IASsure::AirDataPipeline::remove(std::string_view callsign)
+{
+	this->enqueue(Capture{ Operation::Remove, std::string(callsign), 0, 0, AirDataInput{} });
+}
+
+void IASsure::AirDataPipeline::clear()
+{
+	this->enqueue(Capture{ Operation::Clear, std::string(), 0, 0, AirDataInput{} });
+}
+
+void IASsure::AirDataPipeline::flush()
+{
+	std::unique_lock<std::mutex> lock(this->m);
+	uint64_t request = ++this->flushRequested;
+	this->c.notify_one();
+	this->flushed.wait(lock, [&]() { return this->shouldStop || this->flushCompleted >= request; });
+}
+
+std::shared_ptr<const IASsure::AirDataSnapshot> IASsure::AirDataPipeline::snapshot() const
+{
+	return this->published.load();
+}
+
+uint64_t IASsure::AirDataPipeline::sequence() const
+{
+	return this->publishedSequence.load();
+}
+
+void IASsure::AirDataPipeline::setThreadPool(thread::ThreadPool* pool)
+{
+	// waits for a batch still using the previous pool
+	std::scoped_lock<std::mutex> lock(this->poolMutex);
+	this->pool = pool;
+}
+
+void IASsure::AirDataPipeline::setModel(AtmosphereModel model)
+{
+	this->model.store(model);
+}
+
+void IASsure::AirDataPipeline::enqueue(Capture capture)
+{
+	bool first;
+	{
+		std::scoped_lock<std::mutex> lock(this->m);
+		first = this->captures.empty();
+		this->captures.push_back(std::move(capture));
+	}
+
+	// the worker is only woken for the first capture of a batch, it collects the following ones itself
+	if (first) {
+		this->c.notify_one();
+	}
+}
+
+IASsure::AirDataChunk& IASsure::AirDataPipeline::chunk(std::string_view callsign)
+{
+	size_t index = AirDataSnapshot::chunkIndex(hashCallsign(callsign));
+	this->changedChunks.set(index);
+	return this->results[index];
+}
+
+void IASsure::AirDataPipeline::process(std::vector<Capture>& batch)
+{
+	for (Capture& capture : batch) {
+		switch (capture.operation) {
+		case Operation::Capture:
+		{
+			// only the latest input of a target is calculated if it was captured multiple times within the batch
+			Target& target = this->targets.get(capture.callsign);
+			target.position = capture.position;
+			target.settingsVersion = capture.settingsVersion;
+			target.input = capture.input;
+			target.outdated = true;
+			break;
+		}
+		case Operation::Remove:
+			if (this->targets.erase(capture.callsign)) {
+				this->chunk(capture.callsign).erase(capture.callsign);
+			}
+			break;
+		case Operation::Clear:
+			this->targets.clear();
+			for (AirDataChunk& chunk : this->results) {
+				chunk.clear();
+			}
+			this->changedChunks.set();
+			break;
+		}
+	}
+
+	// results of all targets are outdated once new weather data is available
+	uint64_t generation = this->weather.generation();
+	bool weatherChanged = generation != this->weatherGeneration;
+	this->weatherGeneration = generation;
+
+	// insert all results first, inserting may move the results referenced by the work list
+	this->targets.forEach([&](std::string_view callsign, Target& target) {
+		if (target.outdated || weatherChanged) {
+			this->chunk(callsign).get(callsign);
+		}
+		});
+
+	this->work.clear();
+	this->targets.forEach([&](std::string_view callsign, Target& target) {
+		if (target.outdated || weatherChanged) {
+			this->work.push_back({ &target, this->results[AirDataSnapshot::chunkIndex(hashCallsign(callsign))].find(callsign) });
+			target.outdated = false;
+		}
+		});
+
+	// targets only access their own hint and result, allowing them to be calculated independently
+	AtmosphereModel model = this->model.load();
+	auto calculate = [this, generation, model](size_t begin, size_t end) {
+		for (size_t i = begin; i < end; i++) {
+			Target& target = *this->work[i].first;
+			WeatherReferenceLevel level = this->weather.findClosest(target.input.latitude, target.input.longitude, target.input.altitude, target.hint);
+
+			AirDataResult& result = *this->work[i].second;
+			result.position = target.position;
+			result.weatherGeneration = generation;
+			result.settingsVersion = target.settingsVersion;
+			result.data = ::IASsure::calculateAirData(target.input.altitude, target.input.heading, target.input.groundSpeed, level, model);
+		}
+		};
+
+	if (this->pool != nullptr) {
+		this->pool->parallelFor(this->work.size(), AIR_DATA_PIPELINE_GRAIN_SIZE, calculate);
+	}
+	else {
+		calculate(0, this->work.size());
+	}
+
+	if (this->changedChunks.any()) {
+		this->publish();
+	}
+}
+
+void IASsure::AirDataPipeline::publish()
+{
+	std::shared_ptr<const AirDataSnapshot> previous = this->published.load();
+
+	auto snapshot = std::make_shared<AirDataSnapshot>();
+	snapshot->sequence = previous->sequence + 1;
+	for (size_t i = 0; i < AIR_DATA_SNAPSHOT_CHUNKS; i++) {
+		if (!this->changedChunks.test(i)) {
+			snapshot->chunks[i] = previous->chunks[i];
+		}
+		else if (this->results[i].size() > 0) {
+			snapshot->chunks[i] = std::make_shared<const AirDataChunk>(this->results[i]);
+		}
+	}
+	this->changedChunks.reset();
+
+	uint64_t sequence = snapshot->sequence;
+	this->published.store(std::move(snapshot));
+	this->publishedSequence.store(sequence);
+
+	// readers might still hold the previous snapshot, it is released by the worker once they moved on to a newer one
+	this->retired.push_back(std::move(previous));
+}
+
+void IASsure::AirDataPipeline::release()
+{
+	// the worker holds the only reference once use_count drops to 1, retired snapshots can no longer be acquired by readers
+	std::erase_if(this->retired, [](const std::shared_ptr<const AirDataSnapshot>& snapshot) {
+		return snapshot.use_count() == 1;
+		});
+}
+
+void IASsure::AirDataPipeline::threadFn()
+{
+	std::vector<Capture> batch;
+	for (;;) {
+		uint64_t flushRequest;
+		{
+			std::unique_lock<std::mutex> lock(this->m);
+			bool pending = this->c.wait_for(lock, AIR_DATA_PIPELINE_WEATHER_INTERVAL, [this]() {
+				return this->shouldStop || !this->captures.empty() || this->flushRequested != this->flushCompleted;
+				});
+			if (pending) {
+				// radar updates arrive in quick succession, wait for more of them unless a flush is waiting for the results
+				this->c.wait_for(lock, AIR_DATA_PIPELINE_BATCH_DELAY, [this]() {
+					return this->shouldStop || this->flushRequested != this->flushCompleted;
+					});
+			}
+
+			if (this->shouldStop) {
+				return;
+			}
+
+			batch.swap(this->captures);
+			flushRequest = this->flushRequested;
+		}
+
+		{
+			std::scoped_lock<std::mutex> lock(this->poolMutex);
+			this->process(batch);
+		}
+		batch.clear();
+		this->release();
+
+		{
+			std::scoped_lock<std::mutex> lock(this->m);
+			this->flushCompleted = flushRequest;
+		}
+		this->flushed.notify_all();
+	}
+}
\ No newline at end of file
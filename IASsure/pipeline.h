@@ -0,0 +1,164 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <bitset>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include "aircraft.h"
+#include "calculations.h"
+#include "thread.h"
+#include "weather.h"
+
+namespace IASsure {
+	// time the worker waits after the first captured input before processing, collecting further inputs arriving meanwhile into the same batch
+	constexpr std::chrono::milliseconds AIR_DATA_PIPELINE_BATCH_DELAY(50);
+	// interval the worker checks for new weather data without any captured inputs, recalculating all targets on a change
+	constexpr std::chrono::milliseconds AIR_DATA_PIPELINE_WEATHER_INTERVAL(1000);
+	// number of targets calculated per task when splitting a batch across a thread pool
+	constexpr size_t AIR_DATA_PIPELINE_GRAIN_SIZE = 64;
+	// results are split into 2^bits chunks by callsign hash, publishing only copies the chunks of changed targets
+	constexpr int AIR_DATA_SNAPSHOT_CHUNK_BITS = 6;
+	constexpr size_t AIR_DATA_SNAPSHOT_CHUNKS = (size_t)1 << AIR_DATA_SNAPSHOT_CHUNK_BITS;
+
+	// AirDataInput contains the radar data of a target required for calculating its air data
+	class AirDataInput {
+	public:
+		double latitude;
+		double longitude;
+		int altitude; // pressure altitude in ft
+		int heading; // in deg
+		int groundSpeed; // in kn
+	};
+
+	// AirDataResult stores the air data calculated for a target along with the input and weather data it was calculated for
+	class AirDataResult {
+	public:
+		// position passed when capturing the input, identifying the radar update the air data belongs to
+		uint64_t position = 0;
+		uint64_t weatherGeneration = 0;
+		// settings version passed when capturing the input
+		uint64_t settingsVersion = 0;
+		AirData data;
+	};
+
+	typedef CallsignMap<AirDataResult> AirDataChunk;
+
+	// AirDataSnapshot contains the latest air data of all targets at the time of publishing. snapshots are never modified after being published,
+	// chunks without changed results are shared with the previous snapshot.
+	class AirDataSnapshot {
+	public:
+		// sequence number of the snapshot, increasing with every published snapshot
+		uint64_t sequence = 0;
+		// results indexed by chunkIndex of the callsign hash, nullptr for chunks without results
+		std::array<std::shared_ptr<const AirDataChunk>, AIR_DATA_SNAPSHOT_CHUNKS> chunks;
+
+		const AirDataResult* find(std::string_view callsign) const;
+		size_t size() const;
+
+		// chunkIndex uses the upper bits of the hash, the lower ones select the slot within the chunk
+		static size_t chunkIndex(uint64_t hash)
+		{
+			return (size_t)(hash >> (64 - AIR_DATA_SNAPSHOT_CHUNK_BITS));
+		}
+	};
+
+	// AirDataPipeline calculates air data for captured radar inputs on a worker thread, publishing the results as snapshots readable without locking.
+	// capturing only appends the input to a buffer, weather lookups and calculations of all inputs captured meanwhile are performed as one batch.
+	class AirDataPipeline {
+	public:
+		AirDataPipeline(const Weather& weather, AtmosphereModel model = AtmosphereModel::Exact);
+		~AirDataPipeline();
+
+		// capture queues the input of a target for calculation, position and settingsVersion are passed along to the published result
+		void capture(std::string_view callsign, uint64_t position, const AirDataInput& input, uint64_t settingsVersion = 0);
+		// remove drops the input and result of a target
+		void remove(std::string_view callsign);
+		// clear drops the inputs and results of all targets
+		void clear();
+		// flush blocks until all inputs captured before have been processed and published
+		void flush();
+
+		// snapshot returns the latest published snapshot, never nullptr
+		std::shared_ptr<const AirDataSnapshot> snapshot() const;
+		// sequence returns the sequence number of the latest published snapshot without acquiring it
+		uint64_t sequence() const;
+
+		// setThreadPool sets the thread pool used for calculating large batches, nullptr calculates them on the worker thread.
+		// the pool has to outlive the pipeline or be reset before being destroyed.
+		void setThreadPool(thread::ThreadPool* pool);
+		// setModel sets the atmosphere model used for all inputs processed afterwards
+		void setModel(AtmosphereModel model);
+	private:
+		enum class Operation {
+			Capture,
+			Remove,
+			Clear,
+		};
+
+		// Capture is a single captured input or removal, stored in the buffer until processed by the worker
+		struct Capture {
+			Operation operation;
+			std::string callsign;
+			uint64_t position;
+			uint64_t settingsVersion;
+			AirDataInput input;
+		};
+
+		// Target is the latest input of a target as known by the worker
+		struct Target {
+			uint64_t position = 0;
+			uint64_t settingsVersion = 0;
+			AirDataInput input{};
+			bool outdated = false;
+			WeatherLookupHint hint;
+		};
+
+		const Weather& weather;
+		std::atomic<AtmosphereModel> model;
+
+		std::atomic<std::shared_ptr<const AirDataSnapshot>> published;
+		std::atomic<uint64_t> publishedSequence;
+
+		// guards the capture buffer and the flush counters, never held while calculating
+		std::mutex m;
+		std::condition_variable c;
+		std::condition_variable flushed;
+		std::vector<Capture> captures;
+		uint64_t flushRequested;
+		uint64_t flushCompleted;
+		bool shouldStop;
+
+		// held by the worker while processing a batch
+		std::mutex poolMutex;
+		thread::ThreadPool* pool;
+
+		// only accessed by the worker
+		CallsignMap<Target> targets;
+		std::array<AirDataChunk, AIR_DATA_SNAPSHOT_CHUNKS> results;
+		// chunks changed since the last published snapshot
+		std::bitset<AIR_DATA_SNAPSHOT_CHUNKS> changedChunks;
+		// snapshots replaced since, released by the worker once no longer referenced by any reader
+		std::vector<std::shared_ptr<const AirDataSnapshot>> retired;
+		uint64_t weatherGeneration;
+		// targets and their results to calculate in the current batch
+		std::vector<std::pair<Target*, AirDataResult*>> work;
+
+		std::thread t;
+
+		void enqueue(Capture capture);
+		AirDataChunk& chunk(std::string_view callsign);
+		void process(std::vector<Capture>& batch);
+		void publish();
+		void release();
+		void threadFn();
+	};
+}
\ No newline at end of file
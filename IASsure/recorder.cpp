@@ -0,0 +1,295 @@
+#include "recorder.h"
+
+#include "constants.h"
+
+namespace {
+	// header of each record: type, time since the start of the recording in ns and payload size
+	constexpr size_t RECORD_HEADER_SIZE = sizeof(uint8_t) + sizeof(uint64_t) + sizeof(uint32_t);
+}
+
+IASsure::Recorder::Recorder(host::Host& host, const Weather& weather, const std::string& fileName, const RecordingHeader& header) :
+	host(host),
+	weather(weather),
+	fileName(fileName),
+	start(std::chrono::steady_clock::now()),
+	weatherRecorded(false),
+	recorded(0),
+	droppedRecords(0),
+	buffer(RECORDING_BUFFER_SIZE),
+	created(false),
+	shouldStop(false)
+{
+	binary::Writer writer;
+	writer.write(RECORDING_MAGIC);
+	writer.write(RECORDING_VERSION);
+	writer.write(header.settings);
+	writer.write((uint8_t)header.config.has_value());
+	writer.write(header.config.value_or(""));
+	this->header = std::move(writer.data);
+
+	this->t = std::thread(&IASsure::Recorder::threadFn, this);
+}
+
+IASsure::Recorder::~Recorder()
+{
+	{
+		std::scoped_lock<std::mutex> lock(this->m);
+		this->shouldStop = true;
+	}
+	this->c.notify_one();
+	this->t.join();
+}
+
+void IASsure::Recorder::recordPosition(const host::RadarTarget& rt)
+{
+	this->payload.write(rt.callsign());
+	this->payload.write(rt.latitude());
+	this->payload.write(rt.longitude());
+	this->payload.write((int32_t)rt.pressureAltitude());
+	this->payload.write((int32_t)rt.flightLevel());
+	this->payload.write((int32_t)rt.reportedHeading());
+	this->payload.write((int32_t)rt.reportedHeadingTrueNorth());
+	this->payload.write((int32_t)rt.reportedGS());
+	this->payload.write((int32_t)rt.calculatedGS());
+
+	this->push(RecordType::Position);
+}
+
+void IASsure::Recorder::recordFlightPlan(FlightPlanEvent event, const host::FlightPlan& fp, int functionId, std::string_view itemString)
+{
+	this->payload.write((uint8_t)event);
+	this->payload.write((int32_t)functionId);
+	this->payload.write(itemString);
+	this->payload.write(fp.callsign());
+	this->payload.write((uint8_t)fp.isTrackedByMe());
+	this->payload.write(fp.trackingControllerId());
+	this->payload.write(fp.scratchPad());
+	this->payload.write((uint8_t)host::FLIGHT_STRIP_ANNOTATION_COUNT);
+	for (int i = 0; i < host::FLIGHT_STRIP_ANNOTATION_COUNT; i++) {
+		this->payload.write(fp.flightStripAnnotation(i));
+	}
+
+	this->push(RecordType::FlightPlan);
+}
+
+void IASsure::Recorder::recordCommand(std::string_view command)
+{
+	this->payload.write(command);
+
+	this->push(RecordType::Command);
+}
+
+void IASsure::Recorder::recordWeather()
+{
+	std::shared_ptr<const WeatherDataset> dataset = this->weather.current();
+	if (this->weatherRecorded && dataset == this->recordedWeather) {
+		return;
+	}
+	this->weatherRecorded = true;
+	this->recordedWeather = dataset;
+
+	// serializing the weather data is left to the writer, the buffer only stores the position of the swap within the recording
+	{
+		std::scoped_lock<std::mutex> lock(this->weatherMutex);
+		this->weatherSwaps.push_back(dataset);
+	}
+
+	if (!this->push(RecordType::Weather)) {
+		std::scoped_lock<std::mutex> lock(this->weatherMutex);
+		this->weatherSwaps.pop_back();
+		// retried on the next call
+		this->weatherRecorded = false;
+	}
+}
+
+size_t IASsure::Recorder::records() const
+{
+	return this->recorded;
+}
+
+size_t IASsure::Recorder::dropped() const
+{
+	return this->droppedRecords.load();
+}
+
+bool IASsure::Recorder::push(RecordType type)
+{
+	this->record.data.clear();
+	this->record.write((uint8_t)type);
+	this->record.write((uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - this->start).count());
+	this->record.write((uint32_t)this->payload.data.size());
+	this->record.data.append(this->payload.data);
+	this->payload.data.clear();
+
+	// the buffer is never waited for, records are dropped instead if the writer falls behind
+	if (!this->buffer.write(this->record.data)) {
+		this->droppedRecords++;
+		return false;
+	}
+
+	this->recorded++;
+	return true;
+}
+
+void IASsure::Recorder::flush()
+{
+	this->pending.clear();
+	this->buffer.read(this->pending);
+
+	this->output.clear();
+	if (!this->created) {
+		this->output.append(this->header);
+	}
+
+	// the buffer only ever contains complete records
+	binary::Reader reader(this->pending);
+	while (!reader.empty()) {
+		size_t offset = this->pending.size() - reader.remaining();
+		RecordType type = (RecordType)reader.read<uint8_t>();
+		uint64_t time = reader.read<uint64_t>();
+		std::string_view payload = reader.readBytes(reader.read<uint32_t>());
+
+		if (type != RecordType::Weather) {
+			this->output.append(this->pending, offset, RECORD_HEADER_SIZE + payload.size());
+			continue;
+		}
+
+		std::shared_ptr<const WeatherDataset> dataset;
+		{
+			std::scoped_lock<std::mutex> lock(this->weatherMutex);
+			dataset = std::move(this->weatherSwaps.front());
+			this->weatherSwaps.pop_front();
+		}
+
+		// cleared weather data is stored as an empty record
+		std::string data;
+		if (dataset != nullptr) {
+			data = Weather::serialize(*dataset);
+		}
+
+		binary::Writer writer;
+		writer.write((uint8_t)type);
+		writer.write(time);
+		writer.write((uint32_t)data.size());
+		writer.data.append(data);
+		this->output.append(writer.data);
+	}
+
+	if (this->output.empty()) {
+		return;
+	}
+
+	try {
+		if (this->created) {
+			this->host.appendFile(this->fileName, this->output);
+		}
+		else {
+			this->host.writeFile(this->fileName, this->output);
+			this->created = true;
+		}
+	}
+	catch (std::exception const& ex) {
+		this->host.displayMessage(PLUGIN_NAME, "Recording", std::string("Failed to write recording: ") + ex.what());
+	}
+}
+
+void IASsure::Recorder::threadFn()
+{
+	for (;;) {
+		bool stop;
+		{
+			std::unique_lock<std::mutex> lock(this->m);
+			this->c.wait_for(lock, RECORDING_FLUSH_INTERVAL, [this]() { return this->shouldStop; });
+			stop = this->shouldStop;
+		}
+
+		this->flush();
+
+		if (stop) {
+			return;
+		}
+	}
+}
+
+IASsure::RecordingReader::RecordingReader(std::string_view data) :
+	reader(data)
+{
+	if (this->reader.read<uint32_t>() != RECORDING_MAGIC) {
+		throw std::invalid_argument("invalid recording magic");
+	}
+	if (this->reader.read<uint32_t>() != RECORDING_VERSION) {
+		throw std::invalid_argument("unsupported recording version");
+	}
+
+	this->recordingHeader.settings = this->reader.readString();
+	bool hasConfig = this->reader.read<uint8_t>() != 0;
+	std::string config = this->reader.readString();
+	if (hasConfig) {
+		this->recordingHeader.config = std::move(config);
+	}
+}
+
+const IASsure::RecordingHeader& IASsure::RecordingReader::header() const
+{
+	return this->recordingHeader;
+}
+
+bool IASsure::RecordingReader::next(Record& record)
+{
+	while (this->reader.remaining() >= RECORD_HEADER_SIZE) {
+		RecordType type = (RecordType)this->reader.read<uint8_t>();
+		uint64_t time = this->reader.read<uint64_t>();
+		uint32_t size = this->reader.read<uint32_t>();
+		if (size > this->reader.remaining()) {
+			return false;
+		}
+		binary::Reader payload(this->reader.readBytes(size));
+
+		record.type = type;
+		record.time = std::chrono::nanoseconds(time);
+
+		switch (type) {
+		case RecordType::Position:
+			record.position.callsign = payload.readString();
+			record.position.latitude = payload.read<double>();
+			record.position.longitude = payload.read<double>();
+			record.position.pressureAltitude = payload.read<int32_t>();
+			record.position.flightLevel = payload.read<int32_t>();
+			record.position.reportedHeading = payload.read<int32_t>();
+			record.position.reportedHeadingTrueNorth = payload.read<int32_t>();
+			record.position.reportedGS = payload.read<int32_t>();
+			record.position.calculatedGS = payload.read<int32_t>();
+			return true;
+		case RecordType::FlightPlan:
+		{
+			record.event = (FlightPlanEvent)payload.read<uint8_t>();
+			record.functionId = payload.read<int32_t>();
+			record.itemString = payload.readString();
+			record.flightPlan.callsign = payload.readString();
+			record.flightPlan.trackedByMe = payload.read<uint8_t>() != 0;
+			record.flightPlan.trackingControllerId = payload.readString();
+			record.flightPlan.scratchPad = payload.readString();
+
+			uint8_t annotations = payload.read<uint8_t>();
+			for (int i = 0; i < annotations; i++) {
+				std::string annotation = payload.readString();
+				if (i < host::FLIGHT_STRIP_ANNOTATION_COUNT) {
+					record.flightPlan.flightStripAnnotations[i] = std::move(annotation);
+				}
+			}
+			return true;
+		}
+		case RecordType::Command:
+			record.command = payload.readString();
+			return true;
+		case RecordType::Weather:
+			record.weather = std::string(payload.readBytes(payload.remaining()));
+			return true;
+		default:
+			// records added by later versions of the format are skipped
+			break;
+		}
+	}
+
+	return false;
+}
\ No newline at end of file
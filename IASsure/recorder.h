@@ -0,0 +1,146 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <thread>
+
+#include "binary.h"
+#include "host.h"
+#include "thread.h"
+#include "weather.h"
+
+namespace IASsure {
+	constexpr uint32_t RECORDING_MAGIC = 0x52534149; // "IASR"
+	// version of the binary recording format, increase on any change to the layout
+	constexpr uint32_t RECORDING_VERSION = 1;
+	// size of the buffer between the recording thread and the writer, records are dropped while the buffer is full
+	constexpr size_t RECORDING_BUFFER_SIZE = 4 * 1024 * 1024;
+	// interval the writer appends buffered records to the file
+	constexpr std::chrono::milliseconds RECORDING_FLUSH_INTERVAL(250);
+
+	enum class RecordType : uint8_t {
+		Position = 1,
+		FlightPlan = 2,
+		Command = 3,
+		Weather = 4,
+	};
+
+	enum class FlightPlanEvent : uint8_t {
+		ScratchPadUpdate = 1,
+		FlightStripReceived = 2,
+		Disconnect = 3,
+		FunctionCall = 4,
+	};
+
+	// Record is a single input of the plugin read from a recording, only the fields of its type are set
+	class Record {
+	public:
+		RecordType type = RecordType::Position;
+		// time since the start of the recording
+		std::chrono::nanoseconds time{ 0 };
+
+		host::RadarTargetData position;
+
+		FlightPlanEvent event = FlightPlanEvent::ScratchPadUpdate;
+		host::FlightPlanData flightPlan;
+		// tag item function called for FlightPlanEvent::FunctionCall
+		int functionId = 0;
+		std::string itemString;
+
+		std::string command;
+
+		// weather data in the format of Weather::serialize, empty if the weather data was cleared
+		std::string weather;
+	};
+
+	// RecordingHeader stores the state of the plugin at the start of the recording required for replaying it
+	class RecordingHeader {
+	public:
+		// plugin settings as saved to the host
+		std::string settings;
+		// content of the config file, if available
+		std::optional<std::string> config;
+	};
+
+	// Recorder appends all inputs of the plugin (radar position updates, flight plan updates, commands and weather data swaps) to a
+	// binary recording. records are encoded on the calling thread and passed to a writer thread via a lock-free buffer, so recording
+	// never waits for the disk. all record functions have to be called from the same thread.
+	class Recorder {
+	public:
+		// Recorder starts a new recording, replacing the file once the writer first flushes
+		Recorder(host::Host& host, const Weather& weather, const std::string& fileName, const RecordingHeader& header);
+		// ~Recorder stops the writer after appending all remaining records
+		~Recorder();
+
+		Recorder(const Recorder&) = delete;
+		Recorder& operator=(const Recorder&) = delete;
+
+		void recordPosition(const host::RadarTarget& rt);
+		void recordFlightPlan(FlightPlanEvent event, const host::FlightPlan& fp, int functionId = 0, std::string_view itemString = {});
+		void recordCommand(std::string_view command);
+		// recordWeather records a weather data swap if the weather data changed since the last call, including the start of the recording
+		void recordWeather();
+
+		// number of records passed to the writer and dropped since the buffer was full
+		size_t records() const;
+		size_t dropped() const;
+	private:
+		host::Host& host;
+		const Weather& weather;
+		std::string const fileName;
+		std::chrono::steady_clock::time_point const start;
+
+		// only accessed by the recording thread
+		binary::Writer record;
+		binary::Writer payload;
+		bool weatherRecorded;
+		std::shared_ptr<const WeatherDataset> recordedWeather;
+		size_t recorded;
+		std::atomic<size_t> droppedRecords;
+
+		thread::RingBuffer buffer;
+		// datasets of the weather swaps in the buffer, serialized by the writer. only locked on the rare swaps, never while writing
+		std::mutex weatherMutex;
+		std::deque<std::shared_ptr<const WeatherDataset>> weatherSwaps;
+
+		// only accessed by the writer
+		std::string header;
+		bool created;
+		std::string pending;
+		std::string output;
+
+		std::mutex m;
+		std::condition_variable c;
+		bool shouldStop;
+		std::thread t;
+
+		// push passes the encoded payload to the writer, returning false if the record was dropped
+		bool push(RecordType type);
+		void flush();
+		void threadFn();
+	};
+
+	// RecordingReader reads the records of a recording in the order they were recorded
+	class RecordingReader {
+	public:
+		// RecordingReader validates the header of the recording, throwing std::invalid_argument for invalid or unsupported data. the data
+		// has to outlive the reader
+		RecordingReader(std::string_view data);
+
+		const RecordingHeader& header() const;
+		// next reads the following record, returning false at the end of the recording. records of unknown types are skipped and
+		// a truncated last record (e.g. after a crash while writing) ends the recording, throws std::invalid_argument for corrupt data
+		bool next(Record& record);
+	private:
+		binary::Reader reader;
+		RecordingHeader recordingHeader;
+	};
+}
\ No newline at end of file
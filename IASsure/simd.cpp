@@ -0,0 +1,62 @@
+#include "simd.h"
+
+#if defined(IASSURE_SIMD_X86) && defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace {
+	IASsure::simd::InstructionSet detect()
+	{
+#if defined(IASSURE_SIMD_X86) && defined(_MSC_VER)
+		int info[4];
+		__cpuid(info, 0);
+		int maxLeaf = info[0];
+
+		__cpuid(info, 1);
+		bool sse2 = (info[3] & (1 << 26)) != 0;
+		bool osxsave = (info[2] & (1 << 27)) != 0;
+		bool avx = (info[2] & (1 << 28)) != 0;
+
+		bool avx2 = false;
+		// AVX registers must be enabled by the operating system (XCR0 bits 1 and 2), otherwise AVX instructions fault
+		if (maxLeaf >= 7 && osxsave && avx && (_xgetbv(0) & 0x6) == 0x6) {
+			__cpuidex(info, 7, 0);
+			avx2 = (info[1] & (1 << 5)) != 0;
+		}
+
+		if (avx2) {
+			return IASsure::simd::InstructionSet::AVX2;
+		}
+		if (sse2) {
+			return IASsure::simd::InstructionSet::SSE2;
+		}
+#elif defined(IASSURE_SIMD_X86)
+		__builtin_cpu_init();
+		if (__builtin_cpu_supports("avx2")) {
+			return IASsure::simd::InstructionSet::AVX2;
+		}
+		if (__builtin_cpu_supports("sse2")) {
+			return IASsure::simd::InstructionSet::SSE2;
+		}
+#endif
+		return IASsure::simd::InstructionSet::Scalar;
+	}
+}
+
+IASsure::simd::InstructionSet IASsure::simd::supported()
+{
+	static const InstructionSet instructionSet = detect();
+	return instructionSet;
+}
+
+const char* IASsure::simd::name(InstructionSet instructionSet)
+{
+	switch (instructionSet) {
+	case InstructionSet::AVX2:
+		return "AVX2";
+	case InstructionSet::SSE2:
+		return "SSE2";
+	default:
+		return "scalar";
+	}
+}
\ No newline at end of file
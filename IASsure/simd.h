@@ -0,0 +1,28 @@
+#pragma once
+
+#if defined(_M_IX86) || defined(_M_X64) || defined(__i386__) || defined(__x86_64__)
+#define IASSURE_SIMD_X86
+#include <immintrin.h>
+#endif
+
+// MSVC allows using all intrinsics regardless of the target architecture, other compilers require functions using
+// instruction set extensions to be marked explicitly
+#if defined(_MSC_VER) || !defined(IASSURE_SIMD_X86)
+#define IASSURE_TARGET_AVX2
+#else
+#define IASSURE_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+
+namespace IASsure {
+	namespace simd {
+		enum class InstructionSet {
+			Scalar,
+			SSE2,
+			AVX2,
+		};
+
+		// best instruction set supported by both the CPU and the operating system, detected once on first use
+		InstructionSet supported();
+		const char* name(InstructionSet instructionSet);
+	}
+}
\ No newline at end of file
@@ -0,0 +1,443 @@
+#include "spatial.h"
+
+namespace {
+	size_t maxDotProductScalar(const double* xs, const double* ys, const double* zs, size_t begin, size_t count, const double query[3], size_t best, double& bestDot)
+	{
+		for (size_t i = begin; i < count; i++) {
+			double dot = xs[i] * query[0] + ys[i] * query[1] + zs[i] * query[2];
+			if (best == IASsure::SpatialIndex::npos || dot > bestDot) {
+				best = i;
+				bestDot = dot;
+			}
+		}
+
+		return best;
+	}
+
+	// reduceLanes picks the best result of all SIMD lanes, each lane only kept the first index of its maximum
+	size_t reduceLanes(const double* dots, const double* indices, size_t lanes, double& bestDot)
+	{
+		size_t best = (size_t)indices[0];
+		bestDot = dots[0];
+		for (size_t l = 1; l < lanes; l++) {
+			if (dots[l] > bestDot || (dots[l] == bestDot && (size_t)indices[l] < best)) {
+				best = (size_t)indices[l];
+				bestDot = dots[l];
+			}
+		}
+
+		return best;
+	}
+
+#ifdef IASSURE_SIMD_X86
+	size_t maxDotProductSSE2(const double* xs, const double* ys, const double* zs, size_t count, const double query[3])
+	{
+		if (count < 2) {
+			double bestDot = 0;
+			return maxDotProductScalar(xs, ys, zs, 0, count, query, IASsure::SpatialIndex::npos, bestDot);
+		}
+
+		__m128d qx = _mm_set1_pd(query[0]);
+		__m128d qy = _mm_set1_pd(query[1]);
+		__m128d qz = _mm_set1_pd(query[2]);
+
+		// indices are tracked as doubles, exactly representable for any realistic dataset size
+		__m128d index = _mm_set_pd(1, 0);
+		__m128d step = _mm_set1_pd(2);
+		__m128d bestDot = _mm_add_pd(_mm_add_pd(_mm_mul_pd(_mm_loadu_pd(xs), qx), _mm_mul_pd(_mm_loadu_pd(ys), qy)), _mm_mul_pd(_mm_loadu_pd(zs), qz));
+		__m128d bestIndex = index;
+
+		size_t i = 2;
+		for (; i + 2 <= count; i += 2) {
+			index = _mm_add_pd(index, step);
+			__m128d dot = _mm_add_pd(_mm_add_pd(_mm_mul_pd(_mm_loadu_pd(xs + i), qx), _mm_mul_pd(_mm_loadu_pd(ys + i), qy)), _mm_mul_pd(_mm_loadu_pd(zs + i), qz));
+			// SSE2 has no blend instruction, select lanes via bitwise masking
+			__m128d mask = _mm_cmpgt_pd(dot, bestDot);
+			bestDot = _mm_or_pd(_mm_and_pd(mask, dot), _mm_andnot_pd(mask, bestDot));
+			bestIndex = _mm_or_pd(_mm_and_pd(mask, index), _mm_andnot_pd(mask, bestIndex));
+		}
+
+		double dots[2];
+		double indices[2];
+		_mm_storeu_pd(dots, bestDot);
+		_mm_storeu_pd(indices, bestIndex);
+
+		double dot;
+		size_t best = reduceLanes(dots, indices, 2, dot);
+		return maxDotProductScalar(xs, ys, zs, i, count, query, best, dot);
+	}
+
+	IASSURE_TARGET_AVX2 size_t maxDotProductAVX2(const double* xs, const double* ys, const double* zs, size_t count, const double query[3])
+	{
+		if (count < 4) {
+			double bestDot = 0;
+			return maxDotProductScalar(xs, ys, zs, 0, count, query, IASsure::SpatialIndex::npos, bestDot);
+		}
+
+		__m256d qx = _mm256_set1_pd(query[0]);
+		__m256d qy = _mm256_set1_pd(query[1]);
+		__m256d qz = _mm256_set1_pd(query[2]);
+
+		// no fused multiply-add is used, keeping results identical to the scalar and SSE2 implementations
+		__m256d index = _mm256_set_pd(3, 2, 1, 0);
+		__m256d step = _mm256_set1_pd(4);
+		__m256d bestDot = _mm256_add_pd(_mm256_add_pd(_mm256_mul_pd(_mm256_loadu_pd(xs), qx), _mm256_mul_pd(_mm256_loadu_pd(ys), qy)), _mm256_mul_pd(_mm256_loadu_pd(zs), qz));
+		__m256d bestIndex = index;
+
+		size_t i = 4;
+		for (; i + 4 <= count; i += 4) {
+			index = _mm256_add_pd(index, step);
+			__m256d dot = _mm256_add_pd(_mm256_add_pd(_mm256_mul_pd(_mm256_loadu_pd(xs + i), qx), _mm256_mul_pd(_mm256_loadu_pd(ys + i), qy)), _mm256_mul_pd(_mm256_loadu_pd(zs + i), qz));
+			__m256d mask = _mm256_cmp_pd(dot, bestDot, _CMP_GT_OQ);
+			bestDot = _mm256_blendv_pd(bestDot, dot, mask);
+			bestIndex = _mm256_blendv_pd(bestIndex, index, mask);
+		}
+
+		double dots[4];
+		double indices[4];
+		_mm256_storeu_pd(dots, bestDot);
+		_mm256_storeu_pd(indices, bestIndex);
+
+		double dot;
+		size_t best = reduceLanes(dots, indices, 4, dot);
+		return maxDotProductScalar(xs, ys, zs, i, count, query, best, dot);
+	}
+#endif
+}
+
+IASsure::SpatialIndex::SpatialIndex(const std::vector<std::pair<double, double>>& coordinates)
+{
+	this->build(coordinates);
+}
+
+void IASsure::SpatialIndex::build(const std::vector<std::pair<double, double>>& coordinates)
+{
+	this->nodes.clear();
+	this->nodes.reserve(coordinates.size());
+	this->xs.resize(coordinates.size());
+	this->ys.resize(coordinates.size());
+	this->zs.resize(coordinates.size());
+
+	for (size_t i = 0; i < coordinates.size(); i++) {
+		Node node{};
+		toUnitVector(coordinates[i].first, coordinates[i].second, node.coords);
+		node.index = i;
+		this->nodes.push_back(node);
+
+		this->xs[i] = node.coords[0];
+		this->ys[i] = node.coords[1];
+		this->zs[i] = node.coords[2];
+	}
+
+	this->build(0, this->nodes.size());
+	this->buildNeighbours();
+}
+
+void IASsure::SpatialIndex::clear()
+{
+	this->nodes.clear();
+	this->xs.clear();
+	this->ys.clear();
+	this->zs.clear();
+	this->neighbours.clear();
+	this->neighbourRadii.clear();
+}
+
+size_t IASsure::SpatialIndex::findClosest(double latitude, double longitude) const
+{
+	if (this->nodes.empty()) {
+		return npos;
+	}
+
+	double query[3];
+	toUnitVector(latitude, longitude, query);
+
+	return this->search(query);
+}
+
+size_t IASsure::SpatialIndex::findClosest(double latitude, double longitude, size_t hint) const
+{
+	if (this->nodes.empty()) {
+		return npos;
+	}
+
+	double query[3];
+	toUnitVector(latitude, longitude, query);
+
+	if (hint >= this->nodes.size()) {
+		return this->search(query);
+	}
+
+	size_t current = hint;
+	for (int step = 0; step < SPATIAL_MAX_HINT_STEPS; step++) {
+		size_t best = current;
+		double bestDistance = this->distance(current, query);
+
+		const uint32_t* neighbours = this->neighbours.data() + current * SPATIAL_NEIGHBOUR_COUNT;
+		for (size_t n = 0; n < SPATIAL_NEIGHBOUR_COUNT && neighbours[n] != UINT32_MAX; n++) {
+			double d = this->distance(neighbours[n], query);
+			if (d < bestDistance || (d == bestDistance && neighbours[n] < best)) {
+				best = neighbours[n];
+				bestDistance = d;
+			}
+		}
+
+		if (best != current) {
+			current = best;
+			continue;
+		}
+
+		// chord distances satisfy the triangle inequality, a small margin accounts for rounding errors of the squared distances
+		if (4 * bestDistance < this->neighbourRadii[current] * (1 - 1e-9)) {
+			return current;
+		}
+
+		break;
+	}
+
+	return this->search(query);
+}
+
+size_t IASsure::SpatialIndex::findClosestLinear(double latitude, double longitude, simd::InstructionSet instructionSet) const
+{
+	// trigonometric functions are only required for the query, all points have been converted to unit vectors while building
+	double query[3];
+	toUnitVector(latitude, longitude, query);
+
+	return maxDotProduct(this->xs.data(), this->ys.data(), this->zs.data(), this->xs.size(), query, instructionSet);
+}
+
+std::vector<size_t> IASsure::SpatialIndex::findNearest(double latitude, double longitude, size_t k) const
+{
+	double query[3];
+	toUnitVector(latitude, longitude, query);
+
+	std::vector<std::pair<double, size_t>> heap;
+	heap.reserve(k + 1);
+	if (k > 0) {
+		this->findNearest(0, this->nodes.size(), query, npos, k, heap);
+	}
+	std::sort_heap(heap.begin(), heap.end());
+
+	std::vector<size_t> nearest;
+	nearest.reserve(heap.size());
+	for (auto const& [distance, index] : heap) {
+		nearest.push_back(index);
+	}
+
+	return nearest;
+}
+
+bool IASsure::SpatialIndex::empty() const
+{
+	return this->nodes.empty();
+}
+
+size_t IASsure::SpatialIndex::size() const
+{
+	return this->nodes.size();
+}
+
+void IASsure::SpatialIndex::build(size_t begin, size_t end)
+{
+	if (end - begin <= 1) {
+		return;
+	}
+
+	// split along the axis with the largest extent, keeping the tree balanced for clustered (single FIR) datasets
+	double min[3] = { 2, 2, 2 };
+	double max[3] = { -2, -2, -2 };
+	for (size_t i = begin; i < end; i++) {
+		for (int a = 0; a < 3; a++) {
+			min[a] = std::min(min[a], this->nodes[i].coords[a]);
+			max[a] = std::max(max[a], this->nodes[i].coords[a]);
+		}
+	}
+
+	uint8_t axis = 0;
+	for (uint8_t a = 1; a < 3; a++) {
+		if (max[a] - min[a] > max[axis] - min[axis]) {
+			axis = a;
+		}
+	}
+
+	// nodes are stored as an implicit tree, the median of each range is the node splitting it
+	size_t mid = begin + (end - begin) / 2;
+	std::nth_element(this->nodes.begin() + begin, this->nodes.begin() + mid, this->nodes.begin() + end, [axis](const Node& a, const Node& b) {
+		return a.coords[axis] < b.coords[axis];
+		});
+	this->nodes[mid].axis = axis;
+
+	this->build(begin, mid);
+	this->build(mid + 1, end);
+}
+
+void IASsure::SpatialIndex::buildNeighbours()
+{
+	size_t count = this->nodes.size();
+	this->neighbours.assign(count * SPATIAL_NEIGHBOUR_COUNT, UINT32_MAX);
+	this->neighbourRadii.assign(count, std::numeric_limits<double>::infinity());
+
+	std::vector<std::pair<double, size_t>> heap;
+	heap.reserve(SPATIAL_NEIGHBOUR_COUNT + 1);
+
+	for (size_t i = 0; i < count; i++) {
+		double query[3] = { this->xs[i], this->ys[i], this->zs[i] };
+
+		heap.clear();
+		this->findNearest(0, count, query, i, SPATIAL_NEIGHBOUR_COUNT, heap);
+		std::sort_heap(heap.begin(), heap.end());
+
+		for (size_t n = 0; n < heap.size(); n++) {
+			this->neighbours[i * SPATIAL_NEIGHBOUR_COUNT + n] = (uint32_t)heap[n].second;
+		}
+
+		// points with less than SPATIAL_NEIGHBOUR_COUNT other points know all points, their radius stays infinite
+		if (heap.size() == SPATIAL_NEIGHBOUR_COUNT) {
+			this->neighbourRadii[i] = heap.back().first;
+		}
+	}
+}
+
+size_t IASsure::SpatialIndex::search(const double query[3]) const
+{
+	if (this->nodes.size() <= SPATIAL_LINEAR_SCAN_THRESHOLD) {
+		return maxDotProduct(this->xs.data(), this->ys.data(), this->zs.data(), this->xs.size(), query, simd::supported());
+	}
+
+	size_t best = npos;
+	double bestDistance = -1;
+	this->findClosest(0, this->nodes.size(), query, best, bestDistance);
+
+	return best;
+}
+
+void IASsure::SpatialIndex::findClosest(size_t begin, size_t end, const double query[3], size_t& best, double& bestDistance) const
+{
+	if (begin >= end) {
+		return;
+	}
+
+	size_t mid = begin + (end - begin) / 2;
+	const Node& node = this->nodes[mid];
+
+	double dx = query[0] - node.coords[0];
+	double dy = query[1] - node.coords[1];
+	double dz = query[2] - node.coords[2];
+	double d = dx * dx + dy * dy + dz * dz;
+
+	// ties are resolved using the original index so results match a linear scan in input order
+	if (best == npos || d < bestDistance || (d == bestDistance && node.index < best)) {
+		best = node.index;
+		bestDistance = d;
+	}
+
+	if (end - begin == 1) {
+		return;
+	}
+
+	double diff = query[node.axis] - node.coords[node.axis];
+	if (diff < 0) {
+		this->findClosest(begin, mid, query, best, bestDistance);
+		if (diff * diff <= bestDistance) {
+			this->findClosest(mid + 1, end, query, best, bestDistance);
+		}
+	}
+	else {
+		this->findClosest(mid + 1, end, query, best, bestDistance);
+		if (diff * diff <= bestDistance) {
+			this->findClosest(begin, mid, query, best, bestDistance);
+		}
+	}
+}
+
+void IASsure::SpatialIndex::findNearest(size_t begin, size_t end, const double query[3], size_t exclude, size_t k, std::vector<std::pair<double, size_t>>& heap) const
+{
+	if (begin >= end) {
+		return;
+	}
+
+	size_t mid = begin + (end - begin) / 2;
+	const Node& node = this->nodes[mid];
+
+	if (node.index != exclude) {
+		double dx = query[0] - node.coords[0];
+		double dy = query[1] - node.coords[1];
+		double dz = query[2] - node.coords[2];
+		std::pair<double, size_t> candidate = { dx * dx + dy * dy + dz * dz, node.index };
+
+		// heap keeps the k nearest points found so far with the farthest one on top
+		if (heap.size() < k) {
+			heap.push_back(candidate);
+			std::push_heap(heap.begin(), heap.end());
+		}
+		else if (candidate < heap.front()) {
+			std::pop_heap(heap.begin(), heap.end());
+			heap.back() = candidate;
+			std::push_heap(heap.begin(), heap.end());
+		}
+	}
+
+	if (end - begin == 1) {
+		return;
+	}
+
+	double diff = query[node.axis] - node.coords[node.axis];
+	size_t nearBegin = diff < 0 ? begin : mid + 1;
+	size_t nearEnd = diff < 0 ? mid : end;
+	size_t farBegin = diff < 0 ? mid + 1 : begin;
+	size_t farEnd = diff < 0 ? end : mid;
+
+	this->findNearest(nearBegin, nearEnd, query, exclude, k, heap);
+	if (heap.size() < k || diff * diff <= heap.front().first) {
+		this->findNearest(farBegin, farEnd, query, exclude, k, heap);
+	}
+}
+
+double IASsure::SpatialIndex::distance(size_t index, const double query[3]) const
+{
+	double dx = query[0] - this->xs[index];
+	double dy = query[1] - this->ys[index];
+	double dz = query[2] - this->zs[index];
+
+	return dx * dx + dy * dy + dz * dz;
+}
+
+void IASsure::toUnitVector(double latitude, double longitude, double out[3])
+{
+	double phi = degToRad(latitude);
+	double lambda = degToRad(longitude);
+
+	out[0] = std::cos(phi) * std::cos(lambda);
+	out[1] = std::cos(phi) * std::sin(lambda);
+	out[2] = std::sin(phi);
+}
+
+double IASsure::unitVectorDistance(const double a[3], const double b[3])
+{
+	double cross[3] = {
+		a[1] * b[2] - a[2] * b[1],
+		a[2] * b[0] - a[0] * b[2],
+		a[0] * b[1] - a[1] * b[0],
+	};
+	double dot = a[0] * b[0] + a[1] * b[1] + a[2] * b[2];
+
+	// atan2 stays accurate for both very close and nearly antipodal points, unlike acos(dot) or asin(chord / 2)
+	return EARTH_MEAN_RADIUS_METERS * std::atan2(std::sqrt(cross[0] * cross[0] + cross[1] * cross[1] + cross[2] * cross[2]), dot);
+}
+
+size_t IASsure::maxDotProduct(const double* xs, const double* ys, const double* zs, size_t count, const double query[3], simd::InstructionSet instructionSet)
+{
+	switch (instructionSet) {
+#ifdef IASSURE_SIMD_X86
+	case simd::InstructionSet::AVX2:
+		return maxDotProductAVX2(xs, ys, zs, count, query);
+	case simd::InstructionSet::SSE2:
+		return maxDotProductSSE2(xs, ys, zs, count, query);
+#endif
+	default: {
+		double bestDot = 0;
+		return maxDotProductScalar(xs, ys, zs, 0, count, query, SpatialIndex::npos, bestDot);
+	}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,80 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include "haversine.h"
+#include "simd.h"
+
+namespace IASsure {
+	// datasets up to this size are searched using a (vectorised) linear scan, traversing the k-d tree only pays off for larger datasets
+	constexpr size_t SPATIAL_LINEAR_SCAN_THRESHOLD = 64; // in points
+	// number of nearest neighbours stored per point for hinted lookups
+	constexpr size_t SPATIAL_NEIGHBOUR_COUNT = 8;
+	// maximum number of steps taken from the hinted point towards the query before falling back to a full search
+	constexpr int SPATIAL_MAX_HINT_STEPS = 4;
+
+	// SpatialIndex provides nearest neighbour lookups for geographic coordinates using a k-d tree built over
+	// points projected onto the unit sphere. Euclidean (chord) distance between unit vectors increases monotonically
+	// with great-circle distance, so the closest point in 3D space is also the closest point according to haversine.
+	// Small datasets are scanned linearly for the largest dot product instead, which orders points identically.
+	//
+	// Lookups can be provided with a hint (e.g. the result of the previous lookup for the same aircraft). Starting at the hint,
+	// the lookup walks to the closest of the point's nearest neighbours until no neighbour is closer. The result is certainly
+	// the closest point if the query is less than half the distance to the farthest stored neighbour away from it, since any
+	// point not stored as neighbour would then be farther away from the query (triangle inequality). Otherwise, a full
+	// search is performed, so hinted lookups always return the same result as regular ones.
+	class SpatialIndex {
+	public:
+		SpatialIndex() = default;
+		SpatialIndex(const std::vector<std::pair<double, double>>& coordinates);
+
+		void build(const std::vector<std::pair<double, double>>& coordinates);
+		void clear();
+
+		size_t findClosest(double latitude, double longitude) const;
+		size_t findClosest(double latitude, double longitude, size_t hint) const;
+		size_t findClosestLinear(double latitude, double longitude, simd::InstructionSet instructionSet) const;
+		// findNearest returns the indices of (up to) k points closest to the given coordinates, ordered by distance
+		std::vector<size_t> findNearest(double latitude, double longitude, size_t k) const;
+		bool empty() const;
+		size_t size() const;
+
+		static constexpr size_t npos = static_cast<size_t>(-1);
+	private:
+		struct Node {
+			double coords[3];
+			size_t index;
+			uint8_t axis;
+		};
+
+		std::vector<Node> nodes;
+		// unit vector components of all points (structure of arrays in original order) for the linear scan
+		std::vector<double> xs;
+		std::vector<double> ys;
+		std::vector<double> zs;
+		// indices of the nearest neighbours of each point (SPATIAL_NEIGHBOUR_COUNT per point, closest first)
+		std::vector<uint32_t> neighbours;
+		// squared chord distance to the farthest stored neighbour of each point, infinite if all other points are stored
+		std::vector<double> neighbourRadii;
+
+		void build(size_t begin, size_t end);
+		void buildNeighbours();
+		size_t search(const double query[3]) const;
+		void findClosest(size_t begin, size_t end, const double query[3], size_t& best, double& bestDistance) const;
+		void findNearest(size_t begin, size_t end, const double query[3], size_t exclude, size_t k, std::vector<std::pair<double, size_t>>& heap) const;
+		double distance(size_t index, const double query[3]) const;
+	};
+
+	void toUnitVector(double latitude, double longitude, double out[3]);
+	// great-circle distance (in m) between two unit vectors
+	double unitVectorDistance(const double a[3], const double b[3]);
+	// maxDotProduct returns the index of the vector with the largest dot product with query, resolving ties to the lowest index.
+	// all instruction sets yield identical results, instructionSet must be supported by the CPU.
+	size_t maxDotProduct(const double* xs, const double* ys, const double* zs, size_t count, const double query[3], simd::InstructionSet instructionSet);
+}
\ No newline at end of file
@@ -37,3 +37,221 @@ void IASsure::thread::PeriodicAction::threadFn()
 		this->f();
 	}
 }
+
+
+IASsure::thread::ThreadPool::ThreadPool(size_t workers) :
+	queued(0),
+	nextQueue(0),
+	shouldStop(false)
+{
+	for (size_t i = 0; i < workers; i++) {
+		this->queues.push_back(std::make_unique<Queue>());
+	}
+	for (size_t i = 0; i < workers; i++) {
+		this->threads.emplace_back(&IASsure::thread::ThreadPool::threadFn, this, i);
+	}
+}
+
+IASsure::thread::ThreadPool::~ThreadPool()
+{
+	this->stop();
+}
+
+void IASsure::thread::ThreadPool::parallelFor(size_t count, size_t grainSize, const std::function<void(size_t, size_t)>& f)
+{
+	if (grainSize == 0) {
+		grainSize = 1;
+	}
+
+	size_t ranges = (count + grainSize - 1) / grainSize;
+	if (ranges <= 1 || this->queues.empty()) {
+		for (size_t begin = 0; begin < count; begin += grainSize) {
+			f(begin, (std::min)(begin + grainSize, count));
+		}
+		return;
+	}
+
+	// shared by all ranges, stays alive until the last range completed as the calling thread waits for it below
+	struct Job {
+		std::atomic<size_t> remaining;
+		std::mutex m;
+		std::condition_variable c;
+		std::exception_ptr exception;
+	} job;
+	job.remaining = ranges;
+
+	std::vector<std::function<void()>> tasks;
+	tasks.reserve(ranges);
+	for (size_t begin = 0; begin < count; begin += grainSize) {
+		size_t end = (std::min)(begin + grainSize, count);
+		tasks.push_back([&job, &f, begin, end]() {
+			try {
+				f(begin, end);
+			}
+			catch (...) {
+				std::scoped_lock<std::mutex> lock(job.m);
+				if (job.exception == nullptr) {
+					job.exception = std::current_exception();
+				}
+			}
+
+			// decremented while locked, the job must not be destroyed before notifying
+			std::scoped_lock<std::mutex> lock(job.m);
+			if (--job.remaining == 0) {
+				job.c.notify_all();
+			}
+			});
+	}
+	this->push(tasks);
+
+	// help processing until all ranges have been taken, then wait for the ones still running on workers
+	size_t queue = this->nextQueue++ % this->queues.size();
+	while (job.remaining > 0 && this->runNext(queue)) {
+	}
+
+	std::unique_lock<std::mutex> lock(job.m);
+	job.c.wait(lock, [&job]() { return job.remaining == 0; });
+
+	if (job.exception != nullptr) {
+		std::rethrow_exception(job.exception);
+	}
+}
+
+size_t IASsure::thread::ThreadPool::size() const
+{
+	return this->queues.size();
+}
+
+void IASsure::thread::ThreadPool::stop()
+{
+	{
+		std::scoped_lock<std::mutex> lock(this->m);
+		if (this->shouldStop) {
+			return;
+		}
+		this->shouldStop = true;
+	}
+	this->c.notify_all();
+
+	for (auto& t : this->threads) {
+		t.join();
+	}
+	this->threads.clear();
+}
+
+void IASsure::thread::ThreadPool::push(std::vector<std::function<void()>>& tasks)
+{
+	// spread tasks across all queues, each worker starts with its own share and steals once done
+	size_t first = this->nextQueue++;
+	for (size_t i = 0; i < tasks.size(); i++) {
+		Queue& queue = *this->queues[(first + i) % this->queues.size()];
+		std::scoped_lock<std::mutex> lock(queue.m);
+		queue.tasks.push_back(std::move(tasks[i]));
+	}
+
+	{
+		std::scoped_lock<std::mutex> lock(this->m);
+		this->queued += tasks.size();
+	}
+	this->c.notify_all();
+}
+
+bool IASsure::thread::ThreadPool::runNext(size_t queue)
+{
+	std::function<void()> task;
+	for (size_t i = 0; i < this->queues.size() && !task; i++) {
+		Queue& q = *this->queues[(queue + i) % this->queues.size()];
+		std::scoped_lock<std::mutex> lock(q.m);
+		if (q.tasks.empty()) {
+			continue;
+		}
+
+		if (i == 0) {
+			// own queue, most recently pushed task first
+			task = std::move(q.tasks.back());
+			q.tasks.pop_back();
+		}
+		else {
+			// steal the oldest task of another queue
+			task = std::move(q.tasks.front());
+			q.tasks.pop_front();
+		}
+	}
+
+	if (!task) {
+		return false;
+	}
+
+	this->queued--;
+	task();
+	return true;
+}
+
+void IASsure::thread::ThreadPool::threadFn(size_t queue)
+{
+	for (;;) {
+		if (this->runNext(queue)) {
+			continue;
+		}
+
+		std::unique_lock<std::mutex> lock(this->m);
+		this->c.wait(lock, [this]() { return this->shouldStop || this->queued > 0; });
+		if (this->shouldStop) {
+			return;
+		}
+	}
+}
+
+IASsure::thread::RingBuffer::RingBuffer(size_t capacity) :
+	written(0),
+	consumed(0)
+{
+	size_t size = 1;
+	while (size < capacity) {
+		size <<= 1;
+	}
+
+	this->buffer.resize(size);
+	this->mask = size - 1;
+}
+
+bool IASsure::thread::RingBuffer::write(std::string_view data)
+{
+	size_t w = this->written.load(std::memory_order_relaxed);
+	// acquire ensures the consumer finished copying the space it released before it is overwritten
+	size_t r = this->consumed.load(std::memory_order_acquire);
+	if (data.size() > this->buffer.size() - (w - r)) {
+		return false;
+	}
+
+	size_t offset = w & this->mask;
+	size_t first = (std::min)(data.size(), this->buffer.size() - offset);
+	std::memcpy(this->buffer.data() + offset, data.data(), first);
+	std::memcpy(this->buffer.data(), data.data() + first, data.size() - first);
+
+	this->written.store(w + data.size(), std::memory_order_release);
+	return true;
+}
+
+size_t IASsure::thread::RingBuffer::read(std::string& out)
+{
+	size_t r = this->consumed.load(std::memory_order_relaxed);
+	size_t w = this->written.load(std::memory_order_acquire);
+	size_t size = w - r;
+	if (size == 0) {
+		return 0;
+	}
+
+	size_t offset = r & this->mask;
+	size_t first = (std::min)(size, this->buffer.size() - offset);
+	out.append(this->buffer.data() + offset, first);
+	out.append(this->buffer.data(), size - first);
+
+	this->consumed.store(w, std::memory_order_release);
+	return size;
+}
+
+size_t IASsure::thread::RingBuffer::capacity() const
+{
+	return this->buffer.size();
+}
\ No newline at end of file
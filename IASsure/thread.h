@@ -1,10 +1,20 @@
 #pragma once
 
+#include <algorithm>
+#include <atomic>
 #include <chrono>
 #include <condition_variable>
+#include <cstddef>
+#include <cstring>
+#include <deque>
+#include <exception>
 #include <functional>
+#include <memory>
 #include <mutex>
+#include <string>
+#include <string_view>
 #include <thread>
+#include <vector>
 
 namespace IASsure {
 	namespace thread {
@@ -27,5 +37,61 @@ namespace IASsure {
 			bool wait(std::chrono::milliseconds delay);
 			void threadFn();
 		};
+
+		// ThreadPool runs tasks on a fixed number of worker threads. each worker owns a queue, taking its own tasks from the back and
+		// stealing from the front of other workers' queues once its own queue is empty, so unevenly sized tasks keep all workers busy.
+		class ThreadPool {
+		public:
+			// workers may be 0, running all tasks on the thread calling parallelFor
+			ThreadPool(size_t workers);
+			~ThreadPool();
+
+			// parallelFor calls f(begin, end) for consecutive ranges of at most grainSize indices covering [0, count), returning once all
+			// ranges have been processed. the calling thread processes ranges as well. rethrows the first exception thrown by f.
+			void parallelFor(size_t count, size_t grainSize, const std::function<void(size_t, size_t)>& f);
+			// size returns the number of worker threads, excluding threads calling parallelFor
+			size_t size() const;
+			// stop finishes the running tasks and joins all workers, remaining parallelFor calls are processed by their calling threads
+			void stop();
+		private:
+			struct Queue {
+				std::mutex m;
+				std::deque<std::function<void()>> tasks;
+			};
+
+			std::vector<std::unique_ptr<Queue>> queues;
+			std::vector<std::thread> threads;
+			// number of queued tasks, guarded by m for waking idle workers
+			std::atomic<size_t> queued;
+			std::atomic<size_t> nextQueue;
+			std::mutex m;
+			std::condition_variable c;
+			bool shouldStop;
+
+			void push(std::vector<std::function<void()>>& tasks);
+			// runNext runs a single task from the given queue or stolen from any other queue, returning false if all queues are empty
+			bool runNext(size_t queue);
+			void threadFn(size_t queue);
+		};
+
+		// RingBuffer is a lock-free queue of bytes for exactly one producer and one consumer thread, neither of them ever blocking.
+		// each write is either stored completely or not at all, a read never returns part of a write.
+		class RingBuffer {
+		public:
+			// capacity is rounded up to the next power of two
+			RingBuffer(size_t capacity);
+
+			// write appends the data, returning false without storing anything if not enough space is available. producer only
+			bool write(std::string_view data);
+			// read appends all available data to out, returning the number of bytes read. consumer only
+			size_t read(std::string& out);
+			size_t capacity() const;
+		private:
+			std::vector<char> buffer;
+			size_t mask;
+			// total number of bytes written and read, each only modified by the producer and consumer respectively
+			std::atomic<size_t> written;
+			std::atomic<size_t> consumed;
+		};
 	}
 }
\ No newline at end of file
@@ -1,9 +1,19 @@
 #include "weather.h"
 
-void IASsure::from_json(const nlohmann::json& j, Weather& weather)
+namespace {
+	// generations are unique across all Weather instances, a hint can never match a dataset it wasn't created with
+	std::atomic<uint64_t> nextGeneration = 1;
+
+	// header of the binary weather cache: magic, version and checksum of the remaining data (source hash, payload size and payload)
+	constexpr size_t CACHE_HEADER_SIZE = sizeof(uint32_t) + sizeof(uint32_t) + sizeof(uint64_t);
+}
+
+void IASsure::from_json(const nlohmann::json& j, WeatherDataset& dataset)
 {
-	j.at("info").get_to<IASsure::WeatherInfo>(weather.info);
-	j.at("data").get_to<std::map<std::string, IASsure::WeatherReferencePoint>>(weather.points);
+	j.at("info").get_to<IASsure::WeatherInfo>(dataset.info);
+
+	auto points = j.at("data").get<std::map<std::string, IASsure::WeatherReferencePoint>>();
+	dataset.build(std::vector<std::pair<std::string, IASsure::WeatherReferencePoint>>(std::make_move_iterator(points.begin()), std::make_move_iterator(points.end())));
 }
 
 void IASsure::from_json(const nlohmann::json& j, WeatherInfo& info)
@@ -18,9 +28,12 @@ void IASsure::from_json(const nlohmann::json& j, WeatherReferencePoint& point)
 	point.latitude = std::stod(coords.at("lat").get<std::string>());
 	point.longitude = std::stod(coords.at("long").get<std::string>());
 
+	std::vector<std::pair<int, IASsure::WeatherReferenceLevel>> levels;
 	for (auto const& [key, val] : j.at("levels").items()) {
-		point.levels.insert({ std::stoi(key), val.get<IASsure::WeatherReferenceLevel>() });
+		levels.push_back({ std::stoi(key), val.get<IASsure::WeatherReferenceLevel>() });
 	}
+
+	point.buildLevelTable(std::move(levels));
 }
 
 void IASsure::from_json(const nlohmann::json& j, IASsure::WeatherReferenceLevel& level)
@@ -30,88 +43,605 @@ void IASsure::from_json(const nlohmann::json& j, IASsure::WeatherReferenceLevel&
 	level.windDirection = std::stod(j.at("windhdg").get<std::string>());
 }
 
-IASsure::Weather::Weather() : hash(-1)
+IASsure::Weather::Weather() : dataset(nullptr), skipped(0), threadPool(nullptr)
 {
 }
 
-IASsure::Weather::Weather(std::string rawJSON) : hash(-1)
+IASsure::Weather::Weather(std::string rawJSON) : dataset(nullptr), skipped(0), threadPool(nullptr)
 {
 	this->parse(rawJSON);
 }
 
-IASsure::Weather::Weather(std::istream& rawJSON) : hash(-1)
+IASsure::Weather::Weather(std::istream& rawJSON) : dataset(nullptr), skipped(0), threadPool(nullptr)
 {
 	this->parse(rawJSON);
 }
 
-void IASsure::Weather::parse(std::string rawJSON)
+bool IASsure::Weather::parse(const std::string& rawJSON)
 {
-	this->update(nlohmann::json::parse(rawJSON));
+	uint64_t hash = IASsure::xxh64(rawJSON);
+
+	// check if hash matches currently stored data as we don't need to parse weather data if no update is required
+	std::shared_ptr<const WeatherDataset> current = this->dataset.load();
+	if (current != nullptr && current->hash == hash) {
+		this->skipped++;
+		return false;
+	}
+
+	// build the new dataset completely before publishing it, lookups continue to use the previous data in the meantime
+	auto dataset = std::make_shared<WeatherDataset>();
+	IASsure::WeatherParser parser(*dataset);
+	nlohmann::json::sax_parse(rawJSON, &parser);
+	dataset->hash = hash;
+
+	this->publish(std::move(dataset));
+	return true;
 }
 
-void IASsure::Weather::parse(std::istream& rawJSON)
+bool IASsure::Weather::parse(std::istream& rawJSON)
 {
-	this->update(nlohmann::json::parse(rawJSON));
+	return this->parse(std::string(std::istreambuf_iterator<char>(rawJSON), std::istreambuf_iterator<char>()));
 }
 
 void IASsure::Weather::clear()
 {
-	std::scoped_lock<std::shared_mutex> lock(this->mutex);
-	this->points.clear();
-	this->hash = 0;
+	// waits for a grid rebuild of the current data, which would otherwise republish it afterwards
+	std::lock_guard<std::mutex> lock(this->publishMutex);
+	this->dataset.store(nullptr);
 }
 
 IASsure::WeatherReferenceLevel IASsure::Weather::findClosest(double latitude, double longitude, int altitude) const
 {
-	if (!this->mutex.try_lock_shared()) {
-		// cannot acquire read lock (weather data is being updated right now), fallback to no winds in order to not block EuroScope
-		return WeatherReferenceLevel();
+	std::shared_ptr<const WeatherDataset> dataset = this->dataset.load();
+	if (dataset == nullptr) {
+		// no weather data available, return empty reference level containing zero winds/temperature
+		return IASsure::WeatherReferenceLevel();
+	}
+
+	return dataset->findClosest(latitude, longitude, altitude);
+}
+
+IASsure::WeatherReferenceLevel IASsure::Weather::findClosest(double latitude, double longitude, int altitude, WeatherLookupHint& hint) const
+{
+	std::shared_ptr<const WeatherDataset> dataset = this->dataset.load();
+	if (dataset == nullptr) {
+		// no weather data available, return empty reference level containing zero winds/temperature
+		return IASsure::WeatherReferenceLevel();
+	}
+
+	return dataset->findClosest(latitude, longitude, altitude, hint);
+}
+
+std::shared_ptr<const IASsure::WeatherDataset> IASsure::Weather::current() const
+{
+	return this->dataset.load();
+}
+
+uint64_t IASsure::Weather::generation() const
+{
+	std::shared_ptr<const WeatherDataset> dataset = this->dataset.load();
+	return dataset == nullptr ? 0 : dataset->generation;
+}
+
+size_t IASsure::Weather::skippedParses() const
+{
+	return this->skipped.load();
+}
+
+void IASsure::Weather::setGridSettings(const WeatherGridSettings& settings)
+{
+	// copy and republish while holding the lock, so a dataset published concurrently is never replaced by the copy of its predecessor
+	std::lock_guard<std::mutex> lock(this->publishMutex);
+	if (this->gridSettings == settings) {
+		return;
+	}
+
+	this->gridSettings = settings;
+	std::shared_ptr<const WeatherDataset> current = this->dataset.load();
+	if (current == nullptr) {
+		return;
+	}
+
+	// published datasets are immutable, republish a copy of the current data with its grid rebuilt (or removed)
+	auto dataset = std::make_shared<WeatherDataset>(*current);
+	dataset->grid = nullptr;
+	this->publishLocked(std::move(dataset));
+}
+
+void IASsure::Weather::setThreadPool(thread::ThreadPool* pool)
+{
+	// waits for a grid build still using the previous pool
+	std::lock_guard<std::mutex> lock(this->publishMutex);
+	this->threadPool = pool;
+}
+
+bool IASsure::Weather::hasGrid() const
+{
+	std::shared_ptr<const WeatherDataset> dataset = this->dataset.load();
+	return dataset != nullptr && dataset->grid != nullptr;
+}
+
+std::string IASsure::Weather::serialize() const
+{
+	std::shared_ptr<const WeatherDataset> dataset = this->dataset.load();
+	if (dataset == nullptr) {
+		throw std::domain_error("no weather data available");
+	}
+
+	return serialize(*dataset);
+}
+
+std::string IASsure::Weather::serialize(const WeatherDataset& dataset)
+{
+	binary::Writer payload;
+	payload.write(dataset.info.date);
+	payload.write(dataset.info.datestring);
+	payload.write((uint64_t)dataset.points.size());
+	for (auto const& point : dataset.points) {
+		payload.write(point.latitude);
+		payload.write(point.longitude);
+		payload.write((uint32_t)point.levels.size());
+		for (size_t i = 0; i < point.levels.size(); i++) {
+			payload.write((int32_t)point.flightLevels[i]);
+			payload.write(point.levels[i].temperature);
+			payload.write(point.levels[i].windSpeed);
+			payload.write(point.levels[i].windDirection);
+		}
+	}
+
+	binary::Writer body;
+	body.write(dataset.hash);
+	body.write((uint64_t)payload.data.size());
+	body.data.append(payload.data);
+
+	binary::Writer cache;
+	cache.write(WEATHER_CACHE_MAGIC);
+	cache.write(WEATHER_CACHE_VERSION);
+	cache.write(IASsure::xxh64(body.data));
+	cache.data.append(body.data);
+
+	return cache.data;
+}
+
+void IASsure::Weather::deserialize(std::string_view data)
+{
+	binary::Reader header(data.substr(0, CACHE_HEADER_SIZE));
+	if (header.read<uint32_t>() != WEATHER_CACHE_MAGIC) {
+		throw std::invalid_argument("invalid weather cache magic");
+	}
+	if (header.read<uint32_t>() != WEATHER_CACHE_VERSION) {
+		throw std::invalid_argument("unsupported weather cache version");
+	}
+	uint64_t checksum = header.read<uint64_t>();
+
+	std::string_view body = data.substr(CACHE_HEADER_SIZE);
+	if (IASsure::xxh64(body) != checksum) {
+		throw std::invalid_argument("weather cache checksum mismatch");
 	}
 
+	binary::Reader reader(body);
+	auto dataset = std::make_shared<WeatherDataset>();
+	dataset->hash = reader.read<uint64_t>();
+	if (reader.read<uint64_t>() != body.size() - 2 * sizeof(uint64_t)) {
+		throw std::invalid_argument("weather cache payload size mismatch");
+	}
+
+	dataset->info.date = reader.readString();
+	dataset->info.datestring = reader.readString();
+
+	// each point requires at least its coordinates and level count
+	uint64_t pointCount = reader.read<uint64_t>();
+	reader.require(pointCount, 2 * sizeof(double) + sizeof(uint32_t));
+	dataset->points.resize(pointCount);
+
+	for (auto& point : dataset->points) {
+		point.latitude = reader.read<double>();
+		point.longitude = reader.read<double>();
+
+		uint32_t levelCount = reader.read<uint32_t>();
+		reader.require(levelCount, sizeof(int32_t) + 3 * sizeof(double));
+		std::vector<std::pair<int, WeatherReferenceLevel>> levels(levelCount);
+		for (auto& [fl, level] : levels) {
+			fl = reader.read<int32_t>();
+			level.temperature = reader.read<double>();
+			level.windSpeed = reader.read<double>();
+			level.windDirection = reader.read<double>();
+		}
+
+		// level tables are rebuilt instead of stored, validating the flight levels in the process
+		try {
+			point.buildLevelTable(std::move(levels));
+		}
+		catch (std::out_of_range const& ex) {
+			throw std::invalid_argument(ex.what());
+		}
+	}
+
+	if (!reader.empty()) {
+		throw std::invalid_argument("unexpected trailing weather cache data");
+	}
+
+	dataset->buildIndex();
+
+	this->publish(std::move(dataset));
+}
+
+void IASsure::Weather::publish(std::shared_ptr<WeatherDataset> dataset)
+{
+	std::lock_guard<std::mutex> lock(this->publishMutex);
+	this->publishLocked(std::move(dataset));
+}
+
+void IASsure::Weather::publishLocked(std::shared_ptr<WeatherDataset> dataset)
+{
+	if (this->gridSettings.enabled && dataset->grid == nullptr) {
+		try {
+			dataset->grid = std::make_shared<const WeatherGrid>(dataset->points, dataset->index, this->gridSettings, this->threadPool);
+		}
+		catch (std::exception const&) {
+			// grid unavailable for this data (no levels or too large), lookups fall back to the closest reference point
+			dataset->grid = nullptr;
+		}
+	}
+
+	dataset->generation = nextGeneration++;
+	this->dataset.store(std::move(dataset));
+}
+
+IASsure::WeatherReferenceLevel IASsure::WeatherDataset::findClosest(double latitude, double longitude, int altitude) const
+{
 	if (this->points.empty()) {
-		this->mutex.unlock_shared();
+		// no reference points available, return empty reference level containing zero winds/temperature
+		return IASsure::WeatherReferenceLevel();
+	}
+
+	if (this->grid != nullptr) {
+		return this->grid->interpolate(latitude, longitude, altitude);
+	}
+
+	// resolve the altitude level in place, only the (trivially copyable) level leaves the lookup
+	return this->points[this->index.findClosest(latitude, longitude)].findClosest(altitude);
+}
 
+IASsure::WeatherReferenceLevel IASsure::WeatherDataset::findClosest(double latitude, double longitude, int altitude, WeatherLookupHint& hint) const
+{
+	if (this->points.empty()) {
 		// no reference points available, return empty reference level containing zero winds/temperature
 		return IASsure::WeatherReferenceLevel();
 	}
 
-	double distance = -1;
-	WeatherReferencePoint closest;
+	if (this->grid != nullptr) {
+		// grid lookups are O(1) and don't require a hint
+		return this->grid->interpolate(latitude, longitude, altitude);
+	}
+
+	// hints of previous datasets refer to different reference points, perform a full search instead
+	size_t point = this->index.findClosest(latitude, longitude, hint.generation == this->generation ? hint.point : SpatialIndex::npos);
+	hint.generation = this->generation;
+	hint.point = point;
+
+	return this->points[point].findClosest(altitude);
+}
 
-	for (auto const& [wp, point] : this->points) {
-		double d = IASsure::haversine(latitude, longitude, point.latitude, point.longitude);
-		if (distance < 0 || d < distance) {
-			distance = d;
-			closest = point;
+void IASsure::WeatherDataset::build(std::vector<std::pair<std::string, WeatherReferencePoint>> points)
+{
+	// order reference points by their name, only keeping the last point parsed for duplicate names
+	std::stable_sort(points.begin(), points.end(), [](const auto& a, const auto& b) {
+		return a.first < b.first;
+		});
+
+	this->points.clear();
+	this->points.reserve(points.size());
+
+	for (size_t i = 0; i < points.size(); i++) {
+		if (i + 1 < points.size() && points[i].first == points[i + 1].first) {
+			continue;
 		}
+
+		this->points.push_back(std::move(points[i].second));
+	}
+
+	this->buildIndex();
+}
+
+void IASsure::WeatherDataset::buildIndex()
+{
+	std::vector<std::pair<double, double>> coordinates;
+	coordinates.reserve(this->points.size());
+	for (auto const& point : this->points) {
+		coordinates.push_back({ point.latitude, point.longitude });
+	}
+
+	this->index.build(coordinates);
+}
+
+IASsure::WeatherParser::WeatherParser(WeatherDataset& dataset) :
+	dataset(dataset),
+	nextContext(Context::None),
+	nextField(Field::None),
+	skipDepth(0),
+	point(),
+	flightLevel(0),
+	level()
+{
+}
+
+bool IASsure::WeatherParser::null()
+{
+	return this->skipValue();
+}
+
+bool IASsure::WeatherParser::boolean(bool)
+{
+	return this->skipValue();
+}
+
+bool IASsure::WeatherParser::number_integer(nlohmann::json::number_integer_t)
+{
+	return this->skipValue();
+}
+
+bool IASsure::WeatherParser::number_unsigned(nlohmann::json::number_unsigned_t)
+{
+	return this->skipValue();
+}
+
+bool IASsure::WeatherParser::number_float(nlohmann::json::number_float_t, const nlohmann::json::string_t&)
+{
+	return this->skipValue();
+}
+
+bool IASsure::WeatherParser::string(nlohmann::json::string_t& val)
+{
+	if (this->skipDepth > 0 || this->nextContext == Context::Unknown) {
+		return true;
 	}
 
-	// closest reference point has been found, unlock weather map for updates as we have a copy of altitude data available locally
-	this->mutex.unlock_shared();
+	// all values of the weather data are transmitted as strings
+	switch (this->nextField) {
+	case Field::Date:
+		this->dataset.info.date = std::move(val);
+		break;
+	case Field::Datestring:
+		this->dataset.info.datestring = std::move(val);
+		break;
+	case Field::Latitude:
+		this->point.latitude = std::stod(val);
+		break;
+	case Field::Longitude:
+		this->point.longitude = std::stod(val);
+		break;
+	case Field::Temperature:
+		this->level.temperature = std::stod(val);
+		break;
+	case Field::WindSpeed:
+		this->level.windSpeed = std::stod(val);
+		break;
+	case Field::WindDirection:
+		this->level.windDirection = std::stod(val);
+		break;
+	default:
+		throw std::invalid_argument("unexpected string in weather data");
+	}
+
+	this->nextField = Field::None;
+	return true;
+}
+
+bool IASsure::WeatherParser::binary(nlohmann::json::binary_t&)
+{
+	throw std::invalid_argument("unexpected binary value in weather data");
+}
+
+bool IASsure::WeatherParser::start_object(std::size_t)
+{
+	if (this->skipDepth > 0) {
+		this->skipDepth++;
+		return true;
+	}
+
+	Context context = this->frames.empty() ? Context::Document : this->nextContext;
+	switch (context) {
+	case Context::Unknown:
+		this->skipDepth = 1;
+		return true;
+	case Context::None:
+		throw std::invalid_argument("unexpected object in weather data");
+	case Context::Point:
+		this->point = IASsure::WeatherReferencePoint();
+		this->levels.clear();
+		break;
+	case Context::Levels:
+		this->levels.clear();
+		break;
+	case Context::Level:
+		this->level = IASsure::WeatherReferenceLevel();
+		break;
+	default:
+		break;
+	}
+
+	this->frames.push_back({ context, 0 });
+	this->nextContext = Context::None;
+	this->nextField = Field::None;
+	return true;
+}
+
+bool IASsure::WeatherParser::key(nlohmann::json::string_t& val)
+{
+	if (this->skipDepth > 0) {
+		return true;
+	}
+
+	switch (this->frames.back().context) {
+	case Context::Document:
+		if (val == "info") {
+			this->expect(Context::Info, 1);
+		}
+		else if (val == "data") {
+			this->expect(Context::Data, 2);
+		}
+		else {
+			this->expect(Context::Unknown, 0);
+		}
+		break;
+	case Context::Info:
+		if (val == "date") {
+			this->expect(Field::Date, 1);
+		}
+		else if (val == "datestring") {
+			this->expect(Field::Datestring, 2);
+		}
+		else {
+			this->expect(Context::Unknown, 0);
+		}
+		break;
+	case Context::Data:
+		this->pointName = val;
+		this->expect(Context::Point, 0);
+		break;
+	case Context::Point:
+		if (val == "coords") {
+			this->expect(Context::Coords, 1);
+		}
+		else if (val == "levels") {
+			this->expect(Context::Levels, 2);
+		}
+		else {
+			this->expect(Context::Unknown, 0);
+		}
+		break;
+	case Context::Coords:
+		if (val == "lat") {
+			this->expect(Field::Latitude, 1);
+		}
+		else if (val == "long") {
+			this->expect(Field::Longitude, 2);
+		}
+		else {
+			this->expect(Context::Unknown, 0);
+		}
+		break;
+	case Context::Levels:
+		this->flightLevel = std::stoi(val);
+		this->expect(Context::Level, 0);
+		break;
+	case Context::Level:
+		if (val == "T(K)") {
+			this->expect(Field::Temperature, 1);
+		}
+		else if (val == "windspeed") {
+			this->expect(Field::WindSpeed, 2);
+		}
+		else if (val == "windhdg") {
+			this->expect(Field::WindDirection, 4);
+		}
+		else {
+			this->expect(Context::Unknown, 0);
+		}
+		break;
+	default:
+		break;
+	}
 
-	return closest.findClosest(altitude);
+	return true;
 }
 
-void IASsure::Weather::update(const nlohmann::json& j)
+bool IASsure::WeatherParser::end_object()
 {
-	size_t newHash = 0;
-	{
-		std::shared_lock<std::shared_mutex> slock(this->mutex, std::defer_lock);
-		std::scoped_lock lock(slock);
+	if (this->skipDepth > 0) {
+		this->skipDepth--;
+		return true;
+	}
 
-		newHash = std::hash<nlohmann::json> {}(j);
-		// check if hash matches currently stored data as we don't need to exclusively lock weather data if no update is required
-		if (this->hash == newHash) {
-			return;
+	Frame frame = this->frames.back();
+	this->frames.pop_back();
+	this->nextContext = Context::None;
+	this->nextField = Field::None;
+
+	switch (frame.context) {
+	case Context::Document:
+		if (frame.found != 3) {
+			throw std::invalid_argument("weather data is missing info or data");
 		}
+
+		this->dataset.build(std::move(this->points));
+		break;
+	case Context::Info:
+		if (frame.found != 3) {
+			throw std::invalid_argument("weather info is missing date or datestring");
+		}
+		break;
+	case Context::Point:
+		if (frame.found != 3) {
+			throw std::invalid_argument("weather reference point is missing coords or levels");
+		}
+
+		this->point.buildLevelTable(std::move(this->levels));
+		this->points.push_back({ std::move(this->pointName), std::move(this->point) });
+		break;
+	case Context::Coords:
+		if (frame.found != 3) {
+			throw std::invalid_argument("weather reference point is missing lat or long");
+		}
+		break;
+	case Context::Level:
+		if (frame.found != 7) {
+			throw std::invalid_argument("weather reference level is missing T(K), windspeed or windhdg");
+		}
+
+		this->levels.push_back({ this->flightLevel, this->level });
+		break;
+	default:
+		break;
 	}
 
-	std::scoped_lock<std::shared_mutex> lock(this->mutex);
+	return true;
+}
 
-	this->points.clear();
+bool IASsure::WeatherParser::start_array(std::size_t)
+{
+	if (this->skipDepth > 0) {
+		this->skipDepth++;
+		return true;
+	}
 
-	j.get_to<IASsure::Weather>(*this);
-	this->hash = newHash;
+	if (this->nextContext != Context::Unknown) {
+		throw std::invalid_argument("unexpected array in weather data");
+	}
+
+	this->skipDepth = 1;
+	return true;
+}
+
+bool IASsure::WeatherParser::end_array()
+{
+	this->skipDepth--;
+	return true;
+}
+
+bool IASsure::WeatherParser::skipValue()
+{
+	// non-string scalars are only valid as values of ignored keys
+	if (this->skipDepth > 0 || this->nextContext == Context::Unknown) {
+		return true;
+	}
+
+	throw std::invalid_argument("unexpected value in weather data");
+}
+
+void IASsure::WeatherParser::expect(Context context, unsigned int bit)
+{
+	this->frames.back().found |= bit;
+	this->nextContext = context;
+	this->nextField = Field::None;
+}
+
+void IASsure::WeatherParser::expect(Field field, unsigned int bit)
+{
+	this->frames.back().found |= bit;
+	this->nextContext = Context::None;
+	this->nextField = field;
 }
 
 IASsure::WeatherReferenceLevel IASsure::WeatherReferencePoint::findClosest(int altitude) const
@@ -123,27 +653,61 @@ IASsure::WeatherReferenceLevel IASsure::WeatherReferencePoint::findClosest(int a
 
 	long fl = std::lround((double)altitude / 100.0);
 
-	int prevDiff = -1;
-	// initialise with highest level available in case the altitude is greater than highest flight level available.
-	// levels map contains ordered (ascending) keys, highest available data will be last in map.
-	// reverse iterator starts from the end of the map, returning last item.
-	IASsure::WeatherReferenceLevel closest = this->levels.rbegin()->second;
-	for (auto const& [refFL, level] : this->levels) {
-		if (fl == refFL) {
-			return level;
-		}
+	// clamp to lowest/highest level available in case the altitude is outside of the flight levels available
+	long i = std::clamp(fl - this->lowestFlightLevel, 0l, (long)this->closestLevels.size() - 1);
 
-		int diff = std::abs(refFL - fl);
-		if (prevDiff > 0 && diff > prevDiff) {
-			// distances will continue increasing, no need to search further
-			break;
-		}
+	return this->levels[this->closestLevels[i]];
+}
 
-		prevDiff = diff;
-		closest = level;
+void IASsure::WeatherReferencePoint::buildLevelTable(std::vector<std::pair<int, WeatherReferenceLevel>> levels)
+{
+	this->levels.clear();
+	this->flightLevels.clear();
+	this->closestLevels.clear();
+	this->lowestFlightLevel = 0;
+
+	// order levels (ascending) by flight level, only keeping the first level parsed for duplicate flight levels
+	std::stable_sort(levels.begin(), levels.end(), [](const auto& a, const auto& b) {
+		return a.first < b.first;
+		});
+	levels.erase(std::unique(levels.begin(), levels.end(), [](const auto& a, const auto& b) {
+		return a.first == b.first;
+		}), levels.end());
+
+	if (levels.empty()) {
+		return;
+	}
+
+	if (levels.size() > UINT16_MAX) {
+		throw std::out_of_range("too many levels for reference point");
+	}
+
+	// lowest available data will be first, highest available data will be last in sorted levels
+	int lowest = levels.front().first;
+	int highest = levels.back().first;
+	if ((long long)highest - (long long)lowest >= MAX_LEVEL_TABLE_SIZE) {
+		throw std::out_of_range("flight levels of reference point outside of supported range");
 	}
 
-	return closest;
+	this->flightLevels.reserve(levels.size());
+	this->levels.reserve(levels.size());
+	for (auto const& [fl, level] : levels) {
+		this->flightLevels.push_back(fl);
+		this->levels.push_back(level);
+	}
+
+	this->lowestFlightLevel = lowest;
+	this->closestLevels.resize((size_t)(highest - lowest) + 1);
+
+	uint16_t closest = 0;
+	for (int fl = lowest; fl <= highest; fl++) {
+		// advance to the next level as soon as it is at least as close as the current one, resolving ties towards the higher level
+		while (closest + 1 < (int)this->flightLevels.size() && this->flightLevels[closest + 1] - fl <= fl - this->flightLevels[closest]) {
+			closest++;
+		}
+
+		this->closestLevels[fl - lowest] = closest;
+	}
 }
 
 bool IASsure::WeatherReferenceLevel::isZero()
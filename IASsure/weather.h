@@ -1,17 +1,48 @@
 #pragma once
 
+#include <algorithm>
+#include <atomic>
 #include <cmath>
+#include <cstdint>
+#include <cstring>
 #include <istream>
+#include <iterator>
 #include <map>
+#include <memory>
+#include <mutex>
 #include <string>
-#include <shared_mutex>
+#include <string_view>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
 
 #include <nlohmann/json.hpp>
 
+#include "binary.h"
+#include "grid.h"
+#include "hash.h"
 #include "haversine.h"
-#include "http.h"
+#include "spatial.h"
+#include "thread.h"
 
 namespace IASsure {
+	constexpr long long MAX_LEVEL_TABLE_SIZE = 10000; // in flight levels
+	constexpr uint32_t WEATHER_CACHE_MAGIC = 0x57534149; // "IASW"
+	// version of the binary weather cache format, increase on any change to the layout
+	constexpr uint32_t WEATHER_CACHE_VERSION = 2;
+
+	class Weather;
+	class WeatherDataset;
+	class WeatherInfo;
+	class WeatherParser;
+	class WeatherReferenceLevel;
+	class WeatherReferencePoint;
+
+	void from_json(const nlohmann::json& j, WeatherDataset& dataset);
+	void from_json(const nlohmann::json& j, WeatherInfo& info);
+	void from_json(const nlohmann::json& j, WeatherReferencePoint& point);
+	void from_json(const nlohmann::json& j, WeatherReferenceLevel& level);
+
 	class WeatherReferenceLevel {
 	public:
 		double temperature;
@@ -31,9 +62,21 @@ namespace IASsure {
 	private:
 		double latitude;
 		double longitude;
-		std::map<int, WeatherReferenceLevel> levels;
+		// levels ordered (ascending) by flight level
+		std::vector<WeatherReferenceLevel> levels;
+		// flight levels of the levels stored above
+		std::vector<int> flightLevels;
+		// dense table mapping each flight level between the lowest and highest available level to the index of the closest level
+		std::vector<uint16_t> closestLevels;
+		int lowestFlightLevel;
+
+		void buildLevelTable(std::vector<std::pair<int, WeatherReferenceLevel>> levels);
 
 		friend class Weather;
+		friend class WeatherDataset;
+		friend class WeatherGrid;
+		friend class WeatherParser;
+		friend void from_json(const nlohmann::json& j, WeatherDataset& dataset);
 	};
 
 	class WeatherInfo {
@@ -42,6 +85,119 @@ namespace IASsure {
 	private:
 		std::string date;
 		std::string datestring;
+
+		friend class Weather;
+		friend class WeatherParser;
+	};
+
+	// WeatherLookupHint stores the reference point found by a previous lookup (e.g. for the same aircraft), allowing subsequent
+	// lookups nearby to skip the full nearest point search. Hints are only used for the dataset they were created with.
+	class WeatherLookupHint {
+	public:
+		uint64_t generation = 0;
+		size_t point = SpatialIndex::npos;
+	};
+
+	// WeatherDataset contains the data of one parsed weather update. Datasets are built completely before being published
+	// and are never modified afterwards, allowing lookups to be performed without any locking.
+	class WeatherDataset {
+	public:
+		WeatherReferenceLevel findClosest(double latitude, double longitude, int altitude) const;
+		WeatherReferenceLevel findClosest(double latitude, double longitude, int altitude, WeatherLookupHint& hint) const;
+
+		friend void from_json(const nlohmann::json& j, WeatherDataset& dataset);
+	private:
+		// xxHash of the raw data the dataset was parsed from
+		uint64_t hash = 0;
+		// unique number assigned when publishing the dataset, used for invalidating lookup hints
+		uint64_t generation = 0;
+		WeatherInfo info;
+		// reference points ordered by their name, indices match the spatial index
+		std::vector<WeatherReferencePoint> points;
+		SpatialIndex index;
+		// optional resampled grid, replacing the closest reference point lookup if available
+		std::shared_ptr<const WeatherGrid> grid;
+
+		void build(std::vector<std::pair<std::string, WeatherReferencePoint>> points);
+		void buildIndex();
+
+		friend class Weather;
+		friend class WeatherParser;
+	};
+
+	// WeatherParser implements nlohmann's SAX interface, filling a WeatherDataset while the JSON document is being read instead of
+	// building a DOM first. It accepts the same schema as the from_json overloads, unknown keys are ignored.
+	class WeatherParser {
+	public:
+		WeatherParser(WeatherDataset& dataset);
+
+		bool null();
+		bool boolean(bool val);
+		bool number_integer(nlohmann::json::number_integer_t val);
+		bool number_unsigned(nlohmann::json::number_unsigned_t val);
+		bool number_float(nlohmann::json::number_float_t val, const nlohmann::json::string_t& s);
+		bool string(nlohmann::json::string_t& val);
+		bool binary(nlohmann::json::binary_t& val);
+		bool start_object(std::size_t elements);
+		bool key(nlohmann::json::string_t& val);
+		bool end_object();
+		bool start_array(std::size_t elements);
+		bool end_array();
+
+		template<typename Exception>
+		bool parse_error(std::size_t, const std::string&, const Exception& ex)
+		{
+			throw ex;
+		}
+	private:
+		enum class Context {
+			None,
+			Unknown,
+			Document,
+			Info,
+			Data,
+			Point,
+			Coords,
+			Levels,
+			Level,
+		};
+
+		enum class Field {
+			None,
+			Date,
+			Datestring,
+			Latitude,
+			Longitude,
+			Temperature,
+			WindSpeed,
+			WindDirection,
+		};
+
+		struct Frame {
+			Context context;
+			// bitmask of required keys found in the object
+			unsigned int found;
+		};
+
+		WeatherDataset& dataset;
+		std::vector<Frame> frames;
+		// object expected as value of the current key, Unknown if the value is ignored
+		Context nextContext;
+		// string expected as value of the current key
+		Field nextField;
+		// nesting depth within ignored values
+		int skipDepth;
+
+		std::vector<std::pair<std::string, WeatherReferencePoint>> points;
+		std::string pointName;
+		WeatherReferencePoint point;
+		std::vector<std::pair<int, WeatherReferenceLevel>> levels;
+		int flightLevel;
+		WeatherReferenceLevel level;
+
+		bool skipValue();
+		void expect(Context context, unsigned int bit);
+		void expect(Field field, unsigned int bit);
 	};
 
 	class Weather {
@@ -50,19 +206,46 @@ namespace IASsure {
 		Weather(std::string rawJSON);
 		Weather(std::istream& rawJSON);
 
-		void parse(std::string rawJSON);
-		void parse(std::istream& rawJSON);
+		// parse replaces the current weather data with the given raw JSON, returning false if parsing was skipped as the data is unchanged
+		bool parse(const std::string& rawJSON);
+		bool parse(std::istream& rawJSON);
 		void clear();
 
 		WeatherReferenceLevel findClosest(double latitude, double longitude, int altitude) const;
+		WeatherReferenceLevel findClosest(double latitude, double longitude, int altitude, WeatherLookupHint& hint) const;
+		// generation of the current weather data, changing whenever new data is published. 0 if no weather data is available
+		uint64_t generation() const;
+		// current returns the currently published dataset, which stays valid while being held. nullptr if no weather data is available
+		std::shared_ptr<const WeatherDataset> current() const;
+		// number of parses skipped since the raw data matched the current weather data
+		size_t skippedParses() const;
 
-		friend void from_json(const nlohmann::json& j, Weather& weather);
+		// setGridSettings enables or disables interpolated lookups using a resampled weather grid, rebuilding the grid of the current data
+		// on the calling thread before returning.
+		// hasGrid returns false if the grid is disabled or could not be built for the current data (e.g. exceeding MAX_GRID_CELLS).
+		void setGridSettings(const WeatherGridSettings& settings);
+		bool hasGrid() const;
+		// setThreadPool sets the thread pool used for building weather grids, nullptr builds them on the publishing thread.
+		// the pool has to outlive the weather data or be reset before being destroyed.
+		void setThreadPool(thread::ThreadPool* pool);
+
+		// serialize stores the current weather data in a versioned binary format, which can be restored using deserialize.
+		// deserialize validates the data before replacing the current weather data, throwing std::invalid_argument for corrupt data.
+		std::string serialize() const;
+		static std::string serialize(const WeatherDataset& dataset);
+		void deserialize(std::string_view data);
 	private:
-		mutable std::shared_mutex mutex;
-		size_t hash;
-		WeatherInfo info;
-		std::map<std::string, WeatherReferencePoint> points;
+		// currently published dataset, replaced atomically on update. readers keep their copy of the pointer alive
+		// for the duration of the lookup, so an update never blocks or invalidates a running lookup.
+		std::atomic<std::shared_ptr<const WeatherDataset>> dataset;
+		std::atomic<size_t> skipped;
+		// serializes publishing datasets and changing the grid settings, lookups never acquire the lock
+		std::mutex publishMutex;
+		WeatherGridSettings gridSettings;
+		thread::ThreadPool* threadPool;
 
-		void update(const nlohmann::json& j);
+		void publish(std::shared_ptr<WeatherDataset> dataset);
+		// publishLocked builds the grid if required and publishes the dataset, publishMutex has to be held by the caller
+		void publishLocked(std::shared_ptr<WeatherDataset> dataset);
 	};
 }
\ No newline at end of file
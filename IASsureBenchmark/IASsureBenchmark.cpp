@@ -0,0 +1,53 @@
+#include <exception>
+#include <iostream>
+#include <string>
+
+#include "benchmark.h"
+#include "dataset.h"
+
+// usage: IASsureBenchmark.exe [--json] [filter], only running benchmarks whose name contains the filter. --json prints the results as a
+// single JSON document instead, e.g. for comparing results between releases.
+// IASsureBenchmark.exe --generate-weather <points> <levels> <seed> prints a synthetic weather dataset instead of running any benchmarks
+int main(int argc, char* argv[])
+{
+	if (argc > 1 && std::string(argv[1]) == "--generate-weather") {
+		if (argc != 5) {
+			std::cerr << "usage: IASsureBenchmark.exe --generate-weather <points> <levels> <seed>" << std::endl;
+			return 1;
+		}
+
+		try {
+			IASsureBenchmark::dataset::WeatherDatasetOptions options;
+			options.points = std::stoi(argv[2]);
+			options.levels = std::stoi(argv[3]);
+			options.seed = (unsigned int)std::stoul(argv[4]);
+
+			std::cout << IASsureBenchmark::dataset::generateWeather(options);
+		}
+		catch (std::exception const& e) {
+			std::cerr << "failed to generate weather data: " << e.what() << std::endl;
+			return 1;
+		}
+
+		return 0;
+	}
+
+	IASsureBenchmark::OutputFormat format = IASsureBenchmark::OutputFormat::Console;
+	std::string filter;
+
+	for (int i = 1; i < argc; i++) {
+		std::string arg = argv[i];
+		if (arg == "--json") {
+			format = IASsureBenchmark::OutputFormat::JSON;
+		}
+		else if (filter.empty()) {
+			filter = arg;
+		}
+		else {
+			std::cerr << "usage: IASsureBenchmark.exe [--json] [filter]" << std::endl;
+			return 1;
+		}
+	}
+
+	return IASsureBenchmark::run(filter, format);
+}
\ No newline at end of file
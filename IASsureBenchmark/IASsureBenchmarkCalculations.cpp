@@ -0,0 +1,190 @@
+#include <algorithm>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../IASsure/batch.h"
+#include "../IASsure/calculations.h"
+#include "../IASsure/thread.h"
+
+#include "benchmark.h"
+
+namespace {
+	// number of radar targets calculated per iteration, e.g. all traffic of a busy sector group
+	const std::vector<size_t> TARGET_COUNTS = { 16, 256, 4096 };
+	// number of targets calculated per iteration when scaling across threads, e.g. all traffic of a large event or an offline analysis
+	const size_t SCALING_TARGET_COUNT = 10000;
+
+	// results are written to a volatile sink to prevent the compiler from optimising away calculations
+	volatile double sink;
+
+	IASsure::AirDataBatch GenerateTargets(size_t count)
+	{
+		std::mt19937 rng(1337);
+		std::uniform_real_distribution<double> alt(0, 45000);
+		std::uniform_real_distribution<double> heading(0, 360);
+		std::uniform_real_distribution<double> gs(140, 550);
+		std::uniform_real_distribution<double> temperature(210, 300);
+		std::uniform_real_distribution<double> windSpeed(0, 150);
+		std::uniform_real_distribution<double> windDirection(0, 360);
+
+		IASsure::AirDataBatch batch;
+		for (size_t i = 0; i < count; i++) {
+			batch.add(alt(rng), heading(rng), gs(rng), IASsure::WeatherReferenceLevel{ temperature(rng), windSpeed(rng), windDirection(rng) });
+		}
+
+		return batch;
+	}
+
+	void SetTargetCounter(IASsureBenchmark::State& state, size_t count)
+	{
+		state.setCounter("ns_per_target", (double)state.elapsed().count() / ((double)state.iterations() * count));
+	}
+
+	void RegisterCalculationBenchmarks()
+	{
+		for (auto model : { IASsure::AtmosphereModel::Exact, IASsure::AtmosphereModel::Table }) {
+			std::string name = model == IASsure::AtmosphereModel::Exact ? "Exact" : "Table";
+
+			// ISA temperature and static pressure for pressure altitudes as reported (integer feet)
+			IASsureBenchmark::registerBenchmark("CalculationsAtmosphere" + name, [model](IASsureBenchmark::State& state) {
+				std::vector<double> altitudes;
+				for (int alt = -1000; alt <= 45000; alt += 7) {
+					altitudes.push_back(alt);
+				}
+
+				double result = 0;
+				while (state.keepRunning()) {
+					for (double alt : altitudes) {
+						result += IASsure::calculateTemperature(alt, model) + IASsure::calculateStaticPressure(alt, model);
+					}
+				}
+				sink = result;
+
+				state.setCounter("ns_per_altitude", (double)state.elapsed().count() / ((double)state.iterations() * altitudes.size()));
+				});
+		}
+
+		// parked aircraft, previously handled by catching the exception thrown for every target on every tag update
+		IASsureBenchmark::registerBenchmark("CalculationsParkedThrowing", [](IASsureBenchmark::State& state) {
+			double result = 0;
+			while (state.keepRunning()) {
+				try {
+					result += IASsure::calculateCAS(1200, 90, 0, IASsure::WeatherReferenceLevel{ 280, 10, 270 });
+				}
+				catch (std::exception const&) {
+					result -= 1;
+				}
+			}
+			sink = result;
+			});
+
+		IASsureBenchmark::registerBenchmark("CalculationsParkedStatus", [](IASsureBenchmark::State& state) {
+			double result = 0;
+			while (state.keepRunning()) {
+				IASsure::CalculationResult cas = IASsure::tryCalculateCAS(1200, 90, 0, IASsure::WeatherReferenceLevel{ 280, 10, 270 });
+				result += cas.ok() ? cas.value : -1;
+			}
+			sink = result;
+			});
+
+		for (size_t count : TARGET_COUNTS) {
+			std::string suffix = "/" + std::to_string(count);
+
+			// individual calculation functions, as used by the tag items of a single target
+			IASsureBenchmark::registerBenchmark("CalculationsCAS" + suffix, [count](IASsureBenchmark::State& state) {
+				IASsure::AirDataBatch batch = GenerateTargets(count);
+
+				double result = 0;
+				while (state.keepRunning()) {
+					for (size_t i = 0; i < count; i++) {
+						IASsure::WeatherReferenceLevel lvl{ batch.temperature[i], batch.windSpeed[i], batch.windDirection[i] };
+						result += IASsure::calculateCAS(batch.altitude[i], batch.heading[i], batch.groundSpeed[i], lvl);
+					}
+				}
+				sink = result;
+
+				SetTargetCounter(state, count);
+				});
+
+			IASsureBenchmark::registerBenchmark("CalculationsMach" + suffix, [count](IASsureBenchmark::State& state) {
+				IASsure::AirDataBatch batch = GenerateTargets(count);
+
+				double result = 0;
+				while (state.keepRunning()) {
+					for (size_t i = 0; i < count; i++) {
+						IASsure::WeatherReferenceLevel lvl{ batch.temperature[i], batch.windSpeed[i], batch.windDirection[i] };
+						result += IASsure::calculateMach(batch.altitude[i], batch.heading[i], batch.groundSpeed[i], lvl);
+					}
+				}
+				sink = result;
+
+				SetTargetCounter(state, count);
+				});
+
+			// previous approach, calculating CAS and Mach number separately for each target
+			IASsureBenchmark::registerBenchmark("CalculationsSingle" + suffix, [count](IASsureBenchmark::State& state) {
+				IASsure::AirDataBatch batch = GenerateTargets(count);
+
+				double result = 0;
+				while (state.keepRunning()) {
+					for (size_t i = 0; i < count; i++) {
+						IASsure::WeatherReferenceLevel lvl{ batch.temperature[i], batch.windSpeed[i], batch.windDirection[i] };
+						result += IASsure::calculateCAS(batch.altitude[i], batch.heading[i], batch.groundSpeed[i], lvl);
+						result += IASsure::calculateMach(batch.altitude[i], batch.heading[i], batch.groundSpeed[i], lvl);
+					}
+				}
+				sink = result;
+
+				SetTargetCounter(state, count);
+				});
+
+			for (auto instructionSet : { IASsure::simd::InstructionSet::Scalar, IASsure::simd::InstructionSet::AVX2 }) {
+				if (instructionSet > IASsure::simd::supported()) {
+					continue;
+				}
+
+				IASsureBenchmark::registerBenchmark(std::string("CalculationsBatch") + IASsure::simd::name(instructionSet) + suffix, [count, instructionSet](IASsureBenchmark::State& state) {
+					IASsure::AirDataBatch batch = GenerateTargets(count);
+
+					double result = 0;
+					while (state.keepRunning()) {
+						IASsure::calculateAirData(batch, instructionSet);
+						result += batch.cas[0] + batch.mach[0];
+					}
+					sink = result;
+
+					SetTargetCounter(state, count);
+					});
+			}
+		}
+
+		// thread counts from 1 to the number of hardware threads, doubling each step. the calling thread counts as one of the threads
+		std::vector<size_t> threadCounts;
+		size_t hardwareThreads = (std::max)(std::thread::hardware_concurrency(), 1u);
+		for (size_t threads = 1; threads < hardwareThreads; threads *= 2) {
+			threadCounts.push_back(threads);
+		}
+		threadCounts.push_back(hardwareThreads);
+
+		for (size_t threads : threadCounts) {
+			IASsureBenchmark::registerBenchmark("CalculationsBatchThreads/" + std::to_string(threads), [threads](IASsureBenchmark::State& state) {
+				IASsure::AirDataBatch batch = GenerateTargets(SCALING_TARGET_COUNT);
+				IASsure::thread::ThreadPool pool(threads - 1);
+
+				double result = 0;
+				while (state.keepRunning()) {
+					IASsure::calculateAirData(batch, pool);
+					result += batch.cas[0] + batch.mach[0];
+				}
+				sink = result;
+
+				SetTargetCounter(state, SCALING_TARGET_COUNT);
+				state.setCounter("threads", (double)threads);
+				});
+		}
+	}
+
+	const bool registered = (RegisterCalculationBenchmarks(), true);
+}
\ No newline at end of file
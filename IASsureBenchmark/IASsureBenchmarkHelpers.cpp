@@ -0,0 +1,61 @@
+#include <random>
+#include <string>
+#include <vector>
+
+#include "../IASsure/haversine.h"
+#include "../IASsure/helpers.h"
+
+#include "benchmark.h"
+
+namespace {
+	// number of space separated fields per string, e.g. a short command or a long list of callsigns
+	const std::vector<size_t> FIELD_COUNTS = { 4, 64, 1024 };
+	constexpr size_t PAIR_COUNT = 1024;
+
+	// results are written to a volatile sink to prevent the compiler from optimising away calculations
+	volatile double sink;
+
+	void RegisterHelperBenchmarks()
+	{
+		// single great circle distances between random positions, without any spatial index
+		IASsureBenchmark::registerBenchmark("Haversine", [](IASsureBenchmark::State& state) {
+			std::mt19937 rng(1337);
+			std::uniform_real_distribution<double> lat(35.0, 70.0);
+			std::uniform_real_distribution<double> lon(-10.0, 30.0);
+
+			std::vector<std::pair<std::pair<double, double>, std::pair<double, double>>> pairs;
+			for (size_t i = 0; i < PAIR_COUNT; i++) {
+				pairs.push_back({ { lat(rng), lon(rng) }, { lat(rng), lon(rng) } });
+			}
+
+			double result = 0;
+			while (state.keepRunning()) {
+				for (auto const& [from, to] : pairs) {
+					result += IASsure::haversine(from.first, from.second, to.first, to.second);
+				}
+			}
+			sink = result;
+
+			state.setCounter("ns_per_distance", (double)state.elapsed().count() / ((double)state.iterations() * pairs.size()));
+			});
+
+		for (size_t count : FIELD_COUNTS) {
+			IASsureBenchmark::registerBenchmark("Split/" + std::to_string(count), [count](IASsureBenchmark::State& state) {
+				std::string s;
+				for (size_t i = 0; i < count; i++) {
+					s += (i > 0 ? " " : "") + std::string("DLH") + std::to_string(100 + i);
+				}
+
+				double result = 0;
+				while (state.keepRunning()) {
+					result += IASsure::split(s).size();
+				}
+				sink = result;
+
+				state.setCounter("ns_per_field", (double)state.elapsed().count() / ((double)state.iterations() * count));
+				});
+		}
+	}
+
+	const bool registered = (RegisterHelperBenchmarks(), true);
+}
\ No newline at end of file
@@ -0,0 +1,147 @@
+#include <random>
+#include <string>
+#include <vector>
+
+#include "../IASsure/haversine.h"
+#include "../IASsure/spatial.h"
+
+#include "benchmark.h"
+
+namespace {
+	const std::vector<size_t> DATASET_SIZES = { 16, 64, 128, 256, 1024, 10000, 100000 };
+	constexpr size_t QUERY_COUNT = 1024;
+
+	// results are written to a volatile sink to prevent the compiler from optimising away lookups
+	volatile size_t sink;
+
+	std::vector<std::pair<double, double>> GenerateCoordinates(size_t count, unsigned int seed)
+	{
+		std::mt19937 rng(seed);
+		std::uniform_real_distribution<double> lat(35.0, 70.0);
+		std::uniform_real_distribution<double> lon(-10.0, 30.0);
+
+		std::vector<std::pair<double, double>> coordinates;
+		for (size_t i = 0; i < count; i++) {
+			coordinates.push_back({ lat(rng), lon(rng) });
+		}
+
+		return coordinates;
+	}
+
+	// linear scan calculating haversine for every point, as used before the spatial index was introduced
+	size_t FindClosestHaversine(const std::vector<std::pair<double, double>>& coordinates, double latitude, double longitude)
+	{
+		size_t closest = IASsure::SpatialIndex::npos;
+		double distance = -1;
+		for (size_t i = 0; i < coordinates.size(); i++) {
+			double d = IASsure::haversine(latitude, longitude, coordinates[i].first, coordinates[i].second);
+			if (distance < 0 || d < distance) {
+				distance = d;
+				closest = i;
+			}
+		}
+
+		return closest;
+	}
+
+	template<typename Lookup>
+	void RunLookups(IASsureBenchmark::State& state, const std::vector<std::pair<double, double>>& queries, Lookup lookup)
+	{
+		size_t result = 0;
+		while (state.keepRunning()) {
+			for (auto const& [latitude, longitude] : queries) {
+				result += lookup(latitude, longitude);
+			}
+		}
+		sink = result;
+
+		state.setCounter("ns_per_lookup", (double)state.elapsed().count() / ((double)state.iterations() * queries.size()));
+	}
+
+	// positions of aircraft moving a few hundred metres between radar updates, grouped by update
+	std::vector<std::pair<double, double>> GenerateTracks(size_t aircraft, size_t updates)
+	{
+		std::mt19937 rng(9001);
+		std::uniform_real_distribution<double> lat(35.0, 70.0);
+		std::uniform_real_distribution<double> lon(-10.0, 30.0);
+		std::uniform_real_distribution<double> direction(-1.0, 1.0);
+
+		std::vector<std::pair<double, double>> positions(aircraft);
+		std::vector<std::pair<double, double>> velocities(aircraft);
+		for (size_t a = 0; a < aircraft; a++) {
+			positions[a] = { lat(rng), lon(rng) };
+			velocities[a] = { direction(rng) * 0.004, direction(rng) * 0.006 };
+		}
+
+		std::vector<std::pair<double, double>> tracks;
+		for (size_t u = 0; u < updates; u++) {
+			for (size_t a = 0; a < aircraft; a++) {
+				positions[a].first += velocities[a].first;
+				positions[a].second += velocities[a].second;
+				tracks.push_back(positions[a]);
+			}
+		}
+
+		return tracks;
+	}
+
+	void RegisterSpatialBenchmarks()
+	{
+		for (size_t size : DATASET_SIZES) {
+			std::string suffix = "/" + std::to_string(size);
+
+			IASsureBenchmark::registerBenchmark("SpatialHaversine" + suffix, [size](IASsureBenchmark::State& state) {
+				auto coordinates = GenerateCoordinates(size, 1337);
+				auto queries = GenerateCoordinates(QUERY_COUNT, 4242);
+				RunLookups(state, queries, [&coordinates](double latitude, double longitude) {
+					return FindClosestHaversine(coordinates, latitude, longitude);
+					});
+				});
+
+			for (auto instructionSet : { IASsure::simd::InstructionSet::Scalar, IASsure::simd::InstructionSet::SSE2, IASsure::simd::InstructionSet::AVX2 }) {
+				if (instructionSet > IASsure::simd::supported()) {
+					continue;
+				}
+
+				IASsureBenchmark::registerBenchmark(std::string("SpatialLinear") + IASsure::simd::name(instructionSet) + suffix, [size, instructionSet](IASsureBenchmark::State& state) {
+					IASsure::SpatialIndex index(GenerateCoordinates(size, 1337));
+					auto queries = GenerateCoordinates(QUERY_COUNT, 4242);
+					RunLookups(state, queries, [&index, instructionSet](double latitude, double longitude) {
+						return index.findClosestLinear(latitude, longitude, instructionSet);
+						});
+					});
+			}
+
+			IASsureBenchmark::registerBenchmark("SpatialIndex" + suffix, [size](IASsureBenchmark::State& state) {
+				IASsure::SpatialIndex index(GenerateCoordinates(size, 1337));
+				auto queries = GenerateCoordinates(QUERY_COUNT, 4242);
+				RunLookups(state, queries, [&index](double latitude, double longitude) {
+					return index.findClosest(latitude, longitude);
+					});
+				});
+
+			IASsureBenchmark::registerBenchmark("SpatialTracked" + suffix, [size](IASsureBenchmark::State& state) {
+				IASsure::SpatialIndex index(GenerateCoordinates(size, 1337));
+				auto queries = GenerateTracks(64, QUERY_COUNT / 64);
+				RunLookups(state, queries, [&index](double latitude, double longitude) {
+					return index.findClosest(latitude, longitude);
+					});
+				});
+
+			// same aircraft tracks as above, passing the previous result of each aircraft as hint
+			IASsureBenchmark::registerBenchmark("SpatialTrackedHinted" + suffix, [size](IASsureBenchmark::State& state) {
+				IASsure::SpatialIndex index(GenerateCoordinates(size, 1337));
+				auto queries = GenerateTracks(64, QUERY_COUNT / 64);
+				std::vector<size_t> hints(64, IASsure::SpatialIndex::npos);
+				size_t query = 0;
+				RunLookups(state, queries, [&index, &hints, &query](double latitude, double longitude) {
+					size_t& hint = hints[query++ % hints.size()];
+					hint = index.findClosest(latitude, longitude, hint);
+					return hint;
+					});
+				});
+		}
+	}
+
+	const bool registered = (RegisterSpatialBenchmarks(), true);
+}
\ No newline at end of file
@@ -0,0 +1,299 @@
+#include <map>
+#include <random>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include <nlohmann/json.hpp>
+
+#include "../IASsure/spatial.h"
+#include "../IASsure/weather.h"
+
+#include "benchmark.h"
+#include "dataset.h"
+#include "memory.h"
+
+namespace {
+	// number of reference points of the synthetic dataset, roughly covering the european airspace in a 0.25 degree grid
+	constexpr int DATASET_POINTS = 10000;
+	// dataset sizes used for parameterised benchmarks, from a single FIR up to the default dataset
+	const std::vector<int> DATASET_SIZES = { 100, 1000, DATASET_POINTS };
+	// number of levels of a single reference point, the default dataset provides 46 (FL0 to FL450 in steps of 10)
+	const std::vector<int> LEVEL_COUNTS = { 10, 46, 200 };
+	// point and level counts of the scaling benchmarks, up to global coverage and levels in steps of 5 flight levels
+	const std::vector<std::pair<int, int>> SCALING_DATASETS = { {1000, 46}, {10000, 46}, {100000, 46}, {10000, 10}, {10000, 91} };
+	constexpr size_t QUERY_COUNT = 1024;
+
+	// results are written to a volatile sink to prevent the compiler from optimising away lookups
+	volatile double sink;
+
+	const std::string& Dataset(int points = DATASET_POINTS)
+	{
+		// datasets are generated once per size and shared between benchmarks
+		static std::map<int, std::string> datasets;
+
+		auto it = datasets.find(points);
+		if (it == datasets.end()) {
+			IASsureBenchmark::dataset::WeatherDatasetOptions options;
+			options.points = points;
+			it = datasets.emplace(points, IASsureBenchmark::dataset::generateWeather(options)).first;
+		}
+
+		return it->second;
+	}
+
+	// single reference point with levels evenly spread between FL0 and FL450
+	IASsure::WeatherReferencePoint GeneratePoint(int levelCount)
+	{
+		IASsureBenchmark::dataset::WeatherDatasetOptions options;
+		options.points = 1;
+		options.levels = levelCount;
+
+		nlohmann::json j = nlohmann::json::parse(IASsureBenchmark::dataset::generateWeather(options));
+		return j.at("data").front().get<IASsure::WeatherReferencePoint>();
+	}
+
+	std::vector<std::tuple<double, double, int>> GenerateQueries(size_t count)
+	{
+		std::mt19937 rng(4242);
+		std::uniform_real_distribution<double> latitude(35.0, 70.0);
+		std::uniform_real_distribution<double> longitude(-10.0, 30.0);
+		std::uniform_int_distribution<int> altitude(0, 45000);
+
+		std::vector<std::tuple<double, double, int>> queries;
+		for (size_t i = 0; i < count; i++) {
+			queries.push_back({ latitude(rng), longitude(rng), altitude(rng) });
+		}
+
+		return queries;
+	}
+
+	void RunLookups(IASsureBenchmark::State& state, const IASsure::Weather& weather)
+	{
+		auto queries = GenerateQueries(QUERY_COUNT);
+
+		double result = 0;
+		while (state.keepRunning()) {
+			for (auto const& [latitude, longitude, altitude] : queries) {
+				result += weather.findClosest(latitude, longitude, altitude).windSpeed;
+			}
+		}
+		sink = result;
+
+		state.setCounter("ns_per_lookup", (double)state.elapsed().count() / ((double)state.iterations() * queries.size()));
+	}
+
+	IASsure::WeatherGridSettings GridSettings()
+	{
+		IASsure::WeatherGridSettings settings;
+		settings.enabled = true;
+
+		return settings;
+	}
+
+	void SetMemoryCounters(IASsureBenchmark::State& state, size_t baseline, const std::string& raw)
+	{
+		state.setCounter("peak_MB", (double)(IASsureBenchmark::memory::peak() - baseline) / (1024 * 1024));
+		state.setCounter("input_MB", (double)raw.size() / (1024 * 1024));
+	}
+
+	void RegisterWeatherBenchmarks()
+	{
+		for (int points : DATASET_SIZES) {
+			std::string suffix = "/" + std::to_string(points);
+
+			// streaming ingest path used by IASsure::Weather
+			IASsureBenchmark::registerBenchmark("WeatherParseSAX" + suffix, [points](IASsureBenchmark::State& state) {
+				const std::string& raw = Dataset(points);
+
+				size_t baseline = IASsureBenchmark::memory::current();
+				IASsureBenchmark::memory::resetPeak();
+
+				while (state.keepRunning()) {
+					IASsure::Weather weather;
+					weather.parse(raw);
+				}
+
+				SetMemoryCounters(state, baseline, raw);
+				});
+
+			// closest reference point lookup (without hints) at random positions
+			IASsureBenchmark::registerBenchmark("WeatherLookupClosest" + suffix, [points](IASsureBenchmark::State& state) {
+				IASsure::Weather weather;
+				weather.parse(Dataset(points));
+
+				RunLookups(state, weather);
+				});
+		}
+
+		// closest level lookup of a single reference point at random altitudes, done for every target after finding the closest point
+		for (int levelCount : LEVEL_COUNTS) {
+			IASsureBenchmark::registerBenchmark("WeatherLookupLevel/" + std::to_string(levelCount), [levelCount](IASsureBenchmark::State& state) {
+				IASsure::WeatherReferencePoint point = GeneratePoint(levelCount);
+				auto queries = GenerateQueries(QUERY_COUNT);
+
+				double result = 0;
+				while (state.keepRunning()) {
+					for (auto const& [latitude, longitude, altitude] : queries) {
+						result += point.findClosest(altitude).windSpeed;
+					}
+				}
+				sink = result;
+
+				state.setCounter("ns_per_lookup", (double)state.elapsed().count() / ((double)state.iterations() * queries.size()));
+				});
+		}
+	}
+
+	// scaling datasets are generated by each benchmark instead of being shared, only keeping one of the large datasets in memory at a time
+	void RegisterScalingBenchmarks()
+	{
+		for (auto const& [points, levels] : SCALING_DATASETS) {
+			IASsureBenchmark::dataset::WeatherDatasetOptions options;
+			options.points = points;
+			options.levels = levels;
+			std::string suffix = "/" + std::to_string(points) + "x" + std::to_string(levels);
+
+			// parse time and memory, both while parsing (peak) and of the parsed dataset kept afterwards (retained)
+			IASsureBenchmark::registerBenchmark("WeatherScaleParse" + suffix, [options](IASsureBenchmark::State& state) {
+				std::string raw = IASsureBenchmark::dataset::generateWeather(options);
+
+				size_t baseline = IASsureBenchmark::memory::current();
+				IASsureBenchmark::memory::resetPeak();
+
+				while (state.keepRunning()) {
+					IASsure::Weather weather;
+					weather.parse(raw);
+				}
+
+				SetMemoryCounters(state, baseline, raw);
+
+				IASsure::Weather weather;
+				weather.parse(raw);
+				state.setCounter("retained_MB", (double)(IASsureBenchmark::memory::current() - baseline) / (1024 * 1024));
+				state.setCounter("ns_per_point", (double)state.elapsed().count() / ((double)state.iterations() * options.points));
+				});
+
+			IASsureBenchmark::registerBenchmark("WeatherScaleLookup" + suffix, [options](IASsureBenchmark::State& state) {
+				IASsure::Weather weather;
+				weather.parse(IASsureBenchmark::dataset::generateWeather(options));
+
+				RunLookups(state, weather);
+				});
+
+			if (levels != SCALING_DATASETS.front().second) {
+				continue;
+			}
+
+			// spatial index built for every weather update, independent of the number of levels
+			IASsureBenchmark::registerBenchmark("WeatherScaleIndex/" + std::to_string(points), [options](IASsureBenchmark::State& state) {
+				auto coordinates = IASsureBenchmark::dataset::generateCoordinates(options);
+
+				size_t baseline = IASsureBenchmark::memory::current();
+				IASsureBenchmark::memory::resetPeak();
+
+				size_t result = 0;
+				while (state.keepRunning()) {
+					IASsure::SpatialIndex index(coordinates);
+					result += index.findClosest(0, 0);
+				}
+				sink = (double)result;
+
+				state.setCounter("peak_MB", (double)(IASsureBenchmark::memory::peak() - baseline) / (1024 * 1024));
+				state.setCounter("ns_per_point", (double)state.elapsed().count() / ((double)state.iterations() * options.points));
+				});
+		}
+	}
+
+	const bool registered = (RegisterWeatherBenchmarks(), RegisterScalingBenchmarks(), true);
+}
+
+// previous ingest path: DOM, hash of the DOM and conversion via from_json
+BENCHMARK(WeatherParseDOM)
+{
+	const std::string& raw = Dataset();
+
+	size_t baseline = IASsureBenchmark::memory::current();
+	IASsureBenchmark::memory::resetPeak();
+
+	double result = 0;
+	while (state.keepRunning()) {
+		nlohmann::json j = nlohmann::json::parse(raw);
+		size_t hash = std::hash<nlohmann::json> {}(j);
+		IASsure::WeatherDataset dataset = j.get<IASsure::WeatherDataset>();
+		// a single lookup keeps the dataset alive, negligible compared to parsing
+		result += (double)hash + dataset.findClosest(0, 0, 0).temperature;
+	}
+	sink = result;
+
+	SetMemoryCounters(state, baseline, raw);
+}
+
+// repeated update with unchanged data, only hashing the raw data
+BENCHMARK(WeatherParseUnchanged)
+{
+	const std::string& raw = Dataset();
+
+	IASsure::Weather weather;
+	weather.parse(raw);
+
+	while (state.keepRunning()) {
+		weather.parse(raw);
+	}
+
+	state.setCounter("skipped", (double)weather.skippedParses());
+}
+
+// warm start from the binary weather cache
+BENCHMARK(WeatherLoadCache)
+{
+	IASsure::Weather source;
+	source.parse(Dataset());
+	std::string cache = source.serialize();
+
+	size_t baseline = IASsureBenchmark::memory::current();
+	IASsureBenchmark::memory::resetPeak();
+
+	while (state.keepRunning()) {
+		IASsure::Weather weather;
+		weather.deserialize(cache);
+	}
+
+	state.setCounter("peak_MB", (double)(IASsureBenchmark::memory::peak() - baseline) / (1024 * 1024));
+	state.setCounter("cache_MB", (double)cache.size() / (1024 * 1024));
+}
+
+// interpolated lookup using the resampled weather grid at the same positions as WeatherLookupClosest/10000
+BENCHMARK(WeatherLookupGrid)
+{
+	IASsure::Weather weather;
+	weather.setGridSettings(GridSettings());
+	weather.parse(Dataset());
+
+	RunLookups(state, weather);
+}
+
+// additional time and memory spent on each weather update when the grid is enabled
+BENCHMARK(WeatherBuildGrid)
+{
+	IASsure::Weather source;
+	source.parse(Dataset());
+	std::string cache = source.serialize();
+
+	IASsure::Weather weather;
+	weather.deserialize(cache);
+
+	size_t baseline = IASsureBenchmark::memory::current();
+	IASsureBenchmark::memory::resetPeak();
+
+	IASsure::WeatherGridSettings disabled;
+	while (state.keepRunning()) {
+		state.pause();
+		weather.setGridSettings(disabled);
+		state.resume();
+
+		weather.setGridSettings(GridSettings());
+	}
+
+	state.setCounter("peak_MB", (double)(IASsureBenchmark::memory::peak() - baseline) / (1024 * 1024));
+}
\ No newline at end of file
@@ -0,0 +1,137 @@
+#include "benchmark.h"
+
+#include <iomanip>
+#include <iostream>
+#include <thread>
+
+#include <nlohmann/json.hpp>
+
+#include "../IASsure/simd.h"
+
+namespace {
+	std::vector<std::pair<std::string, IASsureBenchmark::BenchmarkFunction>>& registry()
+	{
+		static std::vector<std::pair<std::string, IASsureBenchmark::BenchmarkFunction>> benchmarks;
+		return benchmarks;
+	}
+}
+
+IASsureBenchmark::State::State(std::chrono::nanoseconds minTime) :
+	minTime(minTime),
+	measured(0),
+	start(),
+	iteration(0),
+	running(false)
+{
+}
+
+bool IASsureBenchmark::State::keepRunning()
+{
+	if (this->running) {
+		this->pause();
+		this->iteration++;
+	}
+
+	if (this->iteration > 0 && this->measured >= this->minTime) {
+		return false;
+	}
+
+	this->resume();
+	return true;
+}
+
+void IASsureBenchmark::State::pause()
+{
+	if (!this->running) {
+		return;
+	}
+
+	this->measured += std::chrono::steady_clock::now() - this->start;
+	this->running = false;
+}
+
+void IASsureBenchmark::State::resume()
+{
+	if (this->running) {
+		return;
+	}
+
+	this->running = true;
+	this->start = std::chrono::steady_clock::now();
+}
+
+void IASsureBenchmark::State::setCounter(const std::string& name, double value)
+{
+	this->values[name] = value;
+}
+
+size_t IASsureBenchmark::State::iterations() const
+{
+	return this->iteration;
+}
+
+std::chrono::nanoseconds IASsureBenchmark::State::elapsed() const
+{
+	return this->measured;
+}
+
+const std::map<std::string, double>& IASsureBenchmark::State::counters() const
+{
+	return this->values;
+}
+
+IASsureBenchmark::Registration::Registration(const std::string& name, BenchmarkFunction f)
+{
+	registerBenchmark(name, f);
+}
+
+void IASsureBenchmark::registerBenchmark(const std::string& name, BenchmarkFunction f)
+{
+	registry().push_back({ name, f });
+}
+
+int IASsureBenchmark::run(const std::string& filter, OutputFormat format)
+{
+	nlohmann::json results = nlohmann::json::array();
+
+	for (auto const& [name, f] : registry()) {
+		if (name.find(filter) == std::string::npos) {
+			continue;
+		}
+
+		State state(std::chrono::seconds(1));
+		f(state);
+
+		double perIteration = state.iterations() > 0 ? (double)state.elapsed().count() / state.iterations() : 0;
+
+		if (format == OutputFormat::JSON) {
+			results.push_back({
+				{"name", name},
+				{"iterations", state.iterations()},
+				{"ns_per_iteration", perIteration},
+				{"counters", state.counters()},
+			});
+			continue;
+		}
+
+		std::cout << std::left << std::setw(40) << name << std::right
+			<< std::setw(12) << state.iterations() << " it"
+			<< std::setw(16) << std::fixed << std::setprecision(0) << perIteration << " ns/it";
+		for (auto const& [counter, value] : state.counters()) {
+			std::cout << "  " << counter << "=" << std::setprecision(2) << value;
+		}
+		std::cout << std::endl;
+	}
+
+	if (format == OutputFormat::JSON) {
+		// machine the results were measured on, results are only comparable between runs on the same machine
+		nlohmann::json context = {
+			{"hardware_threads", std::thread::hardware_concurrency()},
+			{"instruction_set", IASsure::simd::name(IASsure::simd::supported())},
+		};
+
+		std::cout << nlohmann::json{ {"context", context}, {"benchmarks", results} }.dump(4) << std::endl;
+	}
+
+	return 0;
+}
\ No newline at end of file
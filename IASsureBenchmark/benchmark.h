@@ -0,0 +1,58 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace IASsureBenchmark {
+	// State controls the measurement loop of a single benchmark, repeating the benchmarked code until enough time has been measured.
+	// Work done while the state is paused is excluded from the measured time.
+	class State {
+	public:
+		State(std::chrono::nanoseconds minTime);
+
+		bool keepRunning();
+		void pause();
+		void resume();
+		void setCounter(const std::string& name, double value);
+
+		size_t iterations() const;
+		std::chrono::nanoseconds elapsed() const;
+		const std::map<std::string, double>& counters() const;
+	private:
+		std::chrono::nanoseconds minTime;
+		std::chrono::nanoseconds measured;
+		std::chrono::steady_clock::time_point start;
+		size_t iteration;
+		bool running;
+		std::map<std::string, double> values;
+	};
+
+	typedef std::function<void(State& state)> BenchmarkFunction;
+
+	class Registration {
+	public:
+		Registration(const std::string& name, BenchmarkFunction f);
+	};
+
+	// registerBenchmark adds a benchmark at runtime, allowing for the same benchmark to be registered with different parameters
+	void registerBenchmark(const std::string& name, BenchmarkFunction f);
+
+	enum class OutputFormat {
+		// one line of results per benchmark, printed as soon as the benchmark has finished
+		Console,
+		// a single JSON document containing the results of all benchmarks, printed once all benchmarks have finished
+		JSON,
+	};
+
+	// run executes all registered benchmarks whose name contains filter, printing their results in the given format
+	int run(const std::string& filter, OutputFormat format = OutputFormat::Console);
+}
+
+#define BENCHMARK(name) \
+	static void name(IASsureBenchmark::State& state); \
+	static IASsureBenchmark::Registration name##Registration(#name, name); \
+	static void name(IASsureBenchmark::State& state)
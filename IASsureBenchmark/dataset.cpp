@@ -0,0 +1,90 @@
+#include "dataset.h"
+
+#include <random>
+#include <stdexcept>
+
+namespace {
+	// coordinates and level values are drawn from separate generators, allowing the coordinates to be generated on their own
+	constexpr unsigned int LEVEL_SEED_OFFSET = 1;
+
+	void AppendNumber(std::string& out, double value)
+	{
+		out += '"';
+		out += std::to_string(value);
+		out += '"';
+	}
+}
+
+std::vector<std::pair<double, double>> IASsureBenchmark::dataset::generateCoordinates(const WeatherDatasetOptions& options)
+{
+	if (options.points < 0) {
+		throw std::invalid_argument("point count must not be negative");
+	}
+
+	std::mt19937 rng(options.seed);
+	std::uniform_real_distribution<double> latitude(options.minLatitude, options.maxLatitude);
+	std::uniform_real_distribution<double> longitude(options.minLongitude, options.maxLongitude);
+
+	std::vector<std::pair<double, double>> coordinates;
+	coordinates.reserve(options.points);
+	for (int i = 0; i < options.points; i++) {
+		double lat = latitude(rng);
+		coordinates.push_back({ lat, longitude(rng) });
+	}
+
+	return coordinates;
+}
+
+std::string IASsureBenchmark::dataset::generateWeather(const WeatherDatasetOptions& options)
+{
+	if (options.levels < 1 || options.levels > MAX_LEVELS) {
+		throw std::invalid_argument("level count must be between 1 and " + std::to_string(MAX_LEVELS));
+	}
+
+	auto coordinates = generateCoordinates(options);
+
+	std::mt19937 rng(options.seed + LEVEL_SEED_OFFSET);
+	std::uniform_real_distribution<double> temperatureDeviation(-15.0, 15.0);
+	std::uniform_real_distribution<double> windSpeed(0.0, 150.0);
+	std::uniform_real_distribution<double> windDirection(0.0, 360.0);
+
+	// the JSON is written directly instead of building a DOM first, keeping memory usage low for large datasets.
+	// each level takes roughly 80 bytes
+	std::string out;
+	out.reserve((size_t)options.points * (100 + (size_t)options.levels * 80) + 100);
+
+	out += R"({"info":{"date":"2022-11-04T12:00:00Z","datestring":"0422"},"data":{)";
+	for (size_t i = 0; i < coordinates.size(); i++) {
+		if (i > 0) {
+			out += ',';
+		}
+
+		out += "\"WP" + std::to_string(i) + "\":{\"coords\":{\"lat\":";
+		AppendNumber(out, coordinates[i].first);
+		out += ",\"long\":";
+		AppendNumber(out, coordinates[i].second);
+		out += "},\"levels\":{";
+
+		double deviation = temperatureDeviation(rng);
+		for (int l = 0; l < options.levels; l++) {
+			int fl = options.levels > 1 ? l * (MAX_LEVELS - 1) / (options.levels - 1) : 0;
+			if (l > 0) {
+				out += ',';
+			}
+
+			// ISA temperature (constant above the tropopause at FL361) with a deviation per reference point
+			out += "\"" + std::to_string(fl) + "\":{\"T(K)\":";
+			AppendNumber(out, (fl < 361 ? 288.15 - fl * 0.198 : 216.65) + deviation);
+			out += ",\"windspeed\":";
+			AppendNumber(out, windSpeed(rng));
+			out += ",\"windhdg\":";
+			AppendNumber(out, windDirection(rng));
+			out += '}';
+		}
+
+		out += "}}";
+	}
+	out += "}}";
+
+	return out;
+}
\ No newline at end of file
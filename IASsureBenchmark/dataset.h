@@ -0,0 +1,36 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace IASsureBenchmark {
+	// dataset generates synthetic weather data in the same format as provided by the weather API (info, data, coords and levels),
+	// allowing parsing and lookups to be measured with datasets larger than the ones available for testing.
+	namespace dataset {
+		// highest number of levels per reference point, one per flight level between FL0 and FL450
+		constexpr int MAX_LEVELS = 451;
+
+		class WeatherDatasetOptions {
+		public:
+			// number of reference points, randomly distributed across the area below
+			int points = 10000;
+			// number of levels per reference point, evenly spread between FL0 and FL450 (46 levels result in steps of 10)
+			int levels = 46;
+			unsigned int seed = 1337;
+
+			// area covered by the reference points in degrees, defaulting to roughly the european airspace
+			double minLatitude = 35.0;
+			double maxLatitude = 70.0;
+			double minLongitude = -10.0;
+			double maxLongitude = 30.0;
+		};
+
+		// generateWeather returns the JSON weather data for the given options, always generating the same data for the same options (when built with the same standard library).
+		// throws std::invalid_argument if the point or level count is out of range.
+		std::string generateWeather(const WeatherDatasetOptions& options);
+		// generateCoordinates returns the coordinates of the reference points generated by generateWeather for the same options
+		std::vector<std::pair<double, double>> generateCoordinates(const WeatherDatasetOptions& options);
+	}
+}
\ No newline at end of file
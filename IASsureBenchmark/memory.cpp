@@ -0,0 +1,116 @@
+#include "memory.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace {
+	// allocations are prefixed with their size, keeping the prefix aligned for any fundamental type
+	constexpr size_t HEADER_SIZE = alignof(std::max_align_t);
+
+	std::atomic<size_t> currentBytes = 0;
+	std::atomic<size_t> peakBytes = 0;
+
+	void* allocate(size_t size)
+	{
+		void* ptr = std::malloc(size + HEADER_SIZE);
+		if (ptr == nullptr) {
+			throw std::bad_alloc();
+		}
+
+		*static_cast<size_t*>(ptr) = size;
+
+		size_t current = currentBytes += size;
+		size_t peak = peakBytes.load();
+		while (current > peak && !peakBytes.compare_exchange_weak(peak, current)) {
+		}
+
+		return static_cast<char*>(ptr) + HEADER_SIZE;
+	}
+
+	void deallocate(void* ptr)
+	{
+		if (ptr == nullptr) {
+			return;
+		}
+
+		void* base = static_cast<char*>(ptr) - HEADER_SIZE;
+		currentBytes -= *static_cast<size_t*>(base);
+		std::free(base);
+	}
+}
+
+size_t IASsureBenchmark::memory::current()
+{
+	return currentBytes.load();
+}
+
+size_t IASsureBenchmark::memory::peak()
+{
+	return peakBytes.load();
+}
+
+void IASsureBenchmark::memory::resetPeak()
+{
+	peakBytes = currentBytes.load();
+}
+
+void* operator new(size_t size)
+{
+	return allocate(size);
+}
+
+void* operator new[](size_t size)
+{
+	return allocate(size);
+}
+
+void* operator new(size_t size, const std::nothrow_t&) noexcept
+{
+	try {
+		return allocate(size);
+	}
+	catch (std::bad_alloc const&) {
+		return nullptr;
+	}
+}
+
+void* operator new[](size_t size, const std::nothrow_t&) noexcept
+{
+	try {
+		return allocate(size);
+	}
+	catch (std::bad_alloc const&) {
+		return nullptr;
+	}
+}
+
+void operator delete(void* ptr) noexcept
+{
+	deallocate(ptr);
+}
+
+void operator delete[](void* ptr) noexcept
+{
+	deallocate(ptr);
+}
+
+void operator delete(void* ptr, size_t) noexcept
+{
+	deallocate(ptr);
+}
+
+void operator delete[](void* ptr, size_t) noexcept
+{
+	deallocate(ptr);
+}
+
+void operator delete(void* ptr, const std::nothrow_t&) noexcept
+{
+	deallocate(ptr);
+}
+
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept
+{
+	deallocate(ptr);
+}
\ No newline at end of file
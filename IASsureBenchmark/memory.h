@@ -0,0 +1,16 @@
+#pragma once
+
+#include <cstddef>
+
+namespace IASsureBenchmark {
+	// memory reports the heap memory allocated via global operator new, tracked by replacing the global allocation
+	// functions of the benchmark binary (see memory.cpp).
+	namespace memory {
+		// currently allocated bytes
+		size_t current();
+		// highest number of allocated bytes since the last reset
+		size_t peak();
+		// resets the peak to the currently allocated bytes
+		void resetPeak();
+	}
+}
\ No newline at end of file
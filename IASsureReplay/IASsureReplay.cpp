@@ -0,0 +1,151 @@
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <optional>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "../IASsure/helpers.h"
+
+#include "replay.h"
+#include "traffic.h"
+
+namespace {
+	constexpr int COLUMN_WIDTH = 16;
+
+	void printUsage()
+	{
+		std::cerr << "usage: IASsureReplay.exe [--weather <file>] [--recording <file>] [--targets <n,...>] [--cycles <n>] [--seed <n>] [--refreshes <n>] [--delay <ms>]" << std::endl;
+	}
+
+	std::string readFile(const std::string& path)
+	{
+		std::ifstream file(path, std::ios::binary);
+		if (!file) {
+			throw std::runtime_error("failed to open " + path);
+		}
+
+		std::ostringstream content;
+		content << file.rdbuf();
+		return content.str();
+	}
+
+	void printRow(const std::string& label, const std::vector<IASsureReplay::LatencySummary>& summaries, std::chrono::nanoseconds IASsureReplay::LatencySummary::* field, double unit)
+	{
+		std::cout << std::left << std::setw(28) << label << std::right;
+		for (const IASsureReplay::LatencySummary& summary : summaries) {
+			std::cout << std::setw(COLUMN_WIDTH) << std::fixed << std::setprecision(2) << (double)(summary.*field).count() / unit;
+		}
+		std::cout << std::endl;
+	}
+
+	void printSummaries(const std::string& name, const std::string& unitName, double unit, const std::vector<IASsureReplay::LatencySummary>& summaries)
+	{
+		printRow(name + " p50 (" + unitName + ")", summaries, &IASsureReplay::LatencySummary::p50, unit);
+		printRow(name + " p99 (" + unitName + ")", summaries, &IASsureReplay::LatencySummary::p99, unit);
+		printRow(name + " max (" + unitName + ")", summaries, &IASsureReplay::LatencySummary::max, unit);
+	}
+}
+
+// usage: IASsureReplay.exe [options], replaying synthetic traffic for each of the target counts (or the given recording) and printing the
+// latencies side by side
+int main(int argc, char* argv[])
+{
+	std::vector<size_t> targetCounts = { 100, 1000, 10000 };
+	size_t cycles = 20;
+	uint32_t seed = 1;
+	std::optional<std::string> recording;
+	IASsureReplay::Settings settings;
+
+	try {
+		for (int i = 1; i < argc; i++) {
+			std::string arg = argv[i];
+			if (i + 1 >= argc) {
+				throw std::invalid_argument("missing value for " + arg);
+			}
+			std::string value = argv[++i];
+
+			if (arg == "--weather") {
+				settings.weather = readFile(value);
+			}
+			else if (arg == "--recording") {
+				recording = readFile(value);
+			}
+			else if (arg == "--targets") {
+				targetCounts.clear();
+				for (const std::string& count : IASsure::split(value, ',')) {
+					targetCounts.push_back(std::stoul(count));
+				}
+			}
+			else if (arg == "--cycles") {
+				cycles = std::stoul(value);
+			}
+			else if (arg == "--seed") {
+				seed = (uint32_t)std::stoul(value);
+			}
+			else if (arg == "--refreshes") {
+				settings.refreshes = std::stoi(value);
+			}
+			else if (arg == "--delay") {
+				settings.processingDelay = std::chrono::milliseconds(std::stoi(value));
+			}
+			else {
+				throw std::invalid_argument("unknown option " + arg);
+			}
+		}
+	}
+	catch (std::exception const& ex) {
+		std::cerr << ex.what() << std::endl;
+		printUsage();
+		return 1;
+	}
+
+	std::cout << "Replaying " << (recording.has_value() ? "recording" : std::to_string(cycles) + " radar cycles") << " (" << settings.warmupCycles << " warmup cycle) with "
+		<< settings.refreshes << " tag refresh(es) per cycle" << (settings.weather.has_value() ? ", using weather data file" : "") << std::endl;
+
+	std::vector<std::string> columns;
+	std::vector<IASsureReplay::LatencySummary> tagItemCalls;
+	std::vector<IASsureReplay::LatencySummary> positionUpdates;
+	std::vector<IASsureReplay::LatencySummary> radarCycles;
+
+	auto run = [&](IASsureReplay::Traffic& traffic) {
+		IASsureReplay::Result result = IASsureReplay::replay(traffic, settings);
+
+		columns.push_back(std::to_string(result.targets) + " targets");
+		tagItemCalls.push_back(IASsureReplay::summarize(std::move(result.tagItemCalls)));
+		positionUpdates.push_back(IASsureReplay::summarize(std::move(result.positionUpdates)));
+		radarCycles.push_back(IASsureReplay::summarize(std::move(result.radarCycles)));
+	};
+
+	try {
+		if (recording.has_value()) {
+			IASsureReplay::RecordedTraffic traffic(std::move(*recording));
+			run(traffic);
+		}
+		else {
+			for (size_t targets : targetCounts) {
+				IASsureReplay::SyntheticTraffic traffic(targets, cycles, seed);
+				run(traffic);
+			}
+		}
+	}
+	catch (std::exception const& ex) {
+		std::cerr << "Replay failed: " << ex.what() << std::endl;
+		return 1;
+	}
+
+	std::cout << std::left << std::setw(28) << "" << std::right;
+	for (const std::string& column : columns) {
+		std::cout << std::setw(COLUMN_WIDTH) << column;
+	}
+	std::cout << std::endl;
+
+	printSummaries("Tag item call", "ns", 1, tagItemCalls);
+	printSummaries("Position update", "ns", 1, positionUpdates);
+	printSummaries("Radar cycle", "us", 1000, radarCycles);
+
+	return 0;
+}
\ No newline at end of file
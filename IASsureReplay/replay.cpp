@@ -0,0 +1,166 @@
+#include "replay.h"
+
+#include <algorithm>
+#include <cmath>
+#include <string>
+#include <thread>
+#include <unordered_map>
+
+#include "../IASsure/constants.h"
+#include "../IASsure/core.h"
+#include "../IASsure/weather.h"
+
+IASsureReplay::Result IASsureReplay::replay(Traffic& traffic, const Settings& settings)
+{
+	IASsure::host::FakeHost host;
+	if (settings.weather.has_value()) {
+		// weather data is provided via the cache file, making it available synchronously once the core is loaded
+		IASsure::Weather weather(*settings.weather);
+		host.writeFile(WEATHER_CACHE_FILE_NAME, weather.serialize());
+	}
+
+	std::vector<int> tagItems = settings.tagItems;
+	if (tagItems.empty()) {
+		for (int i = 1; i <= TAG_ITEM_COUNT; i++) {
+			tagItems.push_back(i);
+		}
+	}
+
+	traffic.prepare(host);
+	IASsure::Core core(host);
+	Result result;
+
+	// latest positions of all targets, tags are refreshed for all targets known so far
+	std::vector<IASsure::host::FakeRadarTarget> targets;
+	std::unordered_map<std::string, size_t> targetIndices;
+	auto removeTarget = [&targets, &targetIndices](const std::string& callsign) {
+		auto it = targetIndices.find(callsign);
+		if (it == targetIndices.end()) {
+			return;
+		}
+
+		size_t index = it->second;
+		targetIndices.erase(it);
+		if (index != targets.size() - 1) {
+			targets[index] = std::move(targets.back());
+			targetIndices[targets[index].data.callsign] = index;
+		}
+		targets.pop_back();
+	};
+
+	std::vector<IASsure::Record> records;
+	int counter = 0;
+	for (size_t cycle = 0; traffic.next(records); cycle++) {
+		bool measured = cycle >= settings.warmupCycles;
+		std::chrono::nanoseconds cycleLatency(0);
+
+		for (IASsure::Record& record : records) {
+			switch (record.type) {
+			case IASsure::RecordType::Position:
+			{
+				auto [it, inserted] = targetIndices.try_emplace(record.position.callsign, targets.size());
+				if (inserted) {
+					targets.emplace_back();
+				}
+				IASsure::host::FakeRadarTarget& rt = targets[it->second];
+				rt.data = std::move(record.position);
+
+				auto start = std::chrono::steady_clock::now();
+				core.OnRadarTargetPositionUpdate(rt);
+				std::chrono::nanoseconds latency = std::chrono::steady_clock::now() - start;
+
+				cycleLatency += latency;
+				if (measured) {
+					result.positionUpdates.push_back(latency);
+				}
+				break;
+			}
+			case IASsure::RecordType::FlightPlan:
+			{
+				// recorded flight plans replace the stored ones, so changes made by the core during the recording are replayed as well
+				IASsure::host::FakeFlightPlan& fp = host.addFlightPlan(IASsure::host::FakeFlightPlan(record.flightPlan));
+				switch (record.event) {
+				case IASsure::FlightPlanEvent::ScratchPadUpdate:
+					core.OnFlightPlanScratchPadUpdate(fp);
+					break;
+				case IASsure::FlightPlanEvent::FlightStripReceived:
+					core.OnFlightPlanFlightStripReceived(fp);
+					break;
+				case IASsure::FlightPlanEvent::Disconnect:
+					core.OnFlightPlanDisconnect(fp);
+					removeTarget(record.flightPlan.callsign);
+					break;
+				case IASsure::FlightPlanEvent::FunctionCall:
+					core.OnFunctionCall(record.functionId, record.itemString.c_str(), fp);
+					break;
+				}
+				break;
+			}
+			case IASsure::RecordType::Command:
+				core.OnCompileCommand(record.command.c_str());
+				break;
+			case IASsure::RecordType::Weather:
+				core.ReplaceWeather(record.weather);
+				break;
+			}
+		}
+
+		if (measured) {
+			result.cycles++;
+			result.targets = (std::max)(result.targets, targets.size());
+		}
+
+		std::this_thread::sleep_for(settings.processingDelay);
+
+		for (int refresh = 0; refresh < settings.refreshes; refresh++) {
+			for (const IASsure::host::FakeRadarTarget& rt : targets) {
+				for (int item : tagItems) {
+					char content[16] = "";
+					int colorCode = IASsure::host::TAG_COLOR_DEFAULT;
+					IASsure::host::Color rgb = 0;
+
+					auto start = std::chrono::steady_clock::now();
+					core.OnGetTagItem(rt, item, content, &colorCode, &rgb);
+					std::chrono::nanoseconds latency = std::chrono::steady_clock::now() - start;
+
+					cycleLatency += latency;
+					if (measured) {
+						result.tagItemCalls.push_back(latency);
+					}
+				}
+			}
+		}
+
+		if (measured) {
+			result.radarCycles.push_back(cycleLatency);
+		}
+
+		// timers are not measured, as EuroScope calls them independently of radar cycles
+		for (int i = 0; i < RADAR_CYCLE_SECONDS; i++) {
+			core.OnTimer(++counter);
+		}
+	}
+
+	return result;
+}
+
+IASsureReplay::LatencySummary IASsureReplay::summarize(std::vector<std::chrono::nanoseconds> latencies)
+{
+	LatencySummary summary;
+	summary.count = latencies.size();
+	if (latencies.empty()) {
+		return summary;
+	}
+
+	std::sort(latencies.begin(), latencies.end());
+	auto percentile = [&latencies](double p) {
+		size_t rank = (size_t)std::ceil(p * latencies.size());
+		return latencies[(std::max)(rank, (size_t)1) - 1];
+	};
+
+	summary.p50 = percentile(0.50);
+	summary.p99 = percentile(0.99);
+	summary.max = latencies.back();
+
+	return summary;
+}
\ No newline at end of file
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "traffic.h"
+
+namespace IASsureReplay {
+	class Settings {
+	public:
+		// tag items requested for every target on each refresh, defaulting to all tag items of the plugin
+		std::vector<int> tagItems;
+		// number of times all tags are redrawn per radar cycle
+		int refreshes = 1;
+		// time given to the background pipeline between the position updates and the first tag refresh of a cycle, excluded from
+		// the measured latencies. EuroScope usually redraws tags well after the position updates of a radar cycle were processed.
+		std::chrono::milliseconds processingDelay{ 200 };
+		// number of radar cycles at the start of the replay excluded from the results, e.g. covering the first appearance of targets
+		size_t warmupCycles = 1;
+		// raw JSON of the weather data used for calculations, windless calculations are performed if unset
+		std::optional<std::string> weather;
+	};
+
+	// LatencySummary describes the distribution of a set of measured latencies
+	class LatencySummary {
+	public:
+		size_t count = 0;
+		std::chrono::nanoseconds p50{ 0 };
+		std::chrono::nanoseconds p99{ 0 };
+		std::chrono::nanoseconds max{ 0 };
+	};
+
+	class Result {
+	public:
+		size_t targets = 0;
+		size_t cycles = 0;
+		// latency of single calls of the core's callbacks
+		std::vector<std::chrono::nanoseconds> tagItemCalls;
+		std::vector<std::chrono::nanoseconds> positionUpdates;
+		// total latency of all measured calls of a radar cycle
+		std::vector<std::chrono::nanoseconds> radarCycles;
+	};
+
+	// replay feeds all radar cycles of the traffic through a plugin core running on a fake host, measuring the latency of its
+	// position updates and tag items the same way EuroScope would call them. other inputs (flight plan updates, commands and weather
+	// data swaps) are applied in their original order, but not measured
+	Result replay(Traffic& traffic, const Settings& settings);
+
+	// summarize returns the nearest-rank percentiles of the latencies
+	LatencySummary summarize(std::vector<std::chrono::nanoseconds> latencies);
+}
\ No newline at end of file
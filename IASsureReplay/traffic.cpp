@@ -0,0 +1,145 @@
+#include "traffic.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <sstream>
+
+#include "../IASsure/constants.h"
+
+namespace {
+	constexpr double PI = 3.14159265358979323846;
+	constexpr int MAX_ALTITUDE = 45000; // in ft
+	// difference between true and magnetic north across the default area
+	constexpr int MAGNETIC_VARIATION = 4; // in deg
+	// share of targets climbing or descending instead of flying level
+	constexpr double VERTICAL_SHARE = 0.25;
+}
+
+void IASsureReplay::Traffic::prepare(IASsure::host::FakeHost&)
+{
+}
+
+IASsureReplay::SyntheticTraffic::SyntheticTraffic(size_t targets, size_t cycles, uint32_t seed, const Area& area) :
+	cycle(0),
+	cycles(cycles),
+	random(seed)
+{
+	this->targets.reserve(targets);
+	for (size_t i = 0; i < targets; i++) {
+		Target target;
+
+		std::ostringstream callsign;
+		callsign << "SIM" << std::setw(5) << std::setfill('0') << i;
+		target.data.callsign = callsign.str();
+
+		target.data.latitude = this->uniform(area.minLatitude, area.maxLatitude);
+		target.data.longitude = this->uniform(area.minLongitude, area.maxLongitude);
+		target.altitude = std::round(this->uniform(0, MAX_ALTITUDE) / 100) * 100;
+		target.verticalRate = 0;
+		if (this->uniform(0, 1) < VERTICAL_SHARE) {
+			target.verticalRate = this->uniform(1000, 2500) * (this->uniform(0, 1) < 0.5 ? -1 : 1);
+		}
+
+		int heading = (int)this->uniform(0, 360) % 360;
+		target.data.reportedHeading = heading;
+		target.data.reportedHeadingTrueNorth = (heading + MAGNETIC_VARIATION) % 360;
+		// faster at higher altitudes, ranging from approach speeds to jets at cruise
+		target.data.reportedGS = (int)(140 + target.altitude / 150 + this->uniform(-30, 30));
+		target.data.calculatedGS = target.data.reportedGS;
+
+		this->targets.push_back(target);
+	}
+}
+
+bool IASsureReplay::SyntheticTraffic::next(std::vector<IASsure::Record>& records)
+{
+	if (this->cycle == this->cycles) {
+		return false;
+	}
+
+	// positions are spread evenly across the radar cycle
+	std::chrono::nanoseconds start = std::chrono::seconds(RADAR_CYCLE_SECONDS) * this->cycle;
+	std::chrono::nanoseconds interval = std::chrono::seconds(RADAR_CYCLE_SECONDS) / (std::max)(this->targets.size(), (size_t)1);
+	this->cycle++;
+
+	records.resize(this->targets.size());
+	for (size_t i = 0; i < this->targets.size(); i++) {
+		this->move(this->targets[i]);
+
+		records[i].type = IASsure::RecordType::Position;
+		records[i].time = start + interval * i;
+		records[i].position = this->targets[i].data;
+	}
+
+	return true;
+}
+
+double IASsureReplay::SyntheticTraffic::uniform(double min, double max)
+{
+	return min + (max - min) * ((double)this->random() / ((double)std::mt19937::max() + 1));
+}
+
+void IASsureReplay::SyntheticTraffic::move(Target& target)
+{
+	double distance = target.data.reportedGS * RADAR_CYCLE_SECONDS / 3600.0; // in nm
+	double heading = target.data.reportedHeadingTrueNorth * PI / 180;
+
+	target.data.latitude += distance * std::cos(heading) / 60;
+	target.data.longitude += distance * std::sin(heading) / (60 * std::cos(target.data.latitude * PI / 180));
+
+	// targets level off once reaching the ground or the maximum altitude
+	target.altitude += target.verticalRate * RADAR_CYCLE_SECONDS / 60;
+	if (target.altitude <= 0 || target.altitude >= MAX_ALTITUDE) {
+		target.altitude = (std::clamp)(target.altitude, 0.0, (double)MAX_ALTITUDE);
+		target.verticalRate = 0;
+	}
+	target.data.pressureAltitude = (int)std::round(target.altitude);
+	target.data.flightLevel = target.data.pressureAltitude;
+
+	// the ground speed estimated by the radar client jitters slightly around the reported one
+	target.data.calculatedGS = target.data.reportedGS + (int)std::round(this->uniform(-3, 3));
+}
+
+IASsureReplay::RecordedTraffic::RecordedTraffic(std::string recording) :
+	recording(std::move(recording)),
+	reader(this->recording),
+	cycleEnd(std::chrono::seconds(RADAR_CYCLE_SECONDS))
+{
+	IASsure::Record record;
+	if (this->reader.next(record)) {
+		this->pending = std::move(record);
+	}
+}
+
+void IASsureReplay::RecordedTraffic::prepare(IASsure::host::FakeHost& host)
+{
+	const IASsure::RecordingHeader& header = this->reader.header();
+	host.saveSettings(PLUGIN_NAME, "Settings", header.settings);
+	if (header.config.has_value()) {
+		host.writeFile(CONFIG_FILE_NAME, *header.config);
+	}
+}
+
+bool IASsureReplay::RecordedTraffic::next(std::vector<IASsure::Record>& records)
+{
+	if (!this->pending.has_value()) {
+		return false;
+	}
+
+	records.clear();
+	while (this->pending.has_value() && this->pending->time < this->cycleEnd) {
+		records.push_back(std::move(*this->pending));
+
+		IASsure::Record record;
+		if (this->reader.next(record)) {
+			this->pending = std::move(record);
+		}
+		else {
+			this->pending.reset();
+		}
+	}
+	this->cycleEnd += std::chrono::seconds(RADAR_CYCLE_SECONDS);
+
+	return true;
+}
\ No newline at end of file
@@ -0,0 +1,80 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "../IASsure/fakehost.h"
+#include "../IASsure/recorder.h"
+
+namespace IASsureReplay {
+	// interval between two radar position updates of a target, matching EuroScope's default radar update rate
+	constexpr int RADAR_CYCLE_SECONDS = 5;
+
+	// Traffic provides the inputs of the plugin (mostly radar position updates), one radar cycle at a time
+	class Traffic {
+	public:
+		virtual ~Traffic() = default;
+
+		// prepare stores the state of the host required before loading the core, e.g. settings
+		virtual void prepare(IASsure::host::FakeHost& host);
+		// next replaces records with the inputs of the next radar cycle in their original order, returning false once no cycles are left
+		virtual bool next(std::vector<IASsure::Record>& records) = 0;
+	};
+
+	// Area limits the positions of synthetic targets, defaulting to the area covered by the test weather data (Austria)
+	class Area {
+	public:
+		double minLatitude = 45.9;
+		double maxLatitude = 49.5;
+		double minLongitude = 10.3;
+		double maxLongitude = 17.8;
+	};
+
+	// SyntheticTraffic simulates targets flying constant headings and speeds at random positions within the area, some of them
+	// climbing or descending. The same seed always produces the same traffic.
+	class SyntheticTraffic : public Traffic {
+	public:
+		SyntheticTraffic(size_t targets, size_t cycles, uint32_t seed, const Area& area = Area());
+
+		bool next(std::vector<IASsure::Record>& records) override;
+	private:
+		// Target stores the exact simulated state, radar positions are rounded like the ones reported by EuroScope
+		struct Target {
+			IASsure::host::RadarTargetData data;
+			double altitude; // in ft
+			double verticalRate; // in ft/min
+		};
+
+		std::vector<Target> targets;
+		size_t cycle;
+		size_t cycles;
+		// mt19937 produces the same sequence on all platforms, unlike the standard library's distributions
+		std::mt19937 random;
+
+		double uniform(double min, double max);
+		void move(Target& target);
+	};
+
+	// RecordedTraffic replays a recording created via .ias record, splitting its inputs into radar cycles by their recorded time
+	class RecordedTraffic : public Traffic {
+	public:
+		// RecordedTraffic throws std::invalid_argument for invalid recordings
+		RecordedTraffic(std::string recording);
+
+		RecordedTraffic(const RecordedTraffic&) = delete;
+		RecordedTraffic& operator=(const RecordedTraffic&) = delete;
+
+		void prepare(IASsure::host::FakeHost& host) override;
+		bool next(std::vector<IASsure::Record>& records) override;
+	private:
+		std::string recording;
+		IASsure::RecordingReader reader;
+		// first record of the following cycle, read while collecting the current one
+		std::optional<IASsure::Record> pending;
+		std::chrono::nanoseconds cycleEnd;
+	};
+}
\ No newline at end of file
@@ -0,0 +1,130 @@
+#include <CppUnitTest.h>
+
+#include <map>
+#include <random>
+#include <string>
+
+#include "../IASsure/aircraft.h"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace IASsureTest
+{
+	TEST_CLASS(Aircraft)
+	{
+	public:
+		TEST_METHOD(TestAircraftStateToggles)
+		{
+			IASsure::AircraftState state;
+			Assert::IsTrue(state.empty());
+			Assert::IsFalse(state.isToggled(IASsure::AircraftToggle::CalculatedIAS));
+
+			Assert::IsTrue(state.toggle(IASsure::AircraftToggle::CalculatedIAS));
+			Assert::IsTrue(state.isToggled(IASsure::AircraftToggle::CalculatedIAS));
+			Assert::IsFalse(state.isToggled(IASsure::AircraftToggle::CalculatedIASAbbreviated));
+			Assert::IsFalse(state.empty());
+
+			state.setToggled(IASsure::AircraftToggle::UnreliableSpeed, true);
+			Assert::IsTrue(state.isToggled(IASsure::AircraftToggle::UnreliableSpeed));
+
+			Assert::IsFalse(state.toggle(IASsure::AircraftToggle::CalculatedIAS));
+			state.setToggled(IASsure::AircraftToggle::UnreliableSpeed, false);
+			Assert::IsTrue(state.empty());
+
+			state.reportedMach = 0.78;
+			Assert::IsFalse(state.empty());
+		}
+
+		TEST_METHOD(TestCallsignMap)
+		{
+			IASsure::CallsignMap<IASsure::AircraftState> map;
+			Assert::AreEqual((size_t)0, map.size());
+			Assert::IsNull(map.find("DLH123"));
+			Assert::IsFalse(map.erase("DLH123"));
+
+			map.get("DLH123").reportedIAS = 250;
+			map.get("AUA456").reportedMach = 0.78;
+			Assert::AreEqual((size_t)2, map.size());
+
+			IASsure::AircraftState* state = map.find("DLH123");
+			Assert::IsNotNull(state);
+			Assert::AreEqual(250, *state->reportedIAS);
+			Assert::AreEqual(0.78, *map.find("AUA456", IASsure::hashCallsign("AUA456"))->reportedMach);
+
+			// get returns existing entries
+			map.get("DLH123").setToggled(IASsure::AircraftToggle::CalculatedMach, true);
+			Assert::AreEqual((size_t)2, map.size());
+			Assert::AreEqual(250, *map.find("DLH123")->reportedIAS);
+
+			Assert::IsTrue(map.erase("DLH123"));
+			Assert::IsNull(map.find("DLH123"));
+			Assert::AreEqual((size_t)1, map.size());
+
+			// reinserted entries start with a clean state
+			Assert::IsTrue(map.get("DLH123").empty());
+
+			map.clear();
+			Assert::AreEqual((size_t)0, map.size());
+			Assert::IsNull(map.find("AUA456"));
+			Assert::IsTrue(map.get("AUA456").empty());
+		}
+
+		TEST_METHOD(TestCallsignMapMatchesReference)
+		{
+			// random inserts and erases across several growths, compared against std::map
+			IASsure::CallsignMap<int> map;
+			std::map<std::string, int> reference;
+			std::mt19937 rng(42);
+
+			for (int i = 0; i < 20000; i++) {
+				std::string callsign = "CS" + std::to_string(rng() % 2000);
+				if (rng() % 3 == 0) {
+					Assert::AreEqual(reference.erase(callsign) == 1, map.erase(callsign));
+				}
+				else {
+					map.get(callsign) = i;
+					reference[callsign] = i;
+				}
+			}
+
+			Assert::AreEqual(reference.size(), map.size());
+			for (const auto& [callsign, value] : reference) {
+				int* found = map.find(callsign);
+				Assert::IsNotNull(found);
+				Assert::AreEqual(value, *found);
+			}
+
+			size_t visited = 0;
+			map.forEach([&](std::string_view callsign, int& value) {
+				Assert::AreEqual(reference.at(std::string(callsign)), value);
+				visited++;
+				});
+			Assert::AreEqual(reference.size(), visited);
+		}
+
+		TEST_METHOD(TestCallsignMapEraseIf)
+		{
+			IASsure::CallsignMap<int> map;
+			for (int i = 0; i < 1000; i++) {
+				map.get("CS" + std::to_string(i)) = i;
+			}
+
+			size_t erased = map.eraseIf([](std::string_view, int value) {
+				return value % 3 == 0;
+				});
+			Assert::AreEqual((size_t)334, erased);
+			Assert::AreEqual((size_t)666, map.size());
+
+			for (int i = 0; i < 1000; i++) {
+				int* found = map.find("CS" + std::to_string(i));
+				if (i % 3 == 0) {
+					Assert::IsNull(found);
+				}
+				else {
+					Assert::IsNotNull(found);
+					Assert::AreEqual(i, *found);
+				}
+			}
+		}
+	};
+}
\ No newline at end of file
@@ -0,0 +1,195 @@
+#include <CppUnitTest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include "../IASsure/batch.h"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace IASsureTest
+{
+	TEST_CLASS(Batch)
+	{
+	public:
+		std::vector<IASsure::simd::InstructionSet> SupportedInstructionSets()
+		{
+			std::vector<IASsure::simd::InstructionSet> instructionSets = { IASsure::simd::InstructionSet::Scalar };
+			if (IASsure::simd::supported() >= IASsure::simd::InstructionSet::AVX2) {
+				instructionSets.push_back(IASsure::simd::InstructionSet::AVX2);
+			}
+
+			return instructionSets;
+		}
+
+		void AssertResult(double expected, double actual)
+		{
+			Assert::AreEqual(expected, actual, (std::max)(std::abs(expected), 1.0) * IASsure::AIR_DATA_BATCH_TOLERANCE);
+		}
+
+		// compares all batch results to the scalar calculations using the Exact model, expecting NaN wherever the scalar calculations throw
+		void AssertMatchesScalar(IASsure::AirDataBatch& batch)
+		{
+			for (auto instructionSet : SupportedInstructionSets()) {
+				IASsure::calculateAirData(batch, instructionSet);
+				Assert::AreEqual(batch.size(), batch.tas.size());
+				Assert::AreEqual(batch.size(), batch.cas.size());
+				Assert::AreEqual(batch.size(), batch.mach.size());
+
+				for (size_t i = 0; i < batch.size(); i++) {
+					IASsure::WeatherReferenceLevel lvl{ batch.temperature[i], batch.windSpeed[i], batch.windDirection[i] };
+
+					try {
+						AssertResult(IASsure::calculateTAS(batch.heading[i], batch.groundSpeed[i], lvl), batch.tas[i]);
+					}
+					catch (std::domain_error const&) {
+						Assert::IsTrue(std::isnan(batch.tas[i]));
+					}
+
+					try {
+						AssertResult(IASsure::calculateCAS(batch.altitude[i], batch.heading[i], batch.groundSpeed[i], lvl, IASsure::AtmosphereModel::Exact), batch.cas[i]);
+					}
+					catch (std::domain_error const&) {
+						Assert::IsTrue(std::isnan(batch.cas[i]));
+					}
+
+					try {
+						AssertResult(IASsure::calculateMach(batch.altitude[i], batch.heading[i], batch.groundSpeed[i], lvl, IASsure::AtmosphereModel::Exact), batch.mach[i]);
+					}
+					catch (std::domain_error const&) {
+						Assert::IsTrue(std::isnan(batch.mach[i]));
+					}
+				}
+			}
+		}
+
+		TEST_METHOD(TestCalculationCases)
+		{
+			// cases of the scalar calculation tests
+			IASsure::AirDataBatch batch;
+			for (int windDirection = 0; windDirection <= 360; windDirection += 30) {
+				batch.add(10000, 0, 300, IASsure::WeatherReferenceLevel{ 250, 40, (double)windDirection });
+			}
+			batch.add(10000, 0, 300, IASsure::WeatherReferenceLevel{ 0, 0, 0 });
+			for (int alt : { -1240, 0, 10000, 38000 }) {
+				for (int gs : { 240, 420 }) {
+					batch.add(alt, 0, gs, IASsure::WeatherReferenceLevel{ 0, 0, 0 });
+				}
+			}
+			batch.add(69000, 0, 240, IASsure::WeatherReferenceLevel{ 0, 0, 0 });
+			batch.add(0, 0, -240, IASsure::WeatherReferenceLevel{ 0, 0, 0 });
+
+			AssertMatchesScalar(batch);
+
+			IASsure::calculateAirData(batch);
+			AssertResult(340.0, batch.tas[0]);
+			AssertResult(265.35898384862247, batch.tas[5]);
+			AssertResult(243.92230995503945, batch.cas[14]);
+			AssertResult(229.80073722586474, batch.cas[21]);
+			AssertResult(0.36090021075556744, batch.mach[14]);
+			AssertResult(0.73147357250152079, batch.mach[21]);
+		}
+
+		TEST_METHOD(TestRandomInputs)
+		{
+			std::mt19937 rng(2024);
+			std::uniform_real_distribution<double> alt(-2000, 70000);
+			std::uniform_real_distribution<double> heading(-360, 720);
+			std::uniform_real_distribution<double> gs(-50, 650);
+			std::uniform_real_distribution<double> temperature(200, 310);
+			std::uniform_real_distribution<double> windSpeed(0, 200);
+			std::uniform_real_distribution<double> windDirection(0, 360);
+
+			// every batch size up to a few vector widths covers remainder handling
+			for (size_t count = 0; count <= 40; count++) {
+				IASsure::AirDataBatch batch;
+				for (size_t i = 0; i < count; i++) {
+					if (i % 3 == 0) {
+						batch.add(alt(rng), heading(rng), gs(rng), IASsure::WeatherReferenceLevel{ 0, 0, 0 });
+					}
+					else {
+						batch.add(alt(rng), heading(rng), gs(rng), IASsure::WeatherReferenceLevel{ temperature(rng), windSpeed(rng), windDirection(rng) });
+					}
+				}
+
+				AssertMatchesScalar(batch);
+			}
+		}
+
+		TEST_METHOD(TestUnsupportedRange)
+		{
+			IASsure::AirDataBatch batch;
+			// negative ground speed
+			batch.add(10000, 0, -240, IASsure::WeatherReferenceLevel{ 250, 40, 0 });
+			// altitude above supported range without weather data
+			batch.add(69000, 0, 240, IASsure::WeatherReferenceLevel{ 0, 0, 0 });
+			// altitude above supported range with weather data, Mach number can still be calculated
+			batch.add(69000, 0, 240, IASsure::WeatherReferenceLevel{ 220, 40, 90 });
+			// headwind exceeding ground speed
+			batch.add(10000, 0, 30, IASsure::WeatherReferenceLevel{ 250, 40, 180 });
+
+			for (auto instructionSet : SupportedInstructionSets()) {
+				IASsure::calculateAirData(batch, instructionSet);
+
+				Assert::IsTrue(std::isnan(batch.tas[0]));
+				Assert::IsTrue(std::isnan(batch.cas[0]));
+				Assert::IsTrue(std::isnan(batch.mach[0]));
+
+				AssertResult(240, batch.tas[1]);
+				Assert::IsTrue(std::isnan(batch.cas[1]));
+				Assert::IsTrue(std::isnan(batch.mach[1]));
+
+				AssertResult(240, batch.tas[2]);
+				Assert::IsTrue(std::isnan(batch.cas[2]));
+				AssertResult(IASsure::calculateMach(69000, 0, 240, IASsure::WeatherReferenceLevel{ 220, 40, 90 }), batch.mach[2]);
+
+				AssertResult(-10, batch.tas[3]);
+				Assert::IsTrue(std::isnan(batch.cas[3]));
+				Assert::IsTrue(std::isnan(batch.mach[3]));
+			}
+		}
+
+		TEST_METHOD(TestThreadPool)
+		{
+			std::mt19937 rng(2025);
+			std::uniform_real_distribution<double> alt(-2000, 70000);
+			std::uniform_real_distribution<double> heading(0, 360);
+			std::uniform_real_distribution<double> gs(-50, 650);
+			std::uniform_real_distribution<double> temperature(200, 310);
+			std::uniform_real_distribution<double> windSpeed(0, 200);
+			std::uniform_real_distribution<double> windDirection(0, 360);
+
+			// several ranges with a remainder not divisible by the vector width
+			IASsure::AirDataBatch batch;
+			for (size_t i = 0; i < 3 * IASsure::AIR_DATA_BATCH_GRAIN_SIZE + 3; i++) {
+				batch.add(alt(rng), heading(rng), gs(rng), IASsure::WeatherReferenceLevel{ temperature(rng), windSpeed(rng), windDirection(rng) });
+			}
+
+			IASsure::thread::ThreadPool pool(3);
+			for (auto instructionSet : SupportedInstructionSets()) {
+				IASsure::AirDataBatch expected = batch;
+				IASsure::calculateAirData(expected, instructionSet);
+				IASsure::calculateAirData(batch, instructionSet, pool);
+
+				for (size_t i = 0; i < batch.size(); i++) {
+					Assert::IsTrue(expected.tas[i] == batch.tas[i] || (std::isnan(expected.tas[i]) && std::isnan(batch.tas[i])));
+					Assert::IsTrue(expected.cas[i] == batch.cas[i] || (std::isnan(expected.cas[i]) && std::isnan(batch.cas[i])));
+					Assert::IsTrue(expected.mach[i] == batch.mach[i] || (std::isnan(expected.mach[i]) && std::isnan(batch.mach[i])));
+				}
+			}
+		}
+
+		TEST_METHOD(TestInputSizeMismatch)
+		{
+			IASsure::AirDataBatch batch;
+			batch.add(10000, 0, 240, IASsure::WeatherReferenceLevel{ 0, 0, 0 });
+			batch.heading.push_back(0);
+
+			Assert::ExpectException<std::invalid_argument>([&batch]() {
+				IASsure::calculateAirData(batch);
+				});
+		}
+	};
+}
\ No newline at end of file
@@ -1,6 +1,9 @@
 #include <CppUnitTest.h>
 
+#include <cmath>
+
 #include "../IASsure/calculations.h"
+#include "../IASsure/isa.h"
 
 using namespace Microsoft::VisualStudio::CppUnitTestFramework;
 
@@ -174,5 +177,153 @@ namespace IASsureTest
 				double mach = IASsure::calculateMach(alt, 0, tas, IASsure::WeatherReferenceLevel{ 0, 0, 0 });
 				});
 		}
+
+		TEST_METHOD(TestConstexprMath)
+		{
+			static_assert(IASsure::isa::exp(0) == 1);
+			static_assert(IASsure::isa::log(1) == 0);
+
+			for (double x = -5; x <= 5; x += 0.01) {
+				Assert::AreEqual(std::exp(x), IASsure::isa::exp(x), std::exp(x) * 1e-14);
+			}
+			for (double x = 0.01; x <= 10; x += 0.01) {
+				Assert::AreEqual(std::log(x), IASsure::isa::log(x), 1e-14);
+			}
+			Assert::AreEqual(std::pow(0.8, 5.2559), IASsure::isa::pow(0.8, 5.2559), 1e-14);
+		}
+
+		void AssertStatus(IASsure::CalculationStatus expected, const IASsure::CalculationResult& result)
+		{
+			Assert::IsTrue(expected == result.status);
+			Assert::AreEqual(expected == IASsure::CalculationStatus::Success, result.ok());
+		}
+
+		TEST_METHOD(TestTryCalculate)
+		{
+			IASsure::WeatherReferenceLevel zero{ 0, 0, 0 };
+			IASsure::WeatherReferenceLevel wind{ 250, 40, 180 };
+
+			// results match the throwing functions
+			IASsure::CalculationResult result = IASsure::tryCalculateCAS(38000, 0, 420, zero);
+			AssertStatus(IASsure::CalculationStatus::Success, result);
+			Assert::AreEqual(229.80073722586474, result.value);
+			result = IASsure::tryCalculateMach(38000, 0, 420, zero);
+			AssertStatus(IASsure::CalculationStatus::Success, result);
+			Assert::AreEqual(0.73147357250152079, result.value);
+			result = IASsure::tryCalculateTAS(0, 300, IASsure::WeatherReferenceLevel{ 0, 40, 150 });
+			AssertStatus(IASsure::CalculationStatus::Success, result);
+			Assert::AreEqual(265.35898384862247, result.value);
+			result = IASsure::tryCalculateStaticPressure(10000);
+			AssertStatus(IASsure::CalculationStatus::Success, result);
+			Assert::AreEqual(69681.642852424309, result.value);
+
+			// parked aircraft
+			AssertStatus(IASsure::CalculationStatus::GroundSpeedOutOfRange, IASsure::tryCalculateTAS(0, 0, zero));
+			AssertStatus(IASsure::CalculationStatus::GroundSpeedOutOfRange, IASsure::tryCalculateCAS(0, 0, 0, zero));
+			AssertStatus(IASsure::CalculationStatus::GroundSpeedOutOfRange, IASsure::tryCalculateMach(0, 0, 0, zero));
+
+			// above the atmosphere model, Mach numbers can still be calculated using the reported temperature
+			AssertStatus(IASsure::CalculationStatus::AltitudeOutOfRange, IASsure::tryCalculateTemperature(69000));
+			AssertStatus(IASsure::CalculationStatus::AltitudeOutOfRange, IASsure::tryCalculateStaticPressure(69000, IASsure::AtmosphereModel::Table));
+			AssertStatus(IASsure::CalculationStatus::AltitudeOutOfRange, IASsure::tryCalculateCAS(69000, 0, 240, wind));
+			AssertStatus(IASsure::CalculationStatus::AltitudeOutOfRange, IASsure::tryCalculateMach(69000, 0, 240, zero));
+			AssertStatus(IASsure::CalculationStatus::Success, IASsure::tryCalculateMach(69000, 0, 240, wind));
+
+			// headwind exceeding ground speed
+			AssertStatus(IASsure::CalculationStatus::TrueAirSpeedOutOfRange, IASsure::tryCalculateCAS(10000, 0, 30, wind));
+			AssertStatus(IASsure::CalculationStatus::TrueAirSpeedOutOfRange, IASsure::tryCalculateMach(10000, 0, 30, wind));
+			AssertStatus(IASsure::CalculationStatus::TrueAirSpeedOutOfRange, IASsure::tryCalculateDynamicPressure(101325, 288.15, -240));
+		}
+
+		void AssertResultTable(int alt, double gs, double cas, double mach)
+		{
+			IASsure::WeatherReferenceLevel lvl{ 0, 0, 0 };
+			Assert::AreEqual(cas, IASsure::calculateCAS(alt, 0, gs, lvl, IASsure::AtmosphereModel::Table), cas * 1e-7);
+			Assert::AreEqual(mach, IASsure::calculateMach(alt, 0, gs, lvl, IASsure::AtmosphereModel::Table), mach * 1e-7);
+		}
+
+		TEST_METHOD(TestAtmosphereTable)
+		{
+			// every foot within the table range, including the tropopause between two table entries
+			for (int alt = -2000; alt <= 65616; alt++) {
+				double exactTemperature = IASsure::calculateTemperature(alt, IASsure::AtmosphereModel::Exact);
+				double tableTemperature = IASsure::calculateTemperature(alt, IASsure::AtmosphereModel::Table);
+				Assert::AreEqual(exactTemperature, tableTemperature, exactTemperature * 1e-7);
+
+				double exactPressure = IASsure::calculateStaticPressure(alt, IASsure::AtmosphereModel::Exact);
+				double tablePressure = IASsure::calculateStaticPressure(alt, IASsure::AtmosphereModel::Table);
+				Assert::AreEqual(exactPressure, tablePressure, exactPressure * 1e-7);
+			}
+
+			// altitudes below the table use the exact calculation, altitudes above the model are still rejected
+			Assert::AreEqual(IASsure::calculateStaticPressure(-3000), IASsure::calculateStaticPressure(-3000, IASsure::AtmosphereModel::Table));
+			Assert::ExpectException<std::domain_error>([]() {
+				IASsure::calculateStaticPressure(69000, IASsure::AtmosphereModel::Table);
+				});
+
+			AssertResultTable(38000, 420, 229.80073722586474, 0.73147357250152079);
+			AssertResultTable(-1240, 240, 243.92230995503945, 0.36090021075556744);
+		}
+
+		void AssertResultEqual(const IASsure::CalculationResult& expected, const IASsure::CalculationResult& actual)
+		{
+			AssertStatus(expected.status, actual);
+			if (expected.ok()) {
+				Assert::AreEqual(expected.value, actual.value);
+			}
+		}
+
+		void AssertAirData(double alt, double hdg, double gs, IASsure::WeatherReferenceLevel lvl, IASsure::AtmosphereModel model)
+		{
+			IASsure::AirData data = IASsure::calculateAirData(alt, hdg, gs, lvl, model);
+			AssertResultEqual(IASsure::tryCalculateTAS(hdg, gs, lvl), data.tas);
+			AssertResultEqual(IASsure::tryCalculateCAS(alt, hdg, gs, lvl, model), data.cas);
+			AssertResultEqual(IASsure::tryCalculateMach(alt, hdg, gs, lvl, model), data.mach);
+		}
+
+		TEST_METHOD(TestCalculateAirData)
+		{
+			IASsure::WeatherReferenceLevel zero{ 0, 0, 0 };
+			IASsure::WeatherReferenceLevel wind{ 250, 40, 180 };
+
+			// results and statuses match the individual calculations
+			for (IASsure::AtmosphereModel model : { IASsure::AtmosphereModel::Exact, IASsure::AtmosphereModel::Table }) {
+				AssertAirData(38000, 0, 420, zero, model);
+				AssertAirData(38000, 90, 420, wind, model);
+				AssertAirData(-1240, 270, 240, wind, model);
+				AssertAirData(0, 0, 0, zero, model);
+				AssertAirData(69000, 0, 240, zero, model);
+				AssertAirData(69000, 0, 240, wind, model);
+				AssertAirData(10000, 0, 30, wind, model);
+			}
+
+			IASsure::AirData data = IASsure::calculateAirData(38000, 0, 420, zero);
+			AssertStatus(IASsure::CalculationStatus::Success, data.temperature);
+			Assert::AreEqual(IASsure::calculateTemperature(38000), data.temperature.value);
+			AssertStatus(IASsure::CalculationStatus::Success, data.isaDeviation);
+			Assert::AreEqual(0.0, data.isaDeviation.value);
+			AssertStatus(IASsure::CalculationStatus::Success, data.windComponent);
+			Assert::AreEqual(0.0, data.windComponent.value);
+
+			// headwind from straight ahead, temperature from weather data
+			data = IASsure::calculateAirData(10000, 180, 300, wind);
+			Assert::AreEqual(250.0, data.temperature.value);
+			Assert::AreEqual(250.0 - IASsure::calculateTemperature(10000), data.isaDeviation.value, 1e-9);
+			Assert::AreEqual(40.0, data.windComponent.value, 1e-9);
+			Assert::AreEqual(340.0, data.tas.value, 1e-9);
+
+			// tailwind, wind component is available for parked aircraft as well
+			data = IASsure::calculateAirData(0, 0, 0, wind);
+			AssertStatus(IASsure::CalculationStatus::GroundSpeedOutOfRange, data.tas);
+			AssertStatus(IASsure::CalculationStatus::Success, data.windComponent);
+			Assert::AreEqual(-40.0, data.windComponent.value, 1e-9);
+
+			// above the atmosphere model
+			data = IASsure::calculateAirData(69000, 0, 240, wind);
+			AssertStatus(IASsure::CalculationStatus::Success, data.temperature);
+			AssertStatus(IASsure::CalculationStatus::AltitudeOutOfRange, data.isaDeviation);
+			data = IASsure::calculateAirData(69000, 0, 240, zero);
+			AssertStatus(IASsure::CalculationStatus::AltitudeOutOfRange, data.temperature);
+		}
 	};
 }
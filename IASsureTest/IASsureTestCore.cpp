@@ -0,0 +1,238 @@
+#include <CppUnitTest.h>
+
+#include <chrono>
+#include <fstream>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../IASsure/core.h"
+#include "../IASsure/fakehost.h"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace IASsureTest
+{
+	TEST_CLASS(Core)
+	{
+	public:
+		std::string GetTagItem(IASsure::Core& core, const IASsure::host::RadarTarget& rt, int itemCode, int* colorCode = nullptr, IASsure::host::Color* rgb = nullptr)
+		{
+			char content[16] = "unchanged";
+			int color = IASsure::host::TAG_COLOR_DEFAULT;
+			IASsure::host::Color value = 0;
+			core.OnGetTagItem(rt, itemCode, content, &color, &value);
+
+			if (colorCode != nullptr) {
+				*colorCode = color;
+			}
+			if (rgb != nullptr) {
+				*rgb = value;
+			}
+
+			return content;
+		}
+
+		std::string FormatIAS(const IASsure::AirData& data, std::optional<double> reported = std::nullopt)
+		{
+			char content[16];
+			IASsure::format::formatIAS(content, 16, "I", data.cas.value, reported, false);
+			return content;
+		}
+
+		std::string FormatMach(const IASsure::AirData& data, int digits)
+		{
+			char content[16];
+			IASsure::format::formatMach(content, 16, "M", data.mach.value, std::nullopt, digits);
+			return content;
+		}
+
+		bool HasMessage(const IASsure::host::FakeHost& host, const std::string& message)
+		{
+			for (const IASsure::host::FakeMessage& msg : host.messages()) {
+				if (msg.message == message) {
+					return true;
+				}
+			}
+			return false;
+		}
+
+		TEST_METHOD(TestTagItems)
+		{
+			IASsure::host::FakeHost host;
+			IASsure::Core core(host);
+			Assert::IsTrue(HasMessage(host, "No saved settings found, using defaults."));
+
+			// without weather data, speeds are calculated without wind and with ISA temperatures
+			IASsure::host::FakeRadarTarget rt("DLH123", 48.35, 11.78, 37000, 90, 460);
+			IASsure::AirData expected = IASsure::calculateAirData(37000, 90, 460, IASsure::WeatherReferenceLevel{ 0, 0, 0 }, IASsure::AtmosphereModel::Table);
+			core.OnRadarTargetPositionUpdate(rt);
+
+			Assert::AreEqual(FormatIAS(expected), GetTagItem(core, rt, TAG_ITEM_CALCULATED_IAS));
+			Assert::AreEqual(FormatMach(expected, 2), GetTagItem(core, rt, TAG_ITEM_CALCULATED_MACH));
+			Assert::AreEqual(std::string(""), GetTagItem(core, rt, TAG_ITEM_CALCULATED_IAS_TOGGLABLE));
+			Assert::AreEqual(std::string("unchanged"), GetTagItem(core, rt, TAG_ITEM_COUNT + 1));
+
+			// tag items are updated for new positions, calculated synchronously if the background result is not available yet
+			IASsure::host::FakeRadarTarget descent("DLH123", 48.3, 11.7, 24000, 270, 380);
+			IASsure::AirData updated = IASsure::calculateAirData(24000, 270, 380, IASsure::WeatherReferenceLevel{ 0, 0, 0 }, IASsure::AtmosphereModel::Table);
+			core.OnRadarTargetPositionUpdate(descent);
+			std::string ias = GetTagItem(core, descent, TAG_ITEM_CALCULATED_IAS);
+			Assert::IsTrue(ias == FormatIAS(updated) || ias == FormatIAS(expected));
+			for (int i = 0; i < 100 && GetTagItem(core, descent, TAG_ITEM_CALCULATED_IAS) != FormatIAS(updated); i++) {
+				std::this_thread::sleep_for(std::chrono::milliseconds(50));
+			}
+			Assert::AreEqual(FormatIAS(updated), GetTagItem(core, descent, TAG_ITEM_CALCULATED_IAS));
+
+			// reported speeds and toggles are set via tag functions of the flight plan
+			IASsure::host::FakeFlightPlan fp("DLH123");
+			core.OnFunctionCall(TAG_FUNC_SET_REPORTED_IAS, "280", fp);
+			core.OnFunctionCall(TAG_FUNC_TOGGLE_CALCULATED_IAS, "", fp);
+			Assert::AreEqual(FormatIAS(updated, 280), GetTagItem(core, descent, TAG_ITEM_CALCULATED_IAS));
+			Assert::AreEqual(FormatIAS(updated, 280), GetTagItem(core, descent, TAG_ITEM_CALCULATED_IAS_TOGGLABLE));
+
+			core.OnFunctionCall(TAG_FUNC_CLEAR_REPORTED_IAS, "", fp);
+			Assert::AreEqual(FormatIAS(updated), GetTagItem(core, descent, TAG_ITEM_CALCULATED_IAS));
+			Assert::AreEqual((int)IASsure::roundToNearest(updated.cas.value, INTERVAL_REPORTED_IAS), core.GetReportedIASSelection(descent));
+			Assert::AreEqual((int)IASsure::roundToNearest(updated.mach.value * 100, INTERVAL_REPORTED_MACH), core.GetReportedMachSelection(descent));
+		}
+
+		TEST_METHOD(TestCommands)
+		{
+			IASsure::host::FakeHost host;
+			IASsure::host::FakeRadarTarget rt("DLH123", 48.35, 11.78, 37000, 90, 460);
+			IASsure::AirData expected = IASsure::calculateAirData(37000, 90, 460, IASsure::WeatherReferenceLevel{ 0, 0, 0 }, IASsure::AtmosphereModel::Table);
+
+			{
+				IASsure::Core core(host);
+				Assert::IsFalse(core.OnCompileCommand(".other command"));
+				Assert::IsTrue(core.OnCompileCommand(".ias mach digits 3"));
+				Assert::IsTrue(HasMessage(host, "Displaying mach numbers with 3 digits precision"));
+				Assert::AreEqual(FormatMach(expected, 3), GetTagItem(core, rt, TAG_ITEM_CALCULATED_MACH));
+
+				Assert::IsTrue(core.OnCompileCommand(".ias mach digits 42"));
+				Assert::AreEqual(FormatMach(expected, 3), GetTagItem(core, rt, TAG_ITEM_CALCULATED_MACH));
+			}
+
+			// settings are persisted by the host
+			std::optional<std::string> settings = host.loadSettings(PLUGIN_NAME);
+			Assert::IsTrue(settings.has_value());
+			Assert::AreEqual(std::string("3"), IASsure::split(*settings, SETTINGS_DELIMITER)[4]);
+
+			host.clearMessages();
+			IASsure::Core core(host);
+			Assert::IsFalse(HasMessage(host, "No saved settings found, using defaults."));
+			Assert::AreEqual(FormatMach(expected, 3), GetTagItem(core, rt, TAG_ITEM_CALCULATED_MACH));
+		}
+
+		TEST_METHOD(TestCommandsKeepAirData)
+		{
+			IASsure::host::FakeHost host;
+			IASsure::host::FakeRadarTarget rt("DLH123", 48.35, 11.78, 37000, 90, 460);
+			IASsure::AirData expected = IASsure::calculateAirData(37000, 90, 460, IASsure::WeatherReferenceLevel{ 0, 0, 0 }, IASsure::AtmosphereModel::Table);
+			IASsure::Core core(host);
+
+			// commands not changing settings keep the air data of the pipeline, others recalculate it with the target passed to the tag item
+			IASsure::host::FakeRadarTarget descent("DLH123", 48.3, 11.7, 24000, 270, 380);
+			IASsure::AirData updated = IASsure::calculateAirData(24000, 270, 380, IASsure::WeatherReferenceLevel{ 0, 0, 0 }, IASsure::AtmosphereModel::Table);
+			core.OnRadarTargetPositionUpdate(descent);
+			Assert::AreEqual(FormatIAS(updated), GetTagItem(core, descent, TAG_ITEM_CALCULATED_IAS));
+
+			Assert::IsTrue(core.OnCompileCommand(".ias"));
+			Assert::IsTrue(core.OnCompileCommand(".ias state"));
+			Assert::IsTrue(core.OnCompileCommand(".ias weather"));
+			Assert::AreEqual(FormatIAS(updated), GetTagItem(core, rt, TAG_ITEM_CALCULATED_IAS));
+
+			Assert::IsTrue(core.OnCompileCommand(".ias gs"));
+			Assert::AreEqual(FormatIAS(expected), GetTagItem(core, rt, TAG_ITEM_CALCULATED_IAS));
+		}
+
+		TEST_METHOD(TestUnreliableSpeed)
+		{
+			IASsure::host::FakeHost host;
+			host.writeFile(CONFIG_FILE_NAME, R"({"ias": {"unreliableIndicator": "XIAS", "unreliableColor": "1,2,3"}})");
+			IASsure::host::FakeRadarTarget rt("DLH123", 48.35, 11.78, 37000, 90, 460);
+
+			IASsure::Core core(host);
+			IASsure::host::FakeFlightPlan& fp = host.addFlightPlan(IASsure::host::FakeFlightPlan("DLH123"));
+			core.OnFunctionCall(TAG_FUNC_TOGGLE_UNRELIABLE_SPEED, "", fp);
+
+			int colorCode;
+			IASsure::host::Color rgb;
+			Assert::AreEqual(std::string("XIAS"), GetTagItem(core, rt, TAG_ITEM_CALCULATED_IAS, &colorCode, &rgb));
+			Assert::AreEqual(IASsure::host::TAG_COLOR_RGB_DEFINED, colorCode);
+			Assert::AreEqual(IASsure::host::rgb(1, 2, 3), rgb);
+
+			// untracked flight plans are broadcast via the flight strip annotation and the scratch pad, restoring the previous scratch pad
+			Assert::AreEqual(std::string("IAS/US"), fp.data.flightStripAnnotations[BROADCAST_FLIGHT_STRIP_INDEX]);
+			Assert::AreEqual((size_t)2, fp.scratchPadHistory.size());
+			Assert::AreEqual(std::string("IAS/US/1"), fp.scratchPadHistory[0]);
+			Assert::AreEqual(std::string(""), fp.data.scratchPad);
+
+			// other controllers pick up the broadcast
+			IASsure::Core other(host);
+			IASsure::host::FakeFlightPlan received("DLH123");
+			received.data.scratchPad = "IAS/US/1";
+			other.OnFlightPlanScratchPadUpdate(received);
+			Assert::AreEqual(std::string("XIAS"), GetTagItem(other, rt, TAG_ITEM_CALCULATED_IAS));
+
+			received.data.scratchPad = "IAS/US/0";
+			other.OnFlightPlanScratchPadUpdate(received);
+			Assert::AreNotEqual(std::string("XIAS"), GetTagItem(other, rt, TAG_ITEM_CALCULATED_IAS));
+
+			// flight plans tracked by other controllers are not changed
+			core.OnFunctionCall(TAG_FUNC_TOGGLE_UNRELIABLE_SPEED, "", fp);
+			Assert::AreEqual(std::string(""), fp.data.flightStripAnnotations[BROADCAST_FLIGHT_STRIP_INDEX]);
+			fp.data.trackingControllerId = "EDMM_CTR";
+			core.OnFunctionCall(TAG_FUNC_TOGGLE_UNRELIABLE_SPEED, "", fp);
+			Assert::AreEqual(std::string(""), fp.data.flightStripAnnotations[BROADCAST_FLIGHT_STRIP_INDEX]);
+			Assert::AreEqual(std::string("XIAS"), GetTagItem(core, rt, TAG_ITEM_CALCULATED_IAS));
+		}
+
+		TEST_METHOD(TestWeatherUpdate)
+		{
+			std::ifstream ifs("weather_test.json", std::ios_base::in);
+			std::stringstream json;
+			json << ifs.rdbuf();
+			ifs.close();
+
+			IASsure::host::FakeHost host;
+			host.writeFile(CONFIG_FILE_NAME, R"({"weather": {"url": "https://weather.example/data.json", "update": 1}})");
+			host.setDownload("https://weather.example/data.json", json.str());
+
+			IASsure::host::FakeRadarTarget rt("DLH123", 48.35, 11.78, 37000, 90, 460);
+			IASsure::Weather weather(json.str());
+			IASsure::AirData expected = IASsure::calculateAirData(37000, 90, 460, weather.findClosest(48.35, 11.78, 37000), IASsure::AtmosphereModel::Table);
+			IASsure::AirData windless = IASsure::calculateAirData(37000, 90, 460, IASsure::WeatherReferenceLevel{ 0, 0, 0 }, IASsure::AtmosphereModel::Table);
+			Assert::AreNotEqual(FormatIAS(windless), FormatIAS(expected));
+
+			{
+				// weather data is only retrieved while connected, the update is stored in the weather cache
+				IASsure::Core core(host);
+				core.OnTimer(1);
+				Assert::AreEqual((size_t)0, host.downloads());
+
+				host.setConnected(true);
+				core.OnTimer(1);
+				for (int i = 0; i < 200 && !host.file(WEATHER_CACHE_FILE_NAME).has_value(); i++) {
+					std::this_thread::sleep_for(std::chrono::milliseconds(50));
+				}
+				Assert::AreEqual((size_t)1, host.downloads());
+				Assert::IsTrue(host.file(WEATHER_CACHE_FILE_NAME).has_value());
+
+				core.OnRadarTargetPositionUpdate(rt);
+				Assert::AreEqual(FormatIAS(expected), GetTagItem(core, rt, TAG_ITEM_CALCULATED_IAS));
+			}
+
+			// cached weather data is loaded on startup
+			host.setConnected(false);
+			IASsure::Core core(host);
+			Assert::AreEqual(FormatIAS(expected), GetTagItem(core, rt, TAG_ITEM_CALCULATED_IAS));
+
+			Assert::IsTrue(core.OnCompileCommand(".ias weather clear"));
+			Assert::AreEqual(FormatIAS(windless), GetTagItem(core, rt, TAG_ITEM_CALCULATED_IAS));
+		}
+	};
+}
\ No newline at end of file
@@ -0,0 +1,146 @@
+#include <CppUnitTest.h>
+
+#include <limits>
+#include <optional>
+#include <string>
+
+#include "../IASsure/format.h"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace IASsureTest
+{
+	TEST_CLASS(Format)
+	{
+	public:
+		void AssertIAS(const std::string& expected, std::string_view prefix, double cas, std::optional<double> reported, bool abbreviated)
+		{
+			char buffer[16];
+			IASsure::format::formatIAS(buffer, sizeof(buffer), prefix, cas, reported, abbreviated);
+			Assert::AreEqual(expected, std::string(buffer));
+		}
+
+		void AssertMach(const std::string& expected, std::string_view prefix, double mach, std::optional<double> reported, int digits)
+		{
+			char buffer[16];
+			IASsure::format::formatMach(buffer, sizeof(buffer), prefix, mach, reported, digits);
+			Assert::AreEqual(expected, std::string(buffer));
+		}
+
+		TEST_METHOD(TestFormatIAS)
+		{
+			AssertIAS("I250", "I", 250.4, std::nullopt, false);
+			AssertIAS("I251", "I", 250.5, std::nullopt, false);
+			AssertIAS("I096", "I", 95.6, std::nullopt, false);
+			AssertIAS("I005", "I", 4.9, std::nullopt, false);
+			AssertIAS("250", "", 250.4, std::nullopt, false);
+			AssertIAS("IAS250", "IAS", 250.4, std::nullopt, false);
+		}
+
+		TEST_METHOD(TestFormatIASAbbreviated)
+		{
+			// prefix is never displayed for abbreviated values
+			AssertIAS("25", "I", 250.4, std::nullopt, true);
+			AssertIAS("25", "I", 245.0, std::nullopt, true);
+			AssertIAS("24", "I", 244.9, std::nullopt, true);
+			AssertIAS("09", "I", 94.0, std::nullopt, true);
+			AssertIAS("00", "I", 4.0, std::nullopt, true);
+		}
+
+		TEST_METHOD(TestFormatIASReported)
+		{
+			AssertIAS("I+010", "I", 250.4, 260, false);
+			AssertIAS("I-010", "I", 250.4, 240, false);
+			AssertIAS("I000", "I", 250.0, 250, false);
+			AssertIAS("I+000", "I", 249.8, 250, false);
+			AssertIAS("I-120", "I", 370.0, 250, false);
+
+			AssertIAS("+01", "I", 250.4, 260, true);
+			AssertIAS("-01", "I", 250.4, 240, true);
+			AssertIAS("00", "I", 250.0, 250, true);
+			AssertIAS("-00", "I", 252.0, 250, true);
+			AssertIAS("-12", "I", 370.0, 250, true);
+		}
+
+		TEST_METHOD(TestFormatMach)
+		{
+			AssertMach("M78", "M", 0.7849, std::nullopt, 2);
+			AssertMach("M79", "M", 0.785, std::nullopt, 2);
+			AssertMach("M785", "M", 0.7849, std::nullopt, 3);
+			AssertMach("M8", "M", 0.7849, std::nullopt, 1);
+			AssertMach("M78490", "M", 0.7849, std::nullopt, 5);
+			AssertMach("M05", "M", 0.05, std::nullopt, 2);
+			AssertMach("M102", "M", 1.02, std::nullopt, 2);
+			AssertMach("78", "", 0.7849, std::nullopt, 2);
+		}
+
+		TEST_METHOD(TestFormatMachReported)
+		{
+			AssertMach("M+02", "M", 0.7849, 0.80, 2);
+			AssertMach("M-02", "M", 0.8151, 0.80, 2);
+			AssertMach("M-00", "M", 0.7849, 0.78, 2);
+			AssertMach("M00", "M", 0.78, 0.78, 2);
+			AssertMach("M+015", "M", 0.7849, 0.80, 3);
+			AssertMach("M+0", "M", 0.7849, 0.80, 1);
+		}
+
+		TEST_METHOD(TestFormatTAS)
+		{
+			char buffer[16];
+			IASsure::format::formatTAS(buffer, sizeof(buffer), 452.4);
+			Assert::AreEqual(std::string("452"), std::string(buffer));
+			IASsure::format::formatTAS(buffer, sizeof(buffer), 44.5);
+			Assert::AreEqual(std::string("045"), std::string(buffer));
+			IASsure::format::formatTAS(buffer, sizeof(buffer), 1020.0);
+			Assert::AreEqual(std::string("1020"), std::string(buffer));
+		}
+
+		TEST_METHOD(TestFormatWindComponent)
+		{
+			char buffer[16];
+			IASsure::format::formatWindComponent(buffer, sizeof(buffer), 24.6);
+			Assert::AreEqual(std::string("H25"), std::string(buffer));
+			IASsure::format::formatWindComponent(buffer, sizeof(buffer), -7.8);
+			Assert::AreEqual(std::string("T08"), std::string(buffer));
+			IASsure::format::formatWindComponent(buffer, sizeof(buffer), 120.0);
+			Assert::AreEqual(std::string("H120"), std::string(buffer));
+			IASsure::format::formatWindComponent(buffer, sizeof(buffer), 0.3);
+			Assert::AreEqual(std::string("00"), std::string(buffer));
+			IASsure::format::formatWindComponent(buffer, sizeof(buffer), -0.3);
+			Assert::AreEqual(std::string("00"), std::string(buffer));
+		}
+
+		TEST_METHOD(TestTagItemWriter)
+		{
+			char buffer[16];
+			IASsure::format::TagItemWriter writer(buffer, sizeof(buffer));
+			Assert::AreEqual(std::string(""), std::string(buffer));
+
+			writer.text("A").sign(1).number(7, 3).character('B').sign(0).sign(-1).number(-2.5, 2);
+			Assert::AreEqual(std::string("A+007B--03"), std::string(buffer));
+			Assert::AreEqual((size_t)10, writer.length());
+
+			// non-finite values are skipped
+			IASsure::format::TagItemWriter(buffer, sizeof(buffer)).number(std::numeric_limits<double>::quiet_NaN(), 3);
+			Assert::AreEqual(std::string(""), std::string(buffer));
+		}
+
+		TEST_METHOD(TestTagItemWriterTruncates)
+		{
+			// content exceeding the buffer is cut off, keeping the null terminator
+			char buffer[16];
+			IASsure::format::formatIAS(buffer, sizeof(buffer), "ABCDEFGHIJKLMN", 250, std::nullopt, false);
+			Assert::AreEqual(std::string("ABCDEFGHIJKLMN2"), std::string(buffer));
+
+			char small[4] = { 'x', 'x', 'x', 'x' };
+			IASsure::format::TagItemWriter writer(small, sizeof(small));
+			writer.text("I").number(250, 3);
+			Assert::AreEqual(std::string("I25"), std::string(small));
+			Assert::AreEqual((size_t)3, writer.length());
+
+			// empty buffers are never written
+			IASsure::format::TagItemWriter(small, 0).text("I");
+			Assert::AreEqual(std::string("I25"), std::string(small));
+		}
+	};
+}
\ No newline at end of file
@@ -0,0 +1,274 @@
+#include <CppUnitTest.h>
+
+#include <cmath>
+#include <string>
+#include <vector>
+
+#include "../IASsure/weather.h"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace IASsureTest
+{
+	TEST_CLASS(Grid)
+	{
+	public:
+		class Level {
+		public:
+			int flightLevel;
+			double temperature;
+			double windSpeed;
+			double windDirection;
+		};
+
+		class Point {
+		public:
+			double latitude;
+			double longitude;
+			std::vector<Level> levels;
+		};
+
+		std::string GenerateDataset(const std::vector<Point>& points)
+		{
+			nlohmann::json data = nlohmann::json::object();
+			for (size_t i = 0; i < points.size(); i++) {
+				nlohmann::json levels = nlohmann::json::object();
+				for (auto const& level : points[i].levels) {
+					levels[std::to_string(level.flightLevel)] = { {"T(K)", std::to_string(level.temperature)}, {"windspeed", std::to_string(level.windSpeed)}, {"windhdg", std::to_string(level.windDirection)} };
+				}
+
+				data["WP" + std::to_string(i)] = {
+					{"coords", { {"lat", std::to_string(points[i].latitude)}, {"long", std::to_string(points[i].longitude)} }},
+					{"levels", levels},
+				};
+			}
+
+			nlohmann::json j = {
+				{"info", { {"date", "2022-11-04T12:00:00Z"}, {"datestring", "0422"} }},
+				{"data", data},
+			};
+
+			return j.dump();
+		}
+
+		IASsure::WeatherGridSettings GridSettings(double spacing, int levelSpacing)
+		{
+			IASsure::WeatherGridSettings settings;
+			settings.enabled = true;
+			settings.spacing = spacing;
+			settings.levelSpacing = levelSpacing;
+
+			return settings;
+		}
+
+		void AssertLevel(const IASsure::WeatherReferenceLevel& level, double temperature, double windSpeed, double windDirection)
+		{
+			// grid values are stored with single precision
+			Assert::AreEqual(temperature, level.temperature, 1e-3);
+			Assert::AreEqual(windSpeed, level.windSpeed, 1e-3);
+			Assert::AreEqual(windDirection, level.windDirection, 1e-3);
+		}
+
+		TEST_METHOD(TestUniformData)
+		{
+			std::vector<Point> points;
+			for (int i = 0; i < 50; i++) {
+				points.push_back({ 46.0 + (i % 10) * 0.37, 9.0 + (i / 10) * 1.3, { { 0, 280.0, 20.0, 90.0 }, { 100, 260.0, 20.0, 90.0 }, { 300, 260.0, 20.0, 90.0 } } });
+			}
+
+			IASsure::Weather weather(GenerateDataset(points));
+			weather.setGridSettings(GridSettings(0.25, 10));
+			Assert::IsTrue(weather.hasGrid());
+
+			AssertLevel(weather.findClosest(47.0, 10.0, 20000), 260.0, 20.0, 90.0);
+			AssertLevel(weather.findClosest(48.123, 12.987, 35000), 260.0, 20.0, 90.0);
+			// positions outside of the grid are clamped to its edges
+			AssertLevel(weather.findClosest(10.0, -20.0, 10000), 260.0, 20.0, 90.0);
+		}
+
+		TEST_METHOD(TestReferencePointValues)
+		{
+			// reference points located on grid nodes are reproduced exactly
+			IASsure::Weather weather(GenerateDataset({
+				{ 48.0, 16.0, { { 100, 260.0, 10.0, 45.0 }, { 200, 240.0, 30.0, 135.0 } } },
+				{ 48.0, 17.0, { { 100, 250.0, 20.0, 180.0 }, { 200, 230.0, 40.0, 270.0 } } },
+				{ 49.0, 16.0, { { 100, 255.0, 15.0, 315.0 }, { 200, 235.0, 35.0, 225.0 } } },
+				}));
+			weather.setGridSettings(GridSettings(0.25, 10));
+			Assert::IsTrue(weather.hasGrid());
+
+			AssertLevel(weather.findClosest(48.0, 16.0, 10000), 260.0, 10.0, 45.0);
+			AssertLevel(weather.findClosest(48.0, 16.0, 20000), 240.0, 30.0, 135.0);
+			AssertLevel(weather.findClosest(48.0, 17.0, 10000), 250.0, 20.0, 180.0);
+			AssertLevel(weather.findClosest(48.0, 17.0, 20000), 230.0, 40.0, 270.0);
+			AssertLevel(weather.findClosest(49.0, 16.0, 10000), 255.0, 15.0, 315.0);
+			AssertLevel(weather.findClosest(49.0, 16.0, 20000), 235.0, 35.0, 225.0);
+		}
+
+		TEST_METHOD(TestVerticalInterpolation)
+		{
+			IASsure::Weather weather(GenerateDataset({
+				{ 48.0, 16.0, { { 100, 260.0, 20.0, 90.0 }, { 200, 240.0, 40.0, 90.0 } } },
+				}));
+			weather.setGridSettings(GridSettings(0.25, 10));
+			Assert::IsTrue(weather.hasGrid());
+
+			AssertLevel(weather.findClosest(48.0, 16.0, 15000), 250.0, 30.0, 90.0);
+			AssertLevel(weather.findClosest(48.0, 16.0, 12500), 255.0, 25.0, 90.0);
+			AssertLevel(weather.findClosest(48.0, 16.0, 18750), 242.5, 37.5, 90.0);
+			// altitudes outside of the available levels use the lowest/highest level
+			AssertLevel(weather.findClosest(48.0, 16.0, 0), 260.0, 20.0, 90.0);
+			AssertLevel(weather.findClosest(48.0, 16.0, 45000), 240.0, 40.0, 90.0);
+		}
+
+		TEST_METHOD(TestWindDirectionWrap)
+		{
+			// winds are interpolated as components, directions around north don't average to south
+			IASsure::Weather weather(GenerateDataset({
+				{ 48.0, 16.0, { { 100, 260.0, 20.0, 350.0 }, { 200, 240.0, 20.0, 10.0 } } },
+				}));
+			weather.setGridSettings(GridSettings(0.25, 10));
+
+			IASsure::WeatherReferenceLevel level = weather.findClosest(48.0, 16.0, 15000);
+			Assert::AreEqual(20.0 * std::cos(10.0 * std::numbers::pi / 180), level.windSpeed, 1e-3);
+			Assert::IsTrue(level.windDirection < 1e-3 || level.windDirection > 360.0 - 1e-3);
+
+			level = weather.findClosest(48.0, 16.0, 12500);
+			Assert::IsTrue(level.windDirection > 350.0 && level.windDirection < 360.0);
+		}
+
+		TEST_METHOD(TestHorizontalContinuity)
+		{
+			IASsure::Weather weather(GenerateDataset({
+				{ 48.0, 16.0, { { 100, 260.0, 20.0, 90.0 } } },
+				{ 48.0, 17.0, { { 100, 240.0, 20.0, 90.0 } } },
+				}));
+			weather.setGridSettings(GridSettings(0.25, 10));
+			Assert::IsTrue(weather.hasGrid());
+
+			// temperature decreases steadily between both points instead of jumping at the midpoint
+			double previous = weather.findClosest(48.0, 16.0, 10000).temperature;
+			for (double longitude = 16.01; longitude <= 17.0; longitude += 0.01) {
+				double temperature = weather.findClosest(48.0, longitude, 10000).temperature;
+				Assert::IsTrue(temperature <= previous + 1e-3);
+				Assert::IsTrue(previous - temperature < 1.0);
+				previous = temperature;
+			}
+
+			double midpoint = weather.findClosest(48.0, 16.5, 10000).temperature;
+			Assert::IsTrue(midpoint > 240.0 && midpoint < 260.0);
+		}
+
+		TEST_METHOD(TestAntimeridian)
+		{
+			IASsure::Weather weather(GenerateDataset({
+				{ 52.0, 179.0, { { 100, 260.0, 20.0, 90.0 } } },
+				{ 52.0, -179.0, { { 100, 240.0, 20.0, 90.0 } } },
+				}));
+			weather.setGridSettings(GridSettings(0.25, 10));
+			Assert::IsTrue(weather.hasGrid());
+
+			// the grid only covers the 2 degrees between both points instead of spanning the globe
+			AssertLevel(weather.findClosest(52.0, 179.0, 10000), 260.0, 20.0, 90.0);
+			AssertLevel(weather.findClosest(52.0, -179.0, 10000), 240.0, 20.0, 90.0);
+
+			double midpoint = weather.findClosest(52.0, 180.0, 10000).temperature;
+			Assert::IsTrue(midpoint > 240.0 && midpoint < 260.0);
+			Assert::AreEqual(midpoint, weather.findClosest(52.0, -180.0, 10000).temperature, 1e-3);
+			double west = weather.findClosest(52.0, 179.5, 10000).temperature;
+			double east = weather.findClosest(52.0, -179.5, 10000).temperature;
+			Assert::IsTrue(west > midpoint && midpoint > east);
+
+			// positions outside of the grid are clamped to the closer edge
+			AssertLevel(weather.findClosest(52.0, 170.0, 10000), 260.0, 20.0, 90.0);
+			AssertLevel(weather.findClosest(52.0, -170.0, 10000), 240.0, 20.0, 90.0);
+		}
+
+		TEST_METHOD(TestThreadPool)
+		{
+			std::vector<Point> points;
+			for (int i = 0; i < 40; i++) {
+				points.push_back({ 45.0 + (i % 8) * 0.7, 5.0 + (i / 8) * 1.1, { { 0, 280.0 - i, 10.0 + i, (double)(i * 37 % 360) }, { 300, 230.0 - i, 60.0 + i, (double)(i * 53 % 360) } } });
+			}
+			std::string dataset = GenerateDataset(points);
+
+			IASsure::Weather expected(dataset);
+			expected.setGridSettings(GridSettings(0.1, 10));
+
+			// rows built in parallel match the grid built on a single thread
+			IASsure::thread::ThreadPool pool(3);
+			IASsure::Weather weather;
+			weather.setThreadPool(&pool);
+			weather.setGridSettings(GridSettings(0.1, 10));
+			weather.parse(dataset);
+			Assert::IsTrue(weather.hasGrid());
+
+			for (double latitude = 45.0; latitude <= 50.0; latitude += 0.37) {
+				for (double longitude = 5.0; longitude <= 10.5; longitude += 0.41) {
+					for (int altitude : { 0, 12300, 30000 }) {
+						IASsure::WeatherReferenceLevel a = expected.findClosest(latitude, longitude, altitude);
+						IASsure::WeatherReferenceLevel b = weather.findClosest(latitude, longitude, altitude);
+						Assert::AreEqual(a.temperature, b.temperature);
+						Assert::AreEqual(a.windSpeed, b.windSpeed);
+						Assert::AreEqual(a.windDirection, b.windDirection);
+					}
+				}
+			}
+
+			weather.setThreadPool(nullptr);
+		}
+
+		TEST_METHOD(TestGridTooLarge)
+		{
+			IASsure::Weather weather(GenerateDataset({
+				{ -60.0, -170.0, { { 0, 280.0, 10.0, 90.0 }, { 450, 220.0, 50.0, 270.0 } } },
+				{ 60.0, 170.0, { { 0, 270.0, 20.0, 180.0 }, { 450, 210.0, 60.0, 360.0 } } },
+				}));
+
+			// exceeding the maximum grid size falls back to the closest reference point
+			weather.setGridSettings(GridSettings(0.01, 1));
+			Assert::IsFalse(weather.hasGrid());
+			AssertLevel(weather.findClosest(-59.0, -169.0, 0), 280.0, 10.0, 90.0);
+			AssertLevel(weather.findClosest(59.0, 169.0, 45000), 210.0, 60.0, 360.0);
+		}
+
+		TEST_METHOD(TestInvalidSettings)
+		{
+			IASsure::Weather weather(GenerateDataset({
+				{ 48.0, 16.0, { { 100, 260.0, 20.0, 90.0 } } },
+				}));
+
+			weather.setGridSettings(GridSettings(0, 10));
+			Assert::IsFalse(weather.hasGrid());
+			weather.setGridSettings(GridSettings(0.25, 0));
+			Assert::IsFalse(weather.hasGrid());
+			AssertLevel(weather.findClosest(48.0, 16.0, 10000), 260.0, 20.0, 90.0);
+		}
+
+		TEST_METHOD(TestToggleGrid)
+		{
+			IASsure::Weather weather(GenerateDataset({
+				{ 48.0, 16.0, { { 100, 260.0, 20.0, 90.0 } } },
+				{ 48.0, 17.0, { { 100, 240.0, 20.0, 90.0 } } },
+				}));
+			Assert::IsFalse(weather.hasGrid());
+			AssertLevel(weather.findClosest(48.0, 16.4, 10000), 260.0, 20.0, 90.0);
+
+			weather.setGridSettings(GridSettings(0.25, 10));
+			Assert::IsTrue(weather.hasGrid());
+			Assert::IsTrue(weather.findClosest(48.0, 16.4, 10000).temperature < 260.0 - 1e-3);
+
+			// grid is rebuilt for every new dataset while enabled
+			weather.parse(GenerateDataset({
+				{ 48.0, 16.0, { { 100, 230.0, 20.0, 90.0 } } },
+				}));
+			Assert::IsTrue(weather.hasGrid());
+			AssertLevel(weather.findClosest(48.0, 16.4, 10000), 230.0, 20.0, 90.0);
+
+			IASsure::WeatherGridSettings disabled;
+			weather.setGridSettings(disabled);
+			Assert::IsFalse(weather.hasGrid());
+			AssertLevel(weather.findClosest(48.0, 16.0, 10000), 230.0, 20.0, 90.0);
+		}
+	};
+}
\ No newline at end of file
@@ -0,0 +1,54 @@
+#include <CppUnitTest.h>
+
+#include <set>
+#include <string>
+
+#include "../IASsure/hash.h"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace IASsureTest
+{
+	TEST_CLASS(Hash)
+	{
+	public:
+		void AssertXXH64(const std::string& data, uint64_t expected)
+		{
+			uint64_t hash = IASsure::xxh64(data);
+			Assert::AreEqual(expected, hash);
+		}
+
+		TEST_METHOD(TestXXH64)
+		{
+			AssertXXH64("", 0xEF46DB3751D8E999);
+			AssertXXH64("a", 0xD24EC4F1A98C6E5B);
+			AssertXXH64("abc", 0x44BC2CF5AD770999);
+			AssertXXH64("Nobody inspects the spammish repetition", 0xFBCEA83C8A378BF1);
+		}
+
+		TEST_METHOD(TestXXH64Seed)
+		{
+			Assert::AreNotEqual(IASsure::xxh64("abc", 0), IASsure::xxh64("abc", 1));
+			Assert::AreEqual(IASsure::xxh64("abc", 42), IASsure::xxh64("abc", 42));
+		}
+
+		TEST_METHOD(TestXXH64Lengths)
+		{
+			// every length exercises a different combination of stripes and tail processing, a single changed byte must change the hash
+			std::string data(100, 'x');
+			std::set<uint64_t> hashes;
+			for (size_t length = 0; length <= data.size(); length++) {
+				std::string prefix = data.substr(0, length);
+				uint64_t hash = IASsure::xxh64(prefix);
+				hashes.insert(hash);
+
+				if (length > 0) {
+					prefix[length / 2] = 'y';
+					Assert::AreNotEqual(hash, IASsure::xxh64(prefix));
+				}
+			}
+
+			Assert::AreEqual(data.size() + 1, hashes.size());
+		}
+	};
+}
\ No newline at end of file
@@ -1,5 +1,7 @@
 #include <CppUnitTest.h>
 
+#include <optional>
+
 #include "../IASsure/helpers.h"
 
 using namespace Microsoft::VisualStudio::CppUnitTestFramework;
@@ -95,14 +97,14 @@ namespace IASsureTest
 				});
 		}
 
-		void AssertParseRGBString(std::string s, COLORREF* expected)
+		void AssertParseRGBString(std::string s, std::optional<IASsure::host::Color> expected)
 		{
-			COLORREF* color = IASsure::parseRGBString(s);
-			if (color == nullptr) {
-				Assert::IsNull(expected);
+			std::optional<IASsure::host::Color> color = IASsure::parseRGBString(s);
+			if (!color.has_value()) {
+				Assert::IsFalse(expected.has_value());
 			}
-			else if (expected == nullptr) {
-				Assert::IsNull(color);
+			else if (!expected.has_value()) {
+				Assert::IsFalse(color.has_value());
 			}
 			else {
 				Assert::AreEqual(*expected, *color);
@@ -111,16 +113,26 @@ namespace IASsureTest
 
 		TEST_METHOD(TestParseRGBString)
 		{
-			COLORREF grey = RGB(123, 123, 123);
-			AssertParseRGBString("123,123,123", &grey);
-			AssertParseRGBString("123, 123, 123", &grey);
-			AssertParseRGBString("123,123,123,123", nullptr);
-			AssertParseRGBString("123,123", nullptr);
-			AssertParseRGBString("123,123,", nullptr);
-			AssertParseRGBString("123,123,asdf", nullptr);
-			AssertParseRGBString("512,512,512", nullptr);
-			AssertParseRGBString("-123,-123,-123", nullptr);
-			AssertParseRGBString("", nullptr);
+			IASsure::host::Color grey = IASsure::host::rgb(123, 123, 123);
+			AssertParseRGBString("123,123,123", grey);
+			AssertParseRGBString("123, 123, 123", grey);
+			AssertParseRGBString("123,123,123,123", std::nullopt);
+			AssertParseRGBString("123,123", std::nullopt);
+			AssertParseRGBString("123,123,", std::nullopt);
+			AssertParseRGBString("123,123,asdf", std::nullopt);
+			AssertParseRGBString("512,512,512", std::nullopt);
+			AssertParseRGBString("-123,-123,-123", std::nullopt);
+			AssertParseRGBString("", std::nullopt);
+		}
+
+		TEST_METHOD(TestRGB)
+		{
+			// matches the layout of the Windows RGB macro
+			Assert::AreEqual((IASsure::host::Color)0x00000000, IASsure::host::rgb(0, 0, 0));
+			Assert::AreEqual((IASsure::host::Color)0x000000FF, IASsure::host::rgb(255, 0, 0));
+			Assert::AreEqual((IASsure::host::Color)0x0000FF00, IASsure::host::rgb(0, 255, 0));
+			Assert::AreEqual((IASsure::host::Color)0x00FF0000, IASsure::host::rgb(0, 0, 255));
+			Assert::AreEqual((IASsure::host::Color)0x00563412, IASsure::host::rgb(0x12, 0x34, 0x56));
 		}
 
 		void AssertToLowercase(std::string s, std::string expected)
@@ -0,0 +1,198 @@
+#include <CppUnitTest.h>
+
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "../IASsure/pipeline.h"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace IASsureTest
+{
+	TEST_CLASS(Pipeline)
+	{
+	public:
+		void AssertResultEqual(const IASsure::CalculationResult& expected, const IASsure::CalculationResult& actual)
+		{
+			Assert::IsTrue(expected.status == actual.status);
+			if (expected.ok()) {
+				Assert::AreEqual(expected.value, actual.value);
+			}
+		}
+
+		void AssertResult(const IASsure::Weather& weather, const IASsure::AirDataSnapshot& snapshot, const std::string& callsign, uint64_t position, const IASsure::AirDataInput& input)
+		{
+			const IASsure::AirDataResult* result = snapshot.find(callsign);
+			Assert::IsNotNull(result);
+			Assert::AreEqual(position, result->position);
+			Assert::AreEqual(weather.generation(), result->weatherGeneration);
+
+			IASsure::WeatherReferenceLevel level = weather.findClosest(input.latitude, input.longitude, input.altitude);
+			IASsure::AirData expected = IASsure::calculateAirData(input.altitude, input.heading, input.groundSpeed, level, IASsure::AtmosphereModel::Table);
+			AssertResultEqual(expected.tas, result->data.tas);
+			AssertResultEqual(expected.cas, result->data.cas);
+			AssertResultEqual(expected.mach, result->data.mach);
+			AssertResultEqual(expected.temperature, result->data.temperature);
+			AssertResultEqual(expected.isaDeviation, result->data.isaDeviation);
+			AssertResultEqual(expected.windComponent, result->data.windComponent);
+		}
+
+		TEST_METHOD(TestCapture)
+		{
+			std::ifstream ifs = std::ifstream("weather_test.json", std::ios_base::in);
+			IASsure::Weather weather = IASsure::Weather(ifs);
+			ifs.close();
+
+			IASsure::AirDataPipeline pipeline(weather, IASsure::AtmosphereModel::Table);
+			Assert::AreEqual((uint64_t)0, pipeline.sequence());
+			Assert::AreEqual((size_t)0, pipeline.snapshot()->size());
+
+			IASsure::AirDataInput cruise{ 48.35, 11.78, 37000, 90, 460 };
+			IASsure::AirDataInput approach{ 48.2, 11.5, 4000, 260, 170 };
+			IASsure::AirDataInput parked{ 48.35, 11.78, 1480, 0, 0 };
+			pipeline.capture("DLH123", 1, cruise);
+			pipeline.capture("BAW456", 7, approach);
+			pipeline.capture("EZY789", 3, parked);
+			pipeline.flush();
+
+			std::shared_ptr<const IASsure::AirDataSnapshot> snapshot = pipeline.snapshot();
+			Assert::AreEqual(pipeline.sequence(), snapshot->sequence);
+			Assert::AreEqual((size_t)3, snapshot->size());
+			AssertResult(weather, *snapshot, "DLH123", 1, cruise);
+			AssertResult(weather, *snapshot, "BAW456", 7, approach);
+			AssertResult(weather, *snapshot, "EZY789", 3, parked);
+
+			// only the latest input captured before processing is used
+			IASsure::AirDataInput climb{ 48.4, 11.9, 12000, 95, 310 };
+			pipeline.capture("DLH123", 2, cruise);
+			pipeline.capture("DLH123", 3, climb);
+			pipeline.flush();
+
+			std::shared_ptr<const IASsure::AirDataSnapshot> updated = pipeline.snapshot();
+			Assert::IsTrue(updated->sequence > snapshot->sequence);
+			AssertResult(weather, *updated, "DLH123", 3, climb);
+			AssertResult(weather, *updated, "BAW456", 7, approach);
+
+			// published snapshots are never modified
+			AssertResult(weather, *snapshot, "DLH123", 1, cruise);
+		}
+
+		TEST_METHOD(TestThreadPool)
+		{
+			std::ifstream ifs = std::ifstream("weather_test.json", std::ios_base::in);
+			IASsure::Weather weather = IASsure::Weather(ifs);
+			ifs.close();
+
+			IASsure::thread::ThreadPool pool(3);
+			IASsure::AirDataPipeline pipeline(weather, IASsure::AtmosphereModel::Table);
+			pipeline.setThreadPool(&pool);
+
+			// enough targets to be split into several tasks
+			std::vector<IASsure::AirDataInput> inputs;
+			for (int i = 0; i < 1000; i++) {
+				inputs.push_back({ 40.0 + (i % 50) * 0.3, (i / 50) * 0.5, (i * 97) % 45000, (i * 13) % 360, 120 + i % 400 });
+				pipeline.capture("TGT" + std::to_string(i), i + 1, inputs.back());
+			}
+			pipeline.flush();
+
+			std::shared_ptr<const IASsure::AirDataSnapshot> snapshot = pipeline.snapshot();
+			Assert::AreEqual(inputs.size(), snapshot->size());
+			for (int i = 0; i < 1000; i++) {
+				AssertResult(weather, *snapshot, "TGT" + std::to_string(i), i + 1, inputs[i]);
+			}
+
+			pipeline.setThreadPool(nullptr);
+		}
+
+		TEST_METHOD(TestRemoveAndClear)
+		{
+			IASsure::Weather weather;
+			IASsure::AirDataPipeline pipeline(weather, IASsure::AtmosphereModel::Table);
+
+			IASsure::AirDataInput input{ 48.35, 11.78, 37000, 90, 460 };
+			pipeline.capture("DLH123", 1, input);
+			pipeline.capture("BAW456", 1, input);
+			pipeline.flush();
+			Assert::AreEqual((size_t)2, pipeline.snapshot()->size());
+
+			pipeline.remove("DLH123");
+			pipeline.remove("UNKNOWN");
+			pipeline.flush();
+			Assert::IsNull(pipeline.snapshot()->find("DLH123"));
+			AssertResult(weather, *pipeline.snapshot(), "BAW456", 1, input);
+
+			// captures queued after clearing are kept
+			pipeline.clear();
+			pipeline.capture("EZY789", 4, input);
+			pipeline.flush();
+			Assert::AreEqual((size_t)1, pipeline.snapshot()->size());
+			AssertResult(weather, *pipeline.snapshot(), "EZY789", 4, input);
+
+			// removed targets are not recalculated on new weather data
+			pipeline.remove("EZY789");
+			pipeline.flush();
+			std::ifstream ifs = std::ifstream("weather_test.json", std::ios_base::in);
+			weather.parse(ifs);
+			ifs.close();
+			pipeline.flush();
+			Assert::AreEqual((size_t)0, pipeline.snapshot()->size());
+		}
+
+		TEST_METHOD(TestSnapshotSharesUnchangedChunks)
+		{
+			IASsure::Weather weather;
+			IASsure::AirDataPipeline pipeline(weather, IASsure::AtmosphereModel::Table);
+
+			IASsure::AirDataInput input{ 48.35, 11.78, 37000, 90, 460 };
+			for (int i = 0; i < 1000; i++) {
+				pipeline.capture("TGT" + std::to_string(i), 1, input);
+			}
+			pipeline.flush();
+			std::shared_ptr<const IASsure::AirDataSnapshot> previous = pipeline.snapshot();
+
+			// only the chunk of the updated target is copied, the previous snapshot stays unchanged
+			pipeline.capture("TGT42", 2, input);
+			pipeline.flush();
+			std::shared_ptr<const IASsure::AirDataSnapshot> snapshot = pipeline.snapshot();
+			Assert::AreEqual((size_t)1000, snapshot->size());
+			Assert::AreEqual((uint64_t)1, previous->find("TGT42")->position);
+			Assert::AreEqual((uint64_t)2, snapshot->find("TGT42")->position);
+
+			size_t shared = 0;
+			for (size_t i = 0; i < IASsure::AIR_DATA_SNAPSHOT_CHUNKS; i++) {
+				if (snapshot->chunks[i] == previous->chunks[i]) {
+					shared++;
+				}
+			}
+			Assert::AreEqual(IASsure::AIR_DATA_SNAPSHOT_CHUNKS - 1, shared);
+		}
+
+		TEST_METHOD(TestWeatherUpdate)
+		{
+			IASsure::Weather weather;
+			IASsure::AirDataPipeline pipeline(weather, IASsure::AtmosphereModel::Table);
+
+			IASsure::AirDataInput input{ 48.35, 11.78, 37000, 90, 460 };
+			pipeline.capture("DLH123", 1, input);
+			pipeline.flush();
+			AssertResult(weather, *pipeline.snapshot(), "DLH123", 1, input);
+			double windless = pipeline.snapshot()->find("DLH123")->data.cas.value;
+
+			// new weather data recalculates all targets without capturing their inputs again
+			std::ifstream ifs = std::ifstream("weather_test.json", std::ios_base::in);
+			weather.parse(ifs);
+			ifs.close();
+			pipeline.flush();
+
+			AssertResult(weather, *pipeline.snapshot(), "DLH123", 1, input);
+			Assert::AreNotEqual(windless, pipeline.snapshot()->find("DLH123")->data.cas.value);
+
+			weather.clear();
+			pipeline.flush();
+			AssertResult(weather, *pipeline.snapshot(), "DLH123", 1, input);
+			Assert::AreEqual(windless, pipeline.snapshot()->find("DLH123")->data.cas.value);
+		}
+	};
+}
\ No newline at end of file
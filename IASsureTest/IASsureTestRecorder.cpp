@@ -0,0 +1,175 @@
+#include <CppUnitTest.h>
+
+#include <fstream>
+#include <optional>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "../IASsure/binary.h"
+#include "../IASsure/core.h"
+#include "../IASsure/fakehost.h"
+#include "../IASsure/recorder.h"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace IASsureTest
+{
+	TEST_CLASS(Recorder)
+	{
+	public:
+		std::vector<IASsure::Record> ReadRecords(IASsure::RecordingReader& reader)
+		{
+			std::vector<IASsure::Record> records;
+			IASsure::Record record;
+			while (reader.next(record)) {
+				records.push_back(record);
+			}
+			return records;
+		}
+
+		std::string RecordingHeader(uint32_t magic = IASsure::RECORDING_MAGIC, uint32_t version = IASsure::RECORDING_VERSION)
+		{
+			IASsure::binary::Writer writer;
+			writer.write(magic);
+			writer.write(version);
+			writer.write(std::string("settings"));
+			writer.write((uint8_t)0);
+			writer.write(std::string());
+			return writer.data;
+		}
+
+		std::string CommandRecord(uint8_t type, uint64_t time, const std::string& command)
+		{
+			IASsure::binary::Writer payload;
+			payload.write(command);
+
+			IASsure::binary::Writer writer;
+			writer.write(type);
+			writer.write(time);
+			writer.write((uint32_t)payload.data.size());
+			writer.data.append(payload.data);
+			return writer.data;
+		}
+
+		TEST_METHOD(TestRecording)
+		{
+			std::ifstream ifs("weather_test.json", std::ios_base::in);
+			std::stringstream json;
+			json << ifs.rdbuf();
+			ifs.close();
+			std::string weather = IASsure::Weather(json.str()).serialize();
+
+			IASsure::host::FakeHost host;
+			host.writeFile(CONFIG_FILE_NAME, R"({"mach": {"digits": 3}})");
+			IASsure::Core core(host);
+
+			// inputs are only recorded while recording
+			IASsure::host::FakeRadarTarget rt("DLH123", 48.35, 11.78, 37000, 90, 460);
+			core.OnRadarTargetPositionUpdate(rt);
+
+			Assert::IsTrue(core.OnCompileCommand(".ias record"));
+			core.OnRadarTargetPositionUpdate(rt);
+
+			IASsure::host::FakeFlightPlan& fp = host.addFlightPlan(IASsure::host::FakeFlightPlan("DLH123"));
+			fp.data.trackedByMe = true;
+			fp.data.scratchPad = "ABC";
+			fp.data.flightStripAnnotations[8] = "UNR";
+			core.OnFlightPlanScratchPadUpdate(fp);
+			core.OnFunctionCall(TAG_FUNC_SET_REPORTED_IAS, "250", fp);
+			Assert::IsTrue(core.OnCompileCommand(".ias gs"));
+
+			// weather data swaps are recorded before the next input
+			core.ReplaceWeather(weather);
+			core.OnTimer(1);
+			core.OnFlightPlanDisconnect(fp);
+
+			Assert::IsTrue(core.OnCompileCommand(".ias record"));
+			core.OnRadarTargetPositionUpdate(rt);
+
+			std::optional<std::string> data = host.file(RECORDING_FILE_NAME);
+			Assert::IsTrue(data.has_value());
+
+			IASsure::RecordingReader reader(*data);
+			Assert::AreEqual(std::string(R"({"mach": {"digits": 3}})"), reader.header().config.value_or(""));
+			Assert::IsFalse(reader.header().settings.empty());
+
+			std::vector<IASsure::Record> records = ReadRecords(reader);
+			Assert::AreEqual((size_t)7, records.size());
+			for (size_t i = 1; i < records.size(); i++) {
+				Assert::IsTrue(records[i - 1].time <= records[i].time);
+			}
+
+			// the recording starts with the current weather data, none available yet
+			Assert::IsTrue(records[0].type == IASsure::RecordType::Weather);
+			Assert::AreEqual(std::string(), records[0].weather);
+
+			Assert::IsTrue(records[1].type == IASsure::RecordType::Position);
+			Assert::AreEqual(std::string("DLH123"), records[1].position.callsign);
+			Assert::AreEqual(48.35, records[1].position.latitude);
+			Assert::AreEqual(11.78, records[1].position.longitude);
+			Assert::AreEqual(37000, records[1].position.pressureAltitude);
+			Assert::AreEqual(90, records[1].position.reportedHeading);
+			Assert::AreEqual(460, records[1].position.reportedGS);
+
+			Assert::IsTrue(records[2].type == IASsure::RecordType::FlightPlan);
+			Assert::IsTrue(records[2].event == IASsure::FlightPlanEvent::ScratchPadUpdate);
+			Assert::AreEqual(std::string("DLH123"), records[2].flightPlan.callsign);
+			Assert::IsTrue(records[2].flightPlan.trackedByMe);
+			Assert::AreEqual(std::string("ABC"), records[2].flightPlan.scratchPad);
+			Assert::AreEqual(std::string("UNR"), records[2].flightPlan.flightStripAnnotations[8]);
+
+			Assert::IsTrue(records[3].type == IASsure::RecordType::FlightPlan);
+			Assert::IsTrue(records[3].event == IASsure::FlightPlanEvent::FunctionCall);
+			Assert::AreEqual(TAG_FUNC_SET_REPORTED_IAS, records[3].functionId);
+			Assert::AreEqual(std::string("250"), records[3].itemString);
+
+			Assert::IsTrue(records[4].type == IASsure::RecordType::Command);
+			Assert::AreEqual(std::string(".ias gs"), records[4].command);
+
+			Assert::IsTrue(records[5].type == IASsure::RecordType::Weather);
+			Assert::AreEqual(weather, records[5].weather);
+
+			Assert::IsTrue(records[6].type == IASsure::RecordType::FlightPlan);
+			Assert::IsTrue(records[6].event == IASsure::FlightPlanEvent::Disconnect);
+
+			// starting a new recording replaces the previous one
+			Assert::IsTrue(core.OnCompileCommand(".ias record"));
+			Assert::IsTrue(core.OnCompileCommand(".ias record"));
+
+			data = host.file(RECORDING_FILE_NAME);
+			IASsure::RecordingReader replaced(*data);
+			records = ReadRecords(replaced);
+			Assert::AreEqual((size_t)1, records.size());
+			Assert::AreEqual(weather, records[0].weather);
+		}
+
+		TEST_METHOD(TestRecordingReader)
+		{
+			Assert::ExpectException<std::invalid_argument>([this]() {
+				IASsure::RecordingReader reader(RecordingHeader(IASsure::WEATHER_CACHE_MAGIC));
+				});
+			Assert::ExpectException<std::invalid_argument>([this]() {
+				IASsure::RecordingReader reader(RecordingHeader(IASsure::RECORDING_MAGIC, IASsure::RECORDING_VERSION + 1));
+				});
+			Assert::ExpectException<std::invalid_argument>([this]() {
+				IASsure::RecordingReader reader(RecordingHeader().substr(0, 10));
+				});
+
+			// unknown record types are skipped, a truncated last record ends the recording
+			std::string data = RecordingHeader() + CommandRecord(0xFF, 1, "unknown") + CommandRecord((uint8_t)IASsure::RecordType::Command, 2, ".ias debug");
+			std::string truncated = CommandRecord((uint8_t)IASsure::RecordType::Command, 3, ".ias gs");
+			data += truncated.substr(0, truncated.size() - 1);
+
+			IASsure::RecordingReader reader(data);
+			Assert::AreEqual(std::string("settings"), reader.header().settings);
+			Assert::IsFalse(reader.header().config.has_value());
+
+			std::vector<IASsure::Record> records = ReadRecords(reader);
+			Assert::AreEqual((size_t)1, records.size());
+			Assert::AreEqual((long long)2, (long long)records[0].time.count());
+			Assert::AreEqual(std::string(".ias debug"), records[0].command);
+		}
+	};
+}
\ No newline at end of file
@@ -0,0 +1,238 @@
+#include <CppUnitTest.h>
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include "../IASsure/haversine.h"
+#include "../IASsure/spatial.h"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace IASsureTest
+{
+	TEST_CLASS(Spatial)
+	{
+	public:
+		size_t FindClosestBruteForce(const std::vector<std::pair<double, double>>& coordinates, double latitude, double longitude)
+		{
+			size_t closest = IASsure::SpatialIndex::npos;
+			double distance = -1;
+			for (size_t i = 0; i < coordinates.size(); i++) {
+				double d = IASsure::haversine(latitude, longitude, coordinates[i].first, coordinates[i].second);
+				if (distance < 0 || d < distance) {
+					distance = d;
+					closest = i;
+				}
+			}
+
+			return closest;
+		}
+
+		void AssertFindClosestMatchesBruteForce(const std::vector<std::pair<double, double>>& coordinates, std::mt19937& rng, double minLat, double maxLat, double minLong, double maxLong)
+		{
+			IASsure::SpatialIndex index(coordinates);
+			Assert::AreEqual(coordinates.size(), index.size());
+
+			std::uniform_real_distribution<double> lat(minLat, maxLat);
+			std::uniform_real_distribution<double> lon(minLong, maxLong);
+
+			for (int i = 0; i < 1000; i++) {
+				double queryLat = lat(rng);
+				double queryLong = lon(rng);
+
+				size_t expected = FindClosestBruteForce(coordinates, queryLat, queryLong);
+				size_t actual = index.findClosest(queryLat, queryLong);
+
+				// compare distances instead of indices as both metrics might disagree on (practically impossible) exact ties
+				double expectedDistance = IASsure::haversine(queryLat, queryLong, coordinates[expected].first, coordinates[expected].second);
+				double actualDistance = IASsure::haversine(queryLat, queryLong, coordinates[actual].first, coordinates[actual].second);
+				Assert::AreEqual(expectedDistance, actualDistance, 1e-6);
+			}
+		}
+
+		std::vector<std::pair<double, double>> GenerateCoordinates(std::mt19937& rng, size_t count, double minLat, double maxLat, double minLong, double maxLong)
+		{
+			std::uniform_real_distribution<double> lat(minLat, maxLat);
+			std::uniform_real_distribution<double> lon(minLong, maxLong);
+
+			std::vector<std::pair<double, double>> coordinates;
+			for (size_t i = 0; i < count; i++) {
+				coordinates.push_back({ lat(rng), lon(rng) });
+			}
+
+			return coordinates;
+		}
+
+		std::vector<IASsure::simd::InstructionSet> SupportedInstructionSets()
+		{
+			std::vector<IASsure::simd::InstructionSet> instructionSets = { IASsure::simd::InstructionSet::Scalar };
+			if (IASsure::simd::supported() >= IASsure::simd::InstructionSet::SSE2) {
+				instructionSets.push_back(IASsure::simd::InstructionSet::SSE2);
+			}
+			if (IASsure::simd::supported() >= IASsure::simd::InstructionSet::AVX2) {
+				instructionSets.push_back(IASsure::simd::InstructionSet::AVX2);
+			}
+
+			return instructionSets;
+		}
+
+		void AssertUnitVectorDistance(double lat1, double long1, double lat2, double long2, double expected)
+		{
+			double a[3];
+			double b[3];
+			IASsure::toUnitVector(lat1, long1, a);
+			IASsure::toUnitVector(lat2, long2, b);
+
+			double distance = IASsure::unitVectorDistance(a, b);
+			Assert::AreEqual(expected, distance, 1e-3);
+		}
+
+		TEST_METHOD(TestUnitVectorDistance)
+		{
+			// expected distances match haversine
+			AssertUnitVectorDistance(0, 0, 0, 0, 0);
+			AssertUnitVectorDistance(0, 0, 1, 1, 157249.59776813339);
+			AssertUnitVectorDistance(42, 42, 69, 69, 3387050.1327445381);
+			AssertUnitVectorDistance(-90, -180, 90, 180, 20015114.352186374);
+			AssertUnitVectorDistance(-180, -180, 180, 180, 2.2068054519693118e-09);
+		}
+
+		TEST_METHOD(TestFindClosestLinear)
+		{
+			std::mt19937 rng(7331);
+			std::uniform_real_distribution<double> lat(-90.0, 90.0);
+			std::uniform_real_distribution<double> lon(-180.0, 180.0);
+
+			// every size up to a few SIMD widths covers all remainder handling of the vectorised implementations
+			for (size_t count = 1; count <= 40; count++) {
+				auto coordinates = GenerateCoordinates(rng, count, -90.0, 90.0, -180.0, 180.0);
+				IASsure::SpatialIndex index(coordinates);
+
+				for (int i = 0; i < 50; i++) {
+					double queryLat = lat(rng);
+					double queryLong = lon(rng);
+
+					size_t expected = FindClosestBruteForce(coordinates, queryLat, queryLong);
+					double expectedDistance = IASsure::haversine(queryLat, queryLong, coordinates[expected].first, coordinates[expected].second);
+
+					for (auto instructionSet : SupportedInstructionSets()) {
+						size_t actual = index.findClosestLinear(queryLat, queryLong, instructionSet);
+						double actualDistance = IASsure::haversine(queryLat, queryLong, coordinates[actual].first, coordinates[actual].second);
+						Assert::AreEqual(expectedDistance, actualDistance, 1e-6);
+					}
+				}
+			}
+		}
+
+		TEST_METHOD(TestFindClosestLinearDuplicatePoints)
+		{
+			// identical coordinates in different SIMD lanes resolve to the first point
+			std::vector<std::pair<double, double>> coordinates(23, { 10.0, 10.0 });
+			coordinates[6] = { 48.0, 16.0 };
+			coordinates[9] = { 48.0, 16.0 };
+			coordinates[13] = { 48.0, 16.0 };
+			coordinates[22] = { 48.0, 16.0 };
+			IASsure::SpatialIndex index(coordinates);
+
+			for (auto instructionSet : SupportedInstructionSets()) {
+				Assert::AreEqual((size_t)6, index.findClosestLinear(48.1, 16.1, instructionSet));
+				Assert::AreEqual((size_t)0, index.findClosestLinear(10.0, 10.0, instructionSet));
+			}
+		}
+
+		TEST_METHOD(TestFindClosestEmpty)
+		{
+			IASsure::SpatialIndex index;
+			Assert::IsTrue(index.empty());
+			Assert::AreEqual(IASsure::SpatialIndex::npos, index.findClosest(48.0, 16.0));
+			for (auto instructionSet : SupportedInstructionSets()) {
+				Assert::AreEqual(IASsure::SpatialIndex::npos, index.findClosestLinear(48.0, 16.0, instructionSet));
+			}
+		}
+
+		TEST_METHOD(TestFindClosestSinglePoint)
+		{
+			IASsure::SpatialIndex index({ { 48.0, 16.0 } });
+			Assert::AreEqual((size_t)0, index.findClosest(48.0, 16.0));
+			Assert::AreEqual((size_t)0, index.findClosest(-48.0, -164.0));
+		}
+
+		TEST_METHOD(TestFindClosestDuplicatePoints)
+		{
+			// identical coordinates resolve to the first point, matching a linear scan in input order
+			IASsure::SpatialIndex index({ { 10.0, 10.0 }, { 48.0, 16.0 }, { 48.0, 16.0 }, { 48.0, 16.0 }, { -10.0, -10.0 } });
+			Assert::AreEqual((size_t)1, index.findClosest(48.1, 16.1));
+		}
+
+		TEST_METHOD(TestFindClosestRegional)
+		{
+			std::mt19937 rng(1337);
+			auto coordinates = GenerateCoordinates(rng, 500, 46.0, 49.5, 9.0, 17.5);
+			AssertFindClosestMatchesBruteForce(coordinates, rng, 45.0, 50.5, 8.0, 18.5);
+		}
+
+		TEST_METHOD(TestFindClosestGlobal)
+		{
+			std::mt19937 rng(4242);
+			auto coordinates = GenerateCoordinates(rng, 2000, -90.0, 90.0, -180.0, 180.0);
+			AssertFindClosestMatchesBruteForce(coordinates, rng, -90.0, 90.0, -180.0, 180.0);
+		}
+
+		TEST_METHOD(TestFindClosestAntimeridian)
+		{
+			std::mt19937 rng(9001);
+			auto coordinates = GenerateCoordinates(rng, 200, -20.0, 20.0, 170.0, 180.0);
+			auto west = GenerateCoordinates(rng, 200, -20.0, 20.0, -180.0, -170.0);
+			coordinates.insert(coordinates.end(), west.begin(), west.end());
+			AssertFindClosestMatchesBruteForce(coordinates, rng, -20.0, 20.0, 175.0, 185.0);
+		}
+
+		TEST_METHOD(TestFindClosestHinted)
+		{
+			std::mt19937 rng(1234);
+			std::uniform_real_distribution<double> step(-0.05, 0.05);
+
+			for (size_t count : { 1, 5, 9, 50, 500, 3000 }) {
+				auto coordinates = GenerateCoordinates(rng, count, 46.0, 49.5, 9.0, 17.5);
+				IASsure::SpatialIndex index(coordinates);
+
+				// aircraft moving through the dataset, using the previous result as hint
+				double latitude = 47.5;
+				double longitude = 13.0;
+				size_t hint = IASsure::SpatialIndex::npos;
+				for (int i = 0; i < 2000; i++) {
+					latitude = std::clamp(latitude + step(rng), 45.0, 50.5);
+					longitude = std::clamp(longitude + step(rng), 8.0, 18.5);
+
+					size_t expected = FindClosestBruteForce(coordinates, latitude, longitude);
+					size_t actual = index.findClosest(latitude, longitude, hint);
+
+					double expectedDistance = IASsure::haversine(latitude, longitude, coordinates[expected].first, coordinates[expected].second);
+					double actualDistance = IASsure::haversine(latitude, longitude, coordinates[actual].first, coordinates[actual].second);
+					Assert::AreEqual(expectedDistance, actualDistance, 1e-6);
+
+					hint = actual;
+				}
+			}
+		}
+
+		TEST_METHOD(TestFindClosestBadHint)
+		{
+			std::mt19937 rng(5678);
+			auto coordinates = GenerateCoordinates(rng, 1000, -90.0, 90.0, -180.0, 180.0);
+			IASsure::SpatialIndex index(coordinates);
+
+			// hints far away from the query or outside of the dataset fall back to a full search
+			for (size_t hint : { (size_t)0, (size_t)500, (size_t)999, (size_t)1000, IASsure::SpatialIndex::npos }) {
+				size_t expected = FindClosestBruteForce(coordinates, 48.0, 16.0);
+				Assert::AreEqual(expected, index.findClosest(48.0, 16.0, hint));
+				expected = FindClosestBruteForce(coordinates, -33.0, 151.0);
+				Assert::AreEqual(expected, index.findClosest(-33.0, 151.0, hint));
+			}
+
+			IASsure::SpatialIndex empty;
+			Assert::AreEqual(IASsure::SpatialIndex::npos, empty.findClosest(48.0, 16.0, 0));
+		}
+	};
+}
\ No newline at end of file
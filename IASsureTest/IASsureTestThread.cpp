@@ -0,0 +1,169 @@
+#include <CppUnitTest.h>
+
+#include <atomic>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../IASsure/thread.h"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace IASsureTest
+{
+	TEST_CLASS(Thread)
+	{
+	public:
+		void AssertCoversRange(IASsure::thread::ThreadPool& pool, size_t count, size_t grainSize)
+		{
+			std::vector<std::atomic<int>> visits(count);
+			std::atomic<size_t> ranges = 0;
+			pool.parallelFor(count, grainSize, [&](size_t begin, size_t end) {
+				Assert::IsTrue(begin < end);
+				Assert::IsTrue(end - begin <= (grainSize == 0 ? 1 : grainSize));
+				for (size_t i = begin; i < end; i++) {
+					visits[i]++;
+				}
+				ranges++;
+				});
+
+			for (size_t i = 0; i < count; i++) {
+				Assert::AreEqual(1, visits[i].load());
+			}
+			if (count > 0 && grainSize > 0) {
+				Assert::AreEqual((count + grainSize - 1) / grainSize, ranges.load());
+			}
+		}
+
+		TEST_METHOD(TestParallelFor)
+		{
+			for (size_t workers : { 0, 1, 4 }) {
+				IASsure::thread::ThreadPool pool(workers);
+				Assert::AreEqual(workers, pool.size());
+
+				AssertCoversRange(pool, 0, 16);
+				AssertCoversRange(pool, 1, 16);
+				AssertCoversRange(pool, 16, 16);
+				AssertCoversRange(pool, 17, 16);
+				AssertCoversRange(pool, 1000, 1);
+				AssertCoversRange(pool, 10000, 7);
+				AssertCoversRange(pool, 10, 0);
+			}
+		}
+
+		TEST_METHOD(TestParallelForException)
+		{
+			IASsure::thread::ThreadPool pool(3);
+
+			std::atomic<size_t> processed = 0;
+			Assert::ExpectException<std::domain_error>([&]() {
+				pool.parallelFor(100, 1, [&](size_t begin, size_t) {
+					processed++;
+					if (begin == 42) {
+						throw std::domain_error("test");
+					}
+					});
+				});
+
+			// remaining ranges are processed anyways and the pool stays usable
+			Assert::AreEqual((size_t)100, processed.load());
+			AssertCoversRange(pool, 1000, 10);
+		}
+
+		TEST_METHOD(TestConcurrentCallers)
+		{
+			IASsure::thread::ThreadPool pool(2);
+
+			std::vector<std::thread> callers;
+			for (int t = 0; t < 4; t++) {
+				callers.emplace_back([&pool]() {
+					for (int i = 0; i < 50; i++) {
+						std::atomic<size_t> sum = 0;
+						pool.parallelFor(1000, 13, [&sum](size_t begin, size_t end) {
+							for (size_t j = begin; j < end; j++) {
+								sum += j;
+							}
+							});
+						Assert::AreEqual((size_t)(999 * 1000 / 2), sum.load());
+					}
+					});
+			}
+
+			for (auto& caller : callers) {
+				caller.join();
+			}
+		}
+
+		TEST_METHOD(TestStop)
+		{
+			IASsure::thread::ThreadPool pool(4);
+			AssertCoversRange(pool, 1000, 10);
+
+			pool.stop();
+			pool.stop();
+
+			// calling thread processes all ranges once the workers have stopped
+			AssertCoversRange(pool, 1000, 10);
+		}
+
+		TEST_METHOD(TestRingBuffer)
+		{
+			IASsure::thread::RingBuffer buffer(10);
+			Assert::AreEqual((size_t)16, buffer.capacity());
+
+			std::string out;
+			Assert::AreEqual((size_t)0, buffer.read(out));
+
+			// writes are stored completely or not at all
+			Assert::IsTrue(buffer.write("0123456789"));
+			Assert::IsFalse(buffer.write("abcdefg"));
+			Assert::IsTrue(buffer.write("abcdef"));
+			Assert::IsFalse(buffer.write("x"));
+
+			Assert::AreEqual((size_t)16, buffer.read(out));
+			Assert::AreEqual(std::string("0123456789abcdef"), out);
+
+			// wrapping around the end of the buffer
+			Assert::IsTrue(buffer.write("0123456789"));
+			out.clear();
+			Assert::AreEqual((size_t)10, buffer.read(out));
+			Assert::IsTrue(buffer.write("abcdefghijkl"));
+			out.clear();
+			Assert::AreEqual((size_t)12, buffer.read(out));
+			Assert::AreEqual(std::string("abcdefghijkl"), out);
+		}
+
+		TEST_METHOD(TestRingBufferConcurrent)
+		{
+			IASsure::thread::RingBuffer buffer(64);
+			constexpr int WRITES = 100000;
+
+			std::thread producer([&buffer]() {
+				for (int i = 0; i < WRITES; i++) {
+					std::string data = std::to_string(i) + ';';
+					while (!buffer.write(data)) {
+						std::this_thread::yield();
+					}
+				}
+				});
+
+			// writes are read in order and never split
+			std::string out;
+			int expected = 0;
+			while (expected < WRITES) {
+				out.clear();
+				buffer.read(out);
+
+				size_t start = 0;
+				for (size_t end = out.find(';'); end != std::string::npos; end = out.find(';', start)) {
+					Assert::AreEqual(std::to_string(expected++), out.substr(start, end - start));
+					start = end + 1;
+				}
+				Assert::AreEqual(out.size(), start);
+			}
+
+			producer.join();
+		}
+	};
+}
\ No newline at end of file
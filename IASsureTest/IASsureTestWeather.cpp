@@ -1,9 +1,16 @@
 #include <CppUnitTest.h>
 
+#include <atomic>
 #include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
 
 #include "../IASsure/weather.h"
 
+#include "allocations.h"
+
 using namespace Microsoft::VisualStudio::CppUnitTestFramework;
 
 namespace IASsureTest
@@ -68,5 +75,403 @@ namespace IASsureTest
 			// point FMD, level 140
 			AssertFindClosest(weather, 48.035322, 16.798556, 12000, 263.33092135380110, 32.152820532683080, 222.18511403313391);
 		}
+
+		IASsure::WeatherReferencePoint ParseReferencePoint(const std::string& levels)
+		{
+			return nlohmann::json::parse(R"json({"coords":{"lat":"48.0","long":"16.0"},"levels":)json" + levels + "}").get<IASsure::WeatherReferencePoint>();
+		}
+
+		void AssertReferencePointFindClosest(const IASsure::WeatherReferencePoint& point, int altitude, double temperature)
+		{
+			IASsure::WeatherReferenceLevel level = point.findClosest(altitude);
+			Assert::AreEqual(temperature, level.temperature);
+		}
+
+		TEST_METHOD(TestReferencePointFindClosest)
+		{
+			IASsure::WeatherReferencePoint point = ParseReferencePoint(R"json({
+				"100": {"T(K)": "268.0", "windspeed": "10.0", "windhdg": "100.0"},
+				"0": {"T(K)": "288.0", "windspeed": "0.0", "windhdg": "0.0"},
+				"240": {"T(K)": "240.0", "windspeed": "24.0", "windhdg": "240.0"},
+				"140": {"T(K)": "262.0", "windspeed": "14.0", "windhdg": "140.0"}
+			})json");
+
+			// exact levels
+			AssertReferencePointFindClosest(point, 0, 288.0);
+			AssertReferencePointFindClosest(point, 10000, 268.0);
+			AssertReferencePointFindClosest(point, 14000, 262.0);
+			AssertReferencePointFindClosest(point, 24000, 240.0);
+			// altitude rounded to closest flight level
+			AssertReferencePointFindClosest(point, 10049, 268.0);
+			AssertReferencePointFindClosest(point, 23951, 240.0);
+			// closest level
+			AssertReferencePointFindClosest(point, 4900, 288.0);
+			AssertReferencePointFindClosest(point, 5100, 268.0);
+			AssertReferencePointFindClosest(point, 11500, 268.0);
+			AssertReferencePointFindClosest(point, 13000, 262.0);
+			AssertReferencePointFindClosest(point, 18900, 262.0);
+			AssertReferencePointFindClosest(point, 19100, 240.0);
+			// ties between two levels resolve to the higher level
+			AssertReferencePointFindClosest(point, 5000, 268.0);
+			AssertReferencePointFindClosest(point, 12000, 262.0);
+			AssertReferencePointFindClosest(point, 11950, 262.0);
+			AssertReferencePointFindClosest(point, 19000, 240.0);
+			// clamped to highest level above highest level available
+			AssertReferencePointFindClosest(point, 24100, 240.0);
+			AssertReferencePointFindClosest(point, 42000, 240.0);
+			AssertReferencePointFindClosest(point, 1000000, 240.0);
+			// clamped to lowest level below lowest level available
+			AssertReferencePointFindClosest(point, -1200, 288.0);
+			AssertReferencePointFindClosest(point, -100000, 288.0);
+		}
+
+		TEST_METHOD(TestReferencePointFindClosestSingleLevel)
+		{
+			IASsure::WeatherReferencePoint point = ParseReferencePoint(R"json({"180": {"T(K)": "250.0", "windspeed": "18.0", "windhdg": "180.0"}})json");
+
+			AssertReferencePointFindClosest(point, 0, 250.0);
+			AssertReferencePointFindClosest(point, 18000, 250.0);
+			AssertReferencePointFindClosest(point, 42000, 250.0);
+		}
+
+		TEST_METHOD(TestReferencePointFindClosestNoLevels)
+		{
+			IASsure::WeatherReferencePoint point = ParseReferencePoint("{}");
+
+			IASsure::WeatherReferenceLevel level = point.findClosest(24000);
+			Assert::IsTrue(level.isZero());
+		}
+
+		TEST_METHOD(TestReferencePointLevelsOutOfRange)
+		{
+			Assert::ExpectException<std::out_of_range>([this]() {
+				ParseReferencePoint(R"json({
+					"0": {"T(K)": "288.0", "windspeed": "0.0", "windhdg": "0.0"},
+					"2000000000": {"T(K)": "240.0", "windspeed": "24.0", "windhdg": "240.0"}
+				})json");
+				});
+		}
+
+		TEST_METHOD(TestFindClosestDoesNotAllocate)
+		{
+			std::ifstream ifs = std::ifstream("weather_test.json", std::ios_base::in);
+			IASsure::Weather weather = IASsure::Weather(ifs);
+			ifs.close();
+
+			double temperature = 0;
+			IASsureTest::AllocationCounter allocations;
+			for (double latitude = 46.0; latitude <= 49.5; latitude += 0.25) {
+				for (double longitude = 9.0; longitude <= 17.5; longitude += 0.25) {
+					for (int altitude = 0; altitude <= 45000; altitude += 1500) {
+						temperature += weather.findClosest(latitude, longitude, altitude).temperature;
+					}
+				}
+			}
+
+			Assert::AreEqual((size_t)0, allocations.count());
+			Assert::IsTrue(temperature > 0);
+		}
+
+		std::string GenerateUniformDataset(int points, const std::string& temperature, const std::string& windSpeed, const std::string& windDirection)
+		{
+			nlohmann::json data = nlohmann::json::object();
+			for (int i = 0; i < points; i++) {
+				nlohmann::json levels = nlohmann::json::object();
+				for (int fl = 0; fl <= 450; fl += 10) {
+					levels[std::to_string(fl)] = { {"T(K)", temperature}, {"windspeed", windSpeed}, {"windhdg", windDirection} };
+				}
+
+				data["WP" + std::to_string(i)] = {
+					{"coords", { {"lat", std::to_string(46.0 + (i % 20) * 0.2)}, {"long", std::to_string(9.0 + (i / 20) * 0.2)} }},
+					{"levels", levels},
+				};
+			}
+
+			nlohmann::json j = {
+				{"info", { {"date", "2022-11-04T12:00:00Z"}, {"datestring", "0422"} }},
+				{"data", data},
+			};
+
+			return j.dump();
+		}
+
+		TEST_METHOD(TestConcurrentUpdates)
+		{
+			std::string datasetA = GenerateUniformDataset(400, "250.0", "50.0", "90.0");
+			std::string datasetB = GenerateUniformDataset(400, "230.0", "30.0", "270.0");
+
+			IASsure::Weather weather(datasetA);
+
+			std::atomic<bool> running = true;
+			std::atomic<int> invalid = 0;
+			std::atomic<long long> lookups = 0;
+
+			std::vector<std::thread> readers;
+			for (int r = 0; r < 4; r++) {
+				readers.emplace_back([&weather, &running, &invalid, &lookups, r]() {
+					double latitude = 46.0 + r;
+					double longitude = 9.0;
+					int altitude = 0;
+					while (running) {
+						IASsure::WeatherReferenceLevel level = weather.findClosest(latitude, longitude, altitude);
+
+						// every lookup must return a level of either dataset in full, never zero winds or a mix of both datasets
+						bool isA = level.temperature == 250.0 && level.windSpeed == 50.0 && level.windDirection == 90.0;
+						bool isB = level.temperature == 230.0 && level.windSpeed == 30.0 && level.windDirection == 270.0;
+						if (!isA && !isB) {
+							invalid++;
+						}
+						lookups++;
+
+						longitude = longitude >= 17.0 ? 9.0 : longitude + 0.01;
+						altitude = altitude >= 45000 ? 0 : altitude + 100;
+					}
+					});
+			}
+
+			for (int i = 0; i < 50; i++) {
+				weather.parse(i % 2 == 0 ? datasetB : datasetA);
+			}
+
+			running = false;
+			for (auto& reader : readers) {
+				reader.join();
+			}
+
+			Assert::AreEqual(0, invalid.load());
+			Assert::IsTrue(lookups.load() > 0);
+		}
+
+		TEST_METHOD(TestParseMatchesDOM)
+		{
+			std::ifstream ifs = std::ifstream("weather_test.json", std::ios_base::in);
+			std::stringstream raw;
+			raw << ifs.rdbuf();
+			ifs.close();
+
+			IASsure::Weather weather(raw.str());
+			IASsure::WeatherDataset dataset = nlohmann::json::parse(raw.str()).get<IASsure::WeatherDataset>();
+
+			for (double latitude = 46.0; latitude <= 49.5; latitude += 0.1) {
+				for (double longitude = 9.0; longitude <= 17.5; longitude += 0.1) {
+					for (int altitude = 0; altitude <= 45000; altitude += 700) {
+						IASsure::WeatherReferenceLevel expected = dataset.findClosest(latitude, longitude, altitude);
+						IASsure::WeatherReferenceLevel actual = weather.findClosest(latitude, longitude, altitude);
+						Assert::AreEqual(expected.temperature, actual.temperature);
+						Assert::AreEqual(expected.windSpeed, actual.windSpeed);
+						Assert::AreEqual(expected.windDirection, actual.windDirection);
+					}
+				}
+			}
+		}
+
+		TEST_METHOD(TestParseIgnoresUnknownKeys)
+		{
+			IASsure::Weather weather(R"json({
+				"version": [1, {"nested": [true, null]}],
+				"info": {"date": "2022-11-04T12:00:00Z", "datestring": "0422", "source": {"model": "GFS"}},
+				"data": {
+					"MASUR": {
+						"coords": {"lat": "48.0", "long": "16.0", "alt": 1.5},
+						"levels": {"100": {"T(K)": "268.0", "windspeed": "10.0", "windhdg": "100.0", "rh": 0.5}},
+						"remarks": []
+					}
+				}
+			})json");
+
+			AssertFindClosest(weather, 48.0, 16.0, 10000, 268.0, 10.0, 100.0);
+		}
+
+		TEST_METHOD(TestParseRejectsMalformedData)
+		{
+			IASsure::Weather weather;
+
+			// invalid JSON
+			Assert::ExpectException<nlohmann::json::parse_error>([&weather]() {
+				weather.parse(R"json({"info": {"date": "2022-11-04T12:00:00Z", "datestring": "0422"}, "data": {)json");
+				});
+			// missing sections and keys
+			Assert::ExpectException<std::invalid_argument>([&weather]() {
+				weather.parse(R"json({"info": {"date": "2022-11-04T12:00:00Z", "datestring": "0422"}})json");
+				});
+			Assert::ExpectException<std::invalid_argument>([&weather]() {
+				weather.parse(R"json({"info": {"date": "2022-11-04T12:00:00Z", "datestring": "0422"}, "data": {
+					"MASUR": {"coords": {"lat": "48.0"}, "levels": {}}
+				}})json");
+				});
+			Assert::ExpectException<std::invalid_argument>([&weather]() {
+				weather.parse(R"json({"info": {"date": "2022-11-04T12:00:00Z", "datestring": "0422"}, "data": {
+					"MASUR": {"coords": {"lat": "48.0", "long": "16.0"}, "levels": {"100": {"T(K)": "268.0", "windspeed": "10.0"}}}
+				}})json");
+				});
+			// unexpected value types
+			Assert::ExpectException<std::invalid_argument>([&weather]() {
+				weather.parse(R"json({"info": {"date": "2022-11-04T12:00:00Z", "datestring": "0422"}, "data": {
+					"MASUR": {"coords": {"lat": 48.0, "long": "16.0"}, "levels": {}}
+				}})json");
+				});
+			Assert::ExpectException<std::invalid_argument>([&weather]() {
+				weather.parse(R"json({"info": {"date": "2022-11-04T12:00:00Z", "datestring": "0422"}, "data": []})json");
+				});
+			Assert::ExpectException<std::invalid_argument>([&weather]() {
+				weather.parse(R"json([])json");
+				});
+
+			// failed updates never publish partial data
+			AssertFindClosest(weather, 48.0, 16.0, 10000, 0, 0, 0);
+		}
+
+		TEST_METHOD(TestParseSkipsUnchangedData)
+		{
+			std::string datasetA = GenerateUniformDataset(10, "250.0", "50.0", "90.0");
+			std::string datasetB = GenerateUniformDataset(10, "230.0", "30.0", "270.0");
+
+			IASsure::Weather weather;
+			Assert::IsTrue(weather.parse(datasetA));
+			Assert::IsFalse(weather.parse(datasetA));
+			Assert::IsFalse(weather.parse(datasetA));
+			Assert::AreEqual((size_t)2, weather.skippedParses());
+
+			Assert::IsTrue(weather.parse(datasetB));
+			AssertFindClosest(weather, 46.0, 9.0, 10000, 230.0, 30.0, 270.0);
+
+			// cleared data is always parsed again
+			weather.clear();
+			Assert::IsTrue(weather.parse(datasetB));
+			Assert::AreEqual((size_t)2, weather.skippedParses());
+		}
+
+		TEST_METHOD(TestSerializeRoundTrip)
+		{
+			std::ifstream ifs = std::ifstream("weather_test.json", std::ios_base::in);
+			std::stringstream raw;
+			raw << ifs.rdbuf();
+			ifs.close();
+
+			IASsure::Weather weather(raw.str());
+			std::string cache = weather.serialize();
+
+			IASsure::Weather restored;
+			restored.deserialize(cache);
+
+			for (double latitude = 46.0; latitude <= 49.5; latitude += 0.1) {
+				for (double longitude = 9.0; longitude <= 17.5; longitude += 0.1) {
+					for (int altitude = 0; altitude <= 45000; altitude += 700) {
+						IASsure::WeatherReferenceLevel expected = weather.findClosest(latitude, longitude, altitude);
+						IASsure::WeatherReferenceLevel actual = restored.findClosest(latitude, longitude, altitude);
+						Assert::AreEqual(expected.temperature, actual.temperature);
+						Assert::AreEqual(expected.windSpeed, actual.windSpeed);
+						Assert::AreEqual(expected.windDirection, actual.windDirection);
+					}
+				}
+			}
+
+			// restored data keeps the hash of the raw data, unchanged updates after a warm start are skipped
+			Assert::IsFalse(restored.parse(raw.str()));
+			Assert::AreEqual(cache, restored.serialize());
+		}
+
+		TEST_METHOD(TestSerializeNoData)
+		{
+			IASsure::Weather weather;
+			Assert::ExpectException<std::domain_error>([&weather]() {
+				weather.serialize();
+				});
+		}
+
+		TEST_METHOD(TestDeserializeRejectsCorruptData)
+		{
+			IASsure::Weather source(GenerateUniformDataset(3, "230.0", "30.0", "270.0"));
+			std::string cache = source.serialize();
+
+			IASsure::Weather weather(GenerateUniformDataset(3, "250.0", "50.0", "90.0"));
+
+			// truncated data
+			for (size_t length = 0; length < cache.size(); length++) {
+				Assert::ExpectException<std::invalid_argument>([&weather, &cache, length]() {
+					weather.deserialize(std::string_view(cache).substr(0, length));
+					});
+			}
+
+			// trailing data
+			Assert::ExpectException<std::invalid_argument>([&weather, &cache]() {
+				weather.deserialize(cache + '\0');
+				});
+
+			// any modified byte is detected by either the header validation or the checksum
+			for (size_t i = 0; i < cache.size(); i++) {
+				std::string corrupt = cache;
+				corrupt[i] ^= 0x20;
+				Assert::ExpectException<std::invalid_argument>([&weather, &corrupt]() {
+					weather.deserialize(corrupt);
+					});
+			}
+
+			// failed loads never replace the current data
+			AssertFindClosest(weather, 46.0, 9.0, 10000, 250.0, 50.0, 90.0);
+
+			weather.deserialize(cache);
+			AssertFindClosest(weather, 46.0, 9.0, 10000, 230.0, 30.0, 270.0);
+		}
+
+		TEST_METHOD(TestFindClosestHinted)
+		{
+			std::ifstream ifs = std::ifstream("weather_test.json", std::ios_base::in);
+			IASsure::Weather weather = IASsure::Weather(ifs);
+			ifs.close();
+
+			IASsure::WeatherLookupHint hint;
+			for (double longitude = 9.0; longitude <= 17.5; longitude += 0.01) {
+				IASsure::WeatherReferenceLevel expected = weather.findClosest(47.8, longitude, 24000);
+				IASsure::WeatherReferenceLevel actual = weather.findClosest(47.8, longitude, 24000, hint);
+				Assert::AreEqual(expected.temperature, actual.temperature);
+				Assert::AreEqual(expected.windSpeed, actual.windSpeed);
+				Assert::AreEqual(expected.windDirection, actual.windDirection);
+			}
+		}
+
+		TEST_METHOD(TestFindClosestHintNewDataset)
+		{
+			IASsure::Weather weather(GenerateUniformDataset(400, "250.0", "50.0", "90.0"));
+
+			IASsure::WeatherLookupHint hint;
+			weather.findClosest(47.0, 12.0, 10000, hint);
+			uint64_t generation = hint.generation;
+			Assert::AreNotEqual((uint64_t)0, generation);
+
+			// hints of a replaced dataset are ignored and updated for the new dataset
+			weather.parse(GenerateUniformDataset(10, "230.0", "30.0", "270.0"));
+			AssertFindClosest(weather, 47.0, 12.0, 10000, 230.0, 30.0, 270.0);
+
+			IASsure::WeatherReferenceLevel level = weather.findClosest(47.0, 12.0, 10000, hint);
+			Assert::AreEqual(230.0, level.temperature);
+			Assert::AreNotEqual(generation, hint.generation);
+			Assert::IsTrue(hint.point < 10);
+
+			// cleared data leaves the hint untouched
+			weather.clear();
+			level = weather.findClosest(47.0, 12.0, 10000, hint);
+			Assert::IsTrue(level.isZero());
+		}
+
+		TEST_METHOD(TestGeneration)
+		{
+			IASsure::Weather weather;
+			Assert::AreEqual((uint64_t)0, weather.generation());
+
+			weather.parse(GenerateUniformDataset(10, "250.0", "50.0", "90.0"));
+			uint64_t generation = weather.generation();
+			Assert::AreNotEqual((uint64_t)0, generation);
+
+			// skipped parses keep the current data and generation
+			weather.parse(GenerateUniformDataset(10, "250.0", "50.0", "90.0"));
+			Assert::AreEqual(generation, weather.generation());
+
+			weather.parse(GenerateUniformDataset(10, "230.0", "30.0", "270.0"));
+			Assert::AreNotEqual(generation, weather.generation());
+
+			weather.clear();
+			Assert::AreEqual((uint64_t)0, weather.generation());
+		}
 	};
-}
+}
\ No newline at end of file
@@ -0,0 +1,72 @@
+#include "allocations.h"
+
+#include <cstdlib>
+#include <new>
+
+namespace {
+	thread_local bool countingEnabled = false;
+	thread_local size_t allocationCount = 0;
+
+	void* allocate(size_t size)
+	{
+		if (countingEnabled) {
+			allocationCount++;
+		}
+
+		if (size == 0) {
+			size = 1;
+		}
+
+		void* ptr = std::malloc(size);
+		if (ptr == nullptr) {
+			throw std::bad_alloc();
+		}
+
+		return ptr;
+	}
+}
+
+IASsureTest::AllocationCounter::AllocationCounter() : start(allocationCount), previouslyEnabled(countingEnabled)
+{
+	countingEnabled = true;
+}
+
+IASsureTest::AllocationCounter::~AllocationCounter()
+{
+	countingEnabled = this->previouslyEnabled;
+}
+
+size_t IASsureTest::AllocationCounter::count() const
+{
+	return allocationCount - this->start;
+}
+
+void* operator new(size_t size)
+{
+	return allocate(size);
+}
+
+void* operator new[](size_t size)
+{
+	return allocate(size);
+}
+
+void operator delete(void* ptr) noexcept
+{
+	std::free(ptr);
+}
+
+void operator delete[](void* ptr) noexcept
+{
+	std::free(ptr);
+}
+
+void operator delete(void* ptr, size_t) noexcept
+{
+	std::free(ptr);
+}
+
+void operator delete[](void* ptr, size_t) noexcept
+{
+	std::free(ptr);
+}
\ No newline at end of file
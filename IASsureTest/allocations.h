@@ -0,0 +1,18 @@
+#pragma once
+
+#include <cstddef>
+
+namespace IASsureTest {
+	// AllocationCounter counts global operator new calls performed by the current thread while it is in scope.
+	// Allocations are tracked by replacing the global allocation functions of the test binary (see allocations.cpp).
+	class AllocationCounter {
+	public:
+		AllocationCounter();
+		~AllocationCounter();
+
+		size_t count() const;
+	private:
+		size_t start;
+		bool previouslyEnabled;
+	};
+}
\ No newline at end of file
@@ -0,0 +1,212 @@
+#pragma once
+
+// minimal implementation of the Microsoft C++ unit test framework API used by the tests, allowing them to be built and run on
+// platforms without Visual Studio (see CMakeLists.txt). tests register themselves on startup and are run by main.cpp.
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cwchar>
+#include <functional>
+#include <sstream>
+#include <string>
+#include <typeinfo>
+#include <vector>
+
+#ifdef __GNUG__
+#include <cxxabi.h>
+#endif
+
+namespace Microsoft {
+	namespace VisualStudio {
+		namespace CppUnitTestFramework {
+			// TestFailure is thrown by failed assertions, aborting the current test method
+			class TestFailure {
+			public:
+				std::string message;
+			};
+
+			class TestMethod {
+			public:
+				std::string name;
+				std::function<void()> run;
+			};
+
+			inline std::vector<TestMethod>& testMethods()
+			{
+				static std::vector<TestMethod> methods;
+				return methods;
+			}
+
+			template<typename T>
+			class TestClass {
+			public:
+				typedef T ThisClass;
+			};
+
+			template<typename T>
+			std::string toString(const T& value)
+			{
+				std::ostringstream ss;
+				ss.precision(17);
+				if constexpr (requires { ss << value; }) {
+					ss << value;
+				}
+				else {
+					ss << "[" << typeid(T).name() << "]";
+				}
+				return ss.str();
+			}
+
+			inline std::string toString(const wchar_t* message)
+			{
+				if (message == nullptr) {
+					return "";
+				}
+
+				std::string s;
+				for (; *message != L'\0'; message++) {
+					s += (*message < 128) ? (char)*message : '?';
+				}
+				return " " + s;
+			}
+
+			class Assert {
+			public:
+				template<typename T, typename U>
+				static void AreEqual(const T& expected, const U& actual, const wchar_t* message = nullptr)
+				{
+					if (!(expected == actual)) {
+						Fail("AreEqual failed, expected <" + toString(expected) + "> actual <" + toString(actual) + ">", message);
+					}
+				}
+
+				static void AreEqual(const char* expected, const char* actual, const wchar_t* message = nullptr)
+				{
+					AreEqual(std::string(expected), std::string(actual), message);
+				}
+
+				static void AreEqual(double expected, double actual, double tolerance, const wchar_t* message = nullptr)
+				{
+					if (!(std::abs(expected - actual) <= std::abs(tolerance))) {
+						Fail("AreEqual failed, expected <" + toString(expected) + "> actual <" + toString(actual) + "> tolerance <" + toString(tolerance) + ">", message);
+					}
+				}
+
+				template<typename T, typename U>
+				static void AreNotEqual(const T& notExpected, const U& actual, const wchar_t* message = nullptr)
+				{
+					if (notExpected == actual) {
+						Fail("AreNotEqual failed, both <" + toString(actual) + ">", message);
+					}
+				}
+
+				static void IsTrue(bool condition, const wchar_t* message = nullptr)
+				{
+					if (!condition) {
+						Fail("IsTrue failed", message);
+					}
+				}
+
+				static void IsFalse(bool condition, const wchar_t* message = nullptr)
+				{
+					if (condition) {
+						Fail("IsFalse failed", message);
+					}
+				}
+
+				template<typename T>
+				static void IsNull(const T* actual, const wchar_t* message = nullptr)
+				{
+					if (actual != nullptr) {
+						Fail("IsNull failed", message);
+					}
+				}
+
+				template<typename T>
+				static void IsNotNull(const T* actual, const wchar_t* message = nullptr)
+				{
+					if (actual == nullptr) {
+						Fail("IsNotNull failed", message);
+					}
+				}
+
+				template<typename E, typename F>
+				static void ExpectException(F functor, const wchar_t* message = nullptr)
+				{
+					try {
+						functor();
+					}
+					catch (const E&) {
+						return;
+					}
+					catch (...) {
+						Fail("ExpectException failed, unexpected exception type", message);
+					}
+					Fail("ExpectException failed, no exception thrown", message);
+				}
+
+				[[noreturn]] static void Fail(const wchar_t* message = nullptr)
+				{
+					Fail("Fail", message);
+				}
+			private:
+				[[noreturn]] static void Fail(const std::string& failure, const wchar_t* message)
+				{
+					throw TestFailure{ failure + toString(message) };
+				}
+			};
+
+			class Logger {
+			public:
+				static void WriteMessage(const char* message)
+				{
+					std::printf("%s\n", message);
+				}
+
+				static void WriteMessage(const wchar_t* message)
+				{
+					std::printf("%ls\n", message);
+				}
+			};
+
+			inline std::string className(const std::type_info& type)
+			{
+#ifdef __GNUG__
+				int status = 0;
+				char* demangled = abi::__cxa_demangle(type.name(), nullptr, nullptr, &status);
+				if (status == 0 && demangled != nullptr) {
+					std::string name(demangled);
+					std::free(demangled);
+					return name;
+				}
+#endif
+				return type.name();
+			}
+
+			template<typename T>
+			void registerTestMethod(const char* methodName, void (T::* method)())
+			{
+				testMethods().push_back(TestMethod{ className(typeid(T)) + "::" + methodName, [method]() {
+					T instance;
+					(instance.*method)();
+					} });
+			}
+		}
+	}
+}
+
+#define TEST_CLASS(className) class className : public ::Microsoft::VisualStudio::CppUnitTestFramework::TestClass<className>
+
+// registration is done by the constructor of a nested class, as member function bodies are the only place within the class
+// definition where the test method is already declared
+#define TEST_METHOD(methodName) \
+	class methodName##Registration { \
+	public: \
+		methodName##Registration() \
+		{ \
+			::Microsoft::VisualStudio::CppUnitTestFramework::registerTestMethod<ThisClass>(#methodName, &ThisClass::methodName); \
+		} \
+	}; \
+	static inline methodName##Registration methodName##Registrator; \
+	void methodName()
@@ -0,0 +1,47 @@
+#include <CppUnitTest.h>
+
+#include <cstdio>
+#include <exception>
+#include <string>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+// runs all registered test methods whose name contains the optional filter argument, returning 1 if any of them failed
+int main(int argc, char** argv)
+{
+	std::string filter = argc > 1 ? argv[1] : "";
+	int passed = 0;
+	int failed = 0;
+
+	for (const TestMethod& method : testMethods()) {
+		if (method.name.find(filter) == std::string::npos) {
+			continue;
+		}
+
+		std::string failure;
+		try {
+			method.run();
+		}
+		catch (const TestFailure& ex) {
+			failure = ex.message;
+		}
+		catch (const std::exception& ex) {
+			failure = std::string("unexpected exception: ") + ex.what();
+		}
+		catch (...) {
+			failure = "unexpected exception";
+		}
+
+		if (failure.empty()) {
+			passed++;
+			std::printf("[PASS] %s\n", method.name.c_str());
+		}
+		else {
+			failed++;
+			std::printf("[FAIL] %s: %s\n", method.name.c_str(), failure.c_str());
+		}
+	}
+
+	std::printf("%d passed, %d failed\n", passed, failed);
+	return failed > 0 ? 1 : 0;
+}
\ No newline at end of file